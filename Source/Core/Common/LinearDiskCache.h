@@ -5,26 +5,41 @@
 
 #include <algorithm>
 #include <cstring>
-#include <memory>
+#include <optional>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
 #include "Common/IOFile.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
 // u32 'DCAC';
-// u32 version;  // svn_rev
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char ver[40];  // scm revision
+// u32 format_version;
+// u32 num_indexed_entries;
+// u64 values_size;
 //}
 
-// key_value_pair{
+// index_entry[num_indexed_entries]{  // sorted by key, no key twice
+// key_type   key;
+// u32 value_size;
+// u64 value_offset;  // in bytes, from the start of the values
+//}
+
+// value_type[]   values;  // values_size bytes
+
+// key_value_pair{  // appended since the last compaction
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 entry_number;
 //}
 
 template <typename K, typename V>
@@ -34,12 +49,14 @@ public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
 };
 
-// Dead simple unsorted key-value store with append functionality.
+// Dead simple key-value store with append functionality.
 // No random read functionality, all reading is done in OpenAndRead.
 // Keys and values can contain any characters, including \0.
 //
 // Suitable for caching generated shader bytecode between executions.
-// Not tuned for extreme performance but should be reasonably fast.
+// New entries are appended to the end of the file. When enough of them have piled up, the file is
+// compacted on the next open: the entries are sorted by key, duplicates dropped and the values
+// stored contiguously after the keys, so that reading the file is a single mapping of it.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
 
@@ -61,57 +78,116 @@ public:
     Close();
     m_num_entries = 0;
 
-    // try opening for reading/writing
+    std::optional<FileLayout> layout;
+    {
+      File::MappedFile mapping;
+      if (mapping.Open(filename))
+      {
+        layout = ParseFile(mapping.GetData(), mapping.GetSize(),
+                           [&reader](const K& key, const V* value, u32 value_size) {
+                             reader.Read(key, value, value_size);
+                           });
+      }
+    }
+
+    if (!layout)
+    {
+      // failed to open file for reading or bad header
+      // close and recreate file
+      m_file.Open(filename, "wb");
+      WriteHeader(m_file, 0, 0);
+      return 0;
+    }
+
+    const u32 num_read = layout->num_indexed_entries + layout->num_appended_entries;
+    m_num_entries = num_read;
+
+    std::optional<u32> num_compacted_entries;
+    if (layout->num_appended_entries > layout->num_indexed_entries / COMPACTION_RATIO)
+      num_compacted_entries = Compact(filename);
+
     m_file.Open(filename, "r+b");
+    if (num_compacted_entries)
+    {
+      m_num_entries = *num_compacted_entries;
+      m_file.Seek(0, SEEK_END);
+    }
+    else
+    {
+      // Overwrite any incomplete entry at the end.
+      m_file.Seek(layout->valid_size, SEEK_SET);
+    }
 
-    const u64 file_size = m_file.GetSize();
+    return num_read;
+  }
 
-    m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+  // Rewrites the file with its entries sorted by key, keeping only the last value appended for
+  // each key. Returns the number of entries left, or nothing if the file couldn't be read or
+  // rewritten. The file must not be open in a LinearDiskCache meanwhile.
+  static std::optional<u32> Compact(const std::string& filename)
+  {
+    struct Entry
     {
-      // good header, read some key/value pairs
       K key;
+      const V* value;
+      u32 value_size;
+    };
 
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
+    File::MappedFile mapping;
+    if (!mapping.Open(filename))
+      return std::nullopt;
 
-      while (m_file.ReadArray(&value_size, 1))
-      {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
-      }
-      m_file.Clear();
-      m_file.Seek(last_valid_value_start, SEEK_SET);
+    std::vector<Entry> entries;
+    const auto add_entry = [&entries](const K& key, const V* value, u32 value_size) {
+      entries.push_back({key, value, value_size});
+    };
+    if (!ParseFile(mapping.GetData(), mapping.GetSize(), add_entry))
+      return std::nullopt;
 
-      return m_num_entries;
+    const auto key_less = [&entries](u32 a, u32 b) {
+      return std::memcmp(&entries[a].key, &entries[b].key, sizeof(K)) < 0;
+    };
+    std::vector<u32> order(entries.size());
+    for (u32 i = 0; i < static_cast<u32>(order.size()); i++)
+      order[i] = i;
+    std::stable_sort(order.begin(), order.end(), key_less);
+
+    // Of the entries with the same key, the one appended last comes last.
+    std::vector<IndexEntry> index;
+    index.reserve(order.size());
+    std::vector<const Entry*> values;
+    values.reserve(order.size());
+    u64 values_size = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      if (i + 1 < order.size() && !key_less(order[i], order[i + 1]))
+        continue;
+
+      const Entry& entry = entries[order[i]];
+      IndexEntry& index_entry = index.emplace_back();
+      std::memcpy(&index_entry.key, &entry.key, sizeof(K));
+      index_entry.value_size = entry.value_size;
+      index_entry.value_offset = values_size;
+      values.push_back(&entry);
+      values_size += u64(entry.value_size) * sizeof(V);
     }
 
-    // failed to open file for reading or bad header
-    // close and recreate file
-    Close();
-    m_file.Open(filename, "wb");
-    WriteHeader();
-    return 0;
+    const std::string temp_filename = filename + ".tmp";
+    File::IOFile file(temp_filename, "wb");
+    bool written = WriteHeader(file, static_cast<u32>(index.size()), values_size) &&
+                   file.WriteArray(index.data(), index.size());
+    for (const Entry* entry : values)
+      written = written && file.WriteArray(entry->value, entry->value_size);
+    written &= file.Close();
+
+    mapping.Close();
+    if (!written || !File::Rename(temp_filename, filename))
+    {
+      File::Delete(temp_filename);
+      return std::nullopt;
+    }
+
+    return static_cast<u32>(index.size());
   }
 
   void Sync() { m_file.Flush(); }
@@ -134,14 +210,11 @@ public:
   }
 
 private:
-  void WriteHeader() { m_file.WriteArray(&m_header, 1); }
-  bool ValidateHeader()
-  {
-    char file_header[sizeof(Header)];
+  // Bump this whenever the layout of the file changes.
+  static constexpr u32 FORMAT_VERSION = 2;
 
-    return (m_file.ReadArray(file_header, sizeof(Header)) &&
-            !memcmp((const char*)&m_header, file_header, sizeof(Header)));
-  }
+  // The file is compacted once the appended entries exceed this fraction of the indexed ones.
+  static constexpr u32 COMPACTION_RATIO = 8;
 
   struct Header
   {
@@ -153,12 +226,108 @@ private:
                   std::min(Common::GetScmRevGitStr().size(), sizeof(ver)));
     }
 
+    // Everything but the entry counts has to match for the file to be read.
+    bool IsCompatibleWith(const Header& other) const
+    {
+      return id == other.id && key_t_size == other.key_t_size &&
+             value_t_size == other.value_t_size && !std::memcmp(ver, other.ver, sizeof(ver)) &&
+             format_version == other.format_version;
+    }
+
     u32 id = 0;
-    const u16 key_t_size = sizeof(K);
-    const u16 value_t_size = sizeof(V);
+    u16 key_t_size = sizeof(K);
+    u16 value_t_size = sizeof(V);
     char ver[40] = {};
+    u32 format_version = FORMAT_VERSION;
+    u32 num_indexed_entries = 0;
+    u64 values_size = 0;
+  };
+  static_assert(sizeof(Header) == 64);
+
+  struct IndexEntry
+  {
+    K key;
+    u32 value_size;
+    u64 value_offset;
+  };
+
+  struct FileLayout
+  {
+    u32 num_indexed_entries;
+    u32 num_appended_entries;
+    // Where the last complete appended entry ends.
+    u64 valid_size;
+  };
+
+  static bool WriteHeader(File::IOFile& file, u32 num_indexed_entries, u64 values_size)
+  {
+    Header header;
+    header.Init();
+    header.num_indexed_entries = num_indexed_entries;
+    header.values_size = values_size;
+    return file.WriteArray(&header, 1);
+  }
+
+  // Calls the function for every entry, the indexed ones first. Appended entries are read up to
+  // the first incomplete one. Returns nothing if the file isn't a valid cache.
+  template <typename F>
+  static std::optional<FileLayout> ParseFile(const u8* data, u64 size, F&& function)
+  {
+    Header expected_header;
+    expected_header.Init();
+    Header header;
+    if (size < sizeof(Header))
+      return std::nullopt;
+    std::memcpy(&header, data, sizeof(Header));
+    if (!header.IsCompatibleWith(expected_header))
+      return std::nullopt;
 
-  } m_header;
+    const u64 values_start = sizeof(Header) + u64(header.num_indexed_entries) * sizeof(IndexEntry);
+    if (values_start > size || header.values_size > size - values_start)
+      return std::nullopt;
+
+    const u8* const values = data + values_start;
+    for (u32 i = 0; i < header.num_indexed_entries; i++)
+    {
+      IndexEntry entry;
+      std::memcpy(&entry, data + sizeof(Header) + i * sizeof(IndexEntry), sizeof(IndexEntry));
+      if (entry.value_offset > header.values_size ||
+          u64(entry.value_size) * sizeof(V) > header.values_size - entry.value_offset)
+      {
+        return std::nullopt;
+      }
+
+      function(entry.key, reinterpret_cast<const V*>(values + entry.value_offset),
+               entry.value_size);
+    }
+
+    u64 offset = values_start + header.values_size;
+    u32 num_appended_entries = 0;
+    while (size - offset >= sizeof(u32))
+    {
+      u32 value_size;
+      std::memcpy(&value_size, data + offset, sizeof(u32));
+      const u64 value_bytes = u64(value_size) * sizeof(V);
+      const u64 entry_size = sizeof(u32) + sizeof(K) + value_bytes + sizeof(u32);
+      if (entry_size > size - offset)
+        break;
+
+      const u8* const key = data + offset + sizeof(u32);
+      u32 entry_number;
+      std::memcpy(&entry_number, key + sizeof(K) + value_bytes, sizeof(u32));
+      if (entry_number != header.num_indexed_entries + num_appended_entries + 1)
+        break;
+
+      K key_copy;
+      std::memcpy(&key_copy, key, sizeof(K));
+      function(key_copy, reinterpret_cast<const V*>(key + sizeof(K)), value_size);
+
+      num_appended_entries++;
+      offset += entry_size;
+    }
+
+    return FileLayout{header.num_indexed_entries, num_appended_entries, offset};
+  }
 
   File::IOFile m_file;
   u32 m_num_entries = 0;
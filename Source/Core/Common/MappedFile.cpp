@@ -0,0 +1,112 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <string>
+
+#ifdef _WIN32
+#include <windows.h>
+
+#include "Common/StringUtil.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+MappedFile::MappedFile() = default;
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& filename)
+{
+  Close();
+
+#ifdef _WIN32
+  const HANDLE file = CreateFileW(UTF8ToWString(filename).c_str(), GENERIC_READ, FILE_SHARE_READ,
+                                  nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    return false;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size))
+  {
+    CloseHandle(file);
+    return false;
+  }
+  m_size = static_cast<u64>(size.QuadPart);
+
+  // Mapping an empty file fails, but there's nothing to map anyway.
+  if (m_size != 0)
+  {
+    m_mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (m_mapping_handle)
+      m_data = static_cast<const u8*>(MapViewOfFile(m_mapping_handle, FILE_MAP_READ, 0, 0, 0));
+  }
+  CloseHandle(file);
+
+  if (m_size != 0 && !m_data)
+  {
+    Close();
+    return false;
+  }
+#else
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    return false;
+
+  struct stat file_info;
+  if (fstat(fd, &file_info) != 0)
+  {
+    close(fd);
+    return false;
+  }
+  m_size = static_cast<u64>(file_info.st_size);
+
+  // Mapping an empty file fails, but there's nothing to map anyway.
+  if (m_size != 0)
+  {
+    void* const data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    m_data = data != MAP_FAILED ? static_cast<const u8*>(data) : nullptr;
+  }
+  close(fd);
+
+  if (m_size != 0 && !m_data)
+  {
+    m_size = 0;
+    return false;
+  }
+#endif
+
+  m_is_open = true;
+  return true;
+}
+
+void MappedFile::Close()
+{
+#ifdef _WIN32
+  if (m_data)
+    UnmapViewOfFile(m_data);
+  if (m_mapping_handle)
+    CloseHandle(m_mapping_handle);
+  m_mapping_handle = nullptr;
+#else
+  if (m_data)
+    munmap(const_cast<u8*>(m_data), m_size);
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+  m_is_open = false;
+}
+
+}  // namespace File
@@ -0,0 +1,142 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+
+// A fixed set of threads which split an indexed range of work items between themselves.
+// The thread submitting the work participates as well, so a pool with zero threads simply
+// runs everything on the calling thread.
+
+namespace Common
+{
+class WorkerPool
+{
+public:
+  explicit WorkerPool(const char* name = "WorkerPool") : m_name(name) {}
+  ~WorkerPool() { Resize(0); }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  u32 GetNumThreads() const { return static_cast<u32>(m_threads.size()); }
+
+  void Resize(u32 num_threads)
+  {
+    if (num_threads == m_threads.size())
+      return;
+
+    {
+      std::lock_guard lg(m_lock);
+      m_exit = true;
+    }
+    m_work_cv.notify_all();
+    for (std::thread& thread : m_threads)
+      thread.join();
+    m_threads.clear();
+    m_exit = false;
+
+    for (u32 i = 0; i < num_threads; i++)
+      m_threads.emplace_back(&WorkerPool::ThreadLoop, this);
+  }
+
+  // Calls function(i) for every i in [0, count) and returns once all calls have completed.
+  // Calls may happen in any order and on any thread of the pool, including the caller's.
+  void ParallelFor(u32 count, const std::function<void(u32)>& function)
+  {
+    if (count == 0)
+      return;
+
+    if (m_threads.empty() || count == 1)
+    {
+      for (u32 i = 0; i < count; i++)
+        function(i);
+      return;
+    }
+
+    {
+      std::lock_guard lg(m_lock);
+      m_function = &function;
+      m_count = count;
+      m_next_index.store(0, std::memory_order_relaxed);
+      m_completed = 0;
+      m_generation++;
+    }
+    m_work_cv.notify_all();
+
+    RunItems();
+
+    std::unique_lock lk(m_lock);
+    m_done_cv.wait(lk, [this] { return m_completed == m_count && m_active_workers == 0; });
+    m_function = nullptr;
+  }
+
+private:
+  void RunItems()
+  {
+    u32 completed = 0;
+    for (u32 i = m_next_index.fetch_add(1, std::memory_order_relaxed); i < m_count;
+         i = m_next_index.fetch_add(1, std::memory_order_relaxed))
+    {
+      (*m_function)(i);
+      completed++;
+    }
+
+    std::lock_guard lg(m_lock);
+    m_completed += completed;
+  }
+
+  void ThreadLoop()
+  {
+    Common::SetCurrentThreadName(m_name);
+
+    u64 seen_generation = 0;
+    std::unique_lock lk(m_lock);
+    while (true)
+    {
+      m_work_cv.wait(lk, [&] { return m_exit || m_generation != seen_generation; });
+      if (m_exit)
+        break;
+
+      // The work may already have been finished by the other threads.
+      seen_generation = m_generation;
+      if (!m_function)
+        continue;
+
+      m_active_workers++;
+      lk.unlock();
+
+      RunItems();
+
+      lk.lock();
+      m_active_workers--;
+      m_done_cv.notify_all();
+    }
+  }
+
+  const char* m_name;
+  std::vector<std::thread> m_threads;
+  std::mutex m_lock;
+  std::condition_variable m_work_cv;
+  std::condition_variable m_done_cv;
+
+  // Current work, only modified by the submitting thread while holding m_lock.
+  const std::function<void(u32)>* m_function = nullptr;
+  u32 m_count = 0;
+  std::atomic<u32> m_next_index{0};
+  u32 m_completed = 0;
+  u32 m_active_workers = 0;
+  u64 m_generation = 0;
+  bool m_exit = false;
+};
+
+}  // namespace Common
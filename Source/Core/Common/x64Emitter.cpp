@@ -1858,12 +1858,11 @@ static int GetVEXpp(u8 opPrefix)
 }
 
 void XEmitter::WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   int mmmmm = GetVEXmmmmm(op);
   int pp = GetVEXpp(opPrefix);
-  // FIXME: we currently don't support 256-bit instructions, and "size" is not the vector size here
-  arg.WriteVEX(this, regOp1, regOp2, 0, pp, mmmmm, W);
+  arg.WriteVEX(this, regOp1, regOp2, L, pp, mmmmm, W);
   Write8(op & 0xFF);
   arg.WriteRest(this, extrabytes, regOp1);
 }
@@ -1891,6 +1890,14 @@ void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
   WriteVEXOp4(opPrefix, op, regOp1, regOp2, arg, regOp3, W);
 }
 
+void XEmitter::WriteAVX2Op256(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2,
+                              const OpArg& arg, int extrabytes)
+{
+  if (!cpu_info.bAVX2)
+    PanicAlertFmt("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, 0, extrabytes, 1);
+}
+
 void XEmitter::WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W)
 {
   if (!cpu_info.bFMA)
@@ -3047,6 +3054,81 @@ void XEmitter::VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
   WriteAVXOp(0x66, 0xEF, regOp1, regOp2, arg);
 }
 
+void XEmitter::VMOVD_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x66, 0x6E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVQ_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x7E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVDQU(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, sseMOVDQfromRM, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVSS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0xF3, sseMOVUPtoRM, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVLPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, sseMOVLPtoRM, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVUPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, sseMOVUPtoRM, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVHLPS(X64Reg regOp1, X64Reg regOp2, X64Reg regOp3)
+{
+  WriteAVXOp(0x00, sseMOVHLPS, regOp1, regOp2, R(regOp3));
+}
+void XEmitter::VCVTSI2SS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x2A, regOp1, regOp2, arg);
+}
+
+void XEmitter::VZEROUPPER()
+{
+  if (!cpu_info.bAVX)
+    PanicAlertFmt("Trying to use AVX on a system that doesn't support it. Bad programmer.");
+  Write8(0xC5);
+  Write8(0xF8);
+  Write8(0x77);
+}
+
+void XEmitter::VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane)
+{
+  WriteAVX2Op256(0x66, 0x3A38, regOp1, regOp2, arg, 1);
+  Write8(lane);
+}
+void XEmitter::VEXTRACTI128(const OpArg& arg, X64Reg regOp, u8 lane)
+{
+  WriteAVX2Op256(0x66, 0x3A39, regOp, INVALID_REG, arg, 1);
+  Write8(lane);
+}
+void XEmitter::VPSHUFB_ymm(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op256(0x66, 0x3800, regOp1, regOp2, arg);
+}
+void XEmitter::VPSRAD_ymm(X64Reg regOp1, X64Reg regOp2, u8 shift)
+{
+  WriteAVX2Op256(0x66, 0x72, (X64Reg)4, regOp1, R(regOp2), 1);
+  Write8(shift);
+}
+void XEmitter::VPSRLD_ymm(X64Reg regOp1, X64Reg regOp2, u8 shift)
+{
+  WriteAVX2Op256(0x66, 0x72, (X64Reg)2, regOp1, R(regOp2), 1);
+  Write8(shift);
+}
+void XEmitter::VCVTDQ2PS_ymm(X64Reg regOp, const OpArg& arg)
+{
+  WriteAVX2Op256(0x00, 0x5B, regOp, INVALID_REG, arg);
+}
+void XEmitter::VMULPS_ymm(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op256(0x00, sseMUL, regOp1, regOp2, arg);
+}
+
 void XEmitter::VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
 {
   WriteFMA3Op(0x98, regOp1, regOp2, arg);
@@ -5,10 +5,13 @@
 
 #include <algorithm>
 #include <cstring>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <zstd.h>
+
 #include "Common/IOFile.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
@@ -17,11 +20,13 @@
 enum
 {
   FILE_ID = 0x0d01f1f0,
-  VERSION_NUMBER = 5,
+  VERSION_NUMBER = 6,
   MIN_LOADER_VERSION = 1,
   // This value is only used if the DFF file was created with overridden RAM sizes.
   // If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
   MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5,
+  // Compressed files were added in version 6.
+  MIN_LOADER_VERSION_FOR_COMPRESSION = 6,
 };
 
 #pragma pack(push, 1)
@@ -52,6 +57,9 @@ struct FileHeader
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
+// In compressed files, the FIFO data and memory updates of each frame are stored as a single
+// zstd-compressed chunk at fifoDataOffset. The FIFO data comes first in the decompressed chunk,
+// and memoryUpdatesOffset and the dataOffset of the memory updates are relative to its start.
 struct FileFrameInfo
 {
   u64 fifoDataOffset;
@@ -60,7 +68,9 @@ struct FileFrameInfo
   u32 fifoEnd;
   u64 memoryUpdatesOffset;
   u32 numMemoryUpdates;
-  u8 reserved[32];
+  u32 compressedChunkSize;
+  u32 chunkSize;
+  u8 reserved[24];
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
@@ -77,6 +87,18 @@ static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 byt
 
 #pragma pack(pop)
 
+static std::shared_ptr<const FifoFrameInfo> FailedToReadFrame(const FileFrameInfo& srcFrame,
+                                                              u32 frame)
+{
+  CriticalAlertFmtT("Failed to read frame {0} of the DFF file.", frame);
+
+  // Keep the FIFO bounds, so that the rest of the file can still be played back.
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+  return dstFrame;
+}
+
 FifoDataFile::FifoDataFile() = default;
 
 FifoDataFile::~FifoDataFile() = default;
@@ -101,23 +123,100 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
+bool FifoDataFile::IsCompressed() const
+{
+  return GetFlag(FLAG_COMPRESSED);
+}
+
 void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  m_Frames.push_back(std::make_shared<const FifoFrameInfo>(frameInfo));
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame)
+{
+  if (m_frame_index.empty())
+    return m_Frames[frame];
+
+  const auto find_in_cache = [this](u32 frame_num) {
+    return std::find_if(m_frame_cache.begin(), m_frame_cache.end(),
+                        [frame_num](const auto& entry) { return entry.first == frame_num; });
+  };
+  const auto add_to_cache = [this](u32 frame_num, std::shared_future<FramePointer> future) {
+    m_frame_cache.emplace_back(frame_num, std::move(future));
+    if (m_frame_cache.size() > FRAME_CACHE_SIZE)
+      m_frame_cache.pop_front();
+  };
+
+  std::shared_future<FramePointer> future;
+  std::promise<FramePointer> promise;
+  bool read_here = false;
+  {
+    std::lock_guard lk(m_frame_cache_lock);
+
+    const auto it = find_in_cache(frame);
+    if (it != m_frame_cache.end())
+    {
+      future = it->second;
+    }
+    else
+    {
+      future = promise.get_future().share();
+      add_to_cache(frame, future);
+      read_here = true;
+    }
+
+    // Frames are almost always played back in order, so read the next ones while this one is used.
+    const u32 read_ahead_end = std::min(frame + 1 + READ_AHEAD_FRAMES, GetFrameCount());
+    for (u32 next = frame + 1; next < read_ahead_end; ++next)
+    {
+      if (find_in_cache(next) != m_frame_cache.end())
+        continue;
+
+      std::promise<FramePointer> next_promise;
+      add_to_cache(next, next_promise.get_future().share());
+      m_read_ahead_thread.EmplaceItem(FrameRead{next, std::move(next_promise)});
+    }
+  }
+
+  if (read_here)
+    promise.set_value(ReadFrame(frame));
+
+  return future.get();
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  if (!m_frame_index.empty())
+    return static_cast<u32>(m_frame_index.size());
+
+  return static_cast<u32>(m_Frames.size());
 }
 
 bool FifoDataFile::Save(const std::string& filename)
+{
+  return Save(filename, false, 0);
+}
+
+bool FifoDataFile::SaveCompressed(const std::string& filename, int compression_level)
+{
+  return Save(filename, true, compression_level);
+}
+
+bool FifoDataFile::Save(const std::string& filename, bool compress, int compression_level)
 {
   File::IOFile file;
   if (!file.Open(filename, "wb"))
     return false;
 
+  const u32 frameCount = GetFrameCount();
+
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
   // Add space for frame list
   u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
+  PadFile(frameCount * sizeof(FileFrameInfo), file);
 
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
@@ -135,11 +234,19 @@ bool FifoDataFile::Save(const std::string& filename)
   file.WriteArray(m_TexMem);
 
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
+
+  // Loaded files keep the sizes they were recorded with when they are converted.
+  header.mem1_size = m_ram_size_real != 0 ? m_ram_size_real : Memory::GetRamSizeReal();
+  header.mem2_size = m_exram_size_real != 0 ? m_exram_size_real : Memory::GetExRamSizeReal();
+
   // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
+  if (compress)
+    header.min_loader_version = MIN_LOADER_VERSION_FOR_COMPRESSION;
+  else if (header.mem1_size != Memory::MEM1_SIZE_RETAIL ||
+           header.mem2_size != Memory::MEM2_SIZE_RETAIL)
     header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
   else
     header.min_loader_version = MIN_LOADER_VERSION;
@@ -160,36 +267,42 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = frameCount;
 
-  header.flags = m_Flags;
-
-  header.mem1_size = Memory::GetRamSizeReal();
-  header.mem2_size = Memory::GetExRamSizeReal();
+  header.flags = m_Flags & ~FLAG_COMPRESSED;
+  if (compress)
+    header.flags |= FLAG_COMPRESSED;
 
   file.Seek(0, SEEK_SET);
   file.WriteBytes(&header, sizeof(FileHeader));
 
   // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
+  for (u32 i = 0; i < frameCount; ++i)
   {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, SEEK_END);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+    const std::shared_ptr<const FifoFrameInfo> frame = GetFrame(i);
+    const FifoFrameInfo& srcFrame = *frame;
 
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
+    FileFrameInfo dstFrame{};
     dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
     dstFrame.fifoStart = srcFrame.fifoStart;
     dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
     dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
 
+    if (compress)
+    {
+      if (!WriteCompressedFrame(srcFrame, compression_level, &dstFrame, file))
+        return false;
+    }
+    else
+    {
+      // Write FIFO data
+      file.Seek(0, SEEK_END);
+      dstFrame.fifoDataOffset = file.Tell();
+      file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
+
+      dstFrame.memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
+    }
+
     // Write frame info
     u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
     file.Seek(frameOffset, SEEK_SET);
@@ -202,6 +315,54 @@ bool FifoDataFile::Save(const std::string& filename)
   return true;
 }
 
+bool FifoDataFile::WriteCompressedFrame(const FifoFrameInfo& frame, int compression_level,
+                                        FileFrameInfo* frame_info, File::IOFile& file)
+{
+  // Lay the frame out like in uncompressed files, but relative to the start of the chunk.
+  const u64 updateListOffset = frame.fifoData.size();
+  u64 chunkSize = updateListOffset + frame.memoryUpdates.size() * sizeof(FileMemoryUpdate);
+  for (const MemoryUpdate& update : frame.memoryUpdates)
+    chunkSize += update.data.size();
+
+  if (chunkSize > std::numeric_limits<u32>::max())
+    return false;
+
+  std::vector<u8> chunk(chunkSize);
+  std::copy(frame.fifoData.begin(), frame.fifoData.end(), chunk.data());
+
+  u64 dataOffset = updateListOffset + frame.memoryUpdates.size() * sizeof(FileMemoryUpdate);
+  for (size_t i = 0; i < frame.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frame.memoryUpdates[i];
+
+    FileMemoryUpdate dstUpdate{};
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.dataOffset = dataOffset;
+    dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.type = srcUpdate.type;
+
+    std::memcpy(chunk.data() + updateListOffset + i * sizeof(FileMemoryUpdate), &dstUpdate,
+                sizeof(FileMemoryUpdate));
+    std::copy(srcUpdate.data.begin(), srcUpdate.data.end(), chunk.data() + dataOffset);
+    dataOffset += srcUpdate.data.size();
+  }
+
+  std::vector<u8> compressed(ZSTD_compressBound(chunk.size()));
+  const size_t compressedSize = ZSTD_compress(compressed.data(), compressed.size(), chunk.data(),
+                                              chunk.size(), compression_level);
+  if (ZSTD_isError(compressedSize) || compressedSize > std::numeric_limits<u32>::max())
+    return false;
+
+  file.Seek(0, SEEK_END);
+  frame_info->fifoDataOffset = file.Tell();
+  frame_info->memoryUpdatesOffset = updateListOffset;
+  frame_info->compressedChunkSize = static_cast<u32>(compressedSize);
+  frame_info->chunkSize = static_cast<u32>(chunk.size());
+
+  return file.WriteBytes(compressed.data(), compressedSize);
+}
+
 std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bool flagsOnly)
 {
   File::IOFile file;
@@ -214,7 +375,8 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     return nullptr;
   };
 
-  if (file.GetSize() == 0)
+  const u64 fileSize = file.GetSize();
+  if (fileSize == 0)
   {
     CriticalAlertFmtT("DFF file size is 0; corrupt/incomplete file?");
     return nullptr;
@@ -265,24 +427,6 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
     return dataFile;
   }
 
-  // To make up for such a hacky thing, here is a catch-all failsafe in case if the above code
-  // stops working or is otherwise removed.  As it is, this should never end up running.
-  // It should be noted, however, that Dolphin *will still crash* from the nullptr being returned
-  // in a non-flagsOnly context, so if this code becomes necessary, it should be moved above the
-  // prior conditional.
-  if (header.mem1_size != Memory::GetRamSizeReal() ||
-      header.mem2_size != Memory::GetExRamSizeReal())
-  {
-    CriticalAlertFmtT("Emulated memory size mismatch!\n"
-                      "Current: MEM1 {0:08X} ({1} MiB), MEM2 {2:08X} ({3} MiB)\n"
-                      "DFF: MEM1 {4:08X} ({5} MiB), MEM2 {6:08X} ({7} MiB)",
-                      Memory::GetRamSizeReal(), Memory::GetRamSizeReal() / 0x100000,
-                      Memory::GetExRamSizeReal(), Memory::GetExRamSizeReal() / 0x100000,
-                      header.mem1_size, header.mem1_size / 0x100000, header.mem2_size,
-                      header.mem2_size / 0x100000);
-    return nullptr;
-  }
-
   u32 size = std::min<u32>(BP_MEM_SIZE, header.bpMemSize);
   file.Seek(header.bpMemOffset, SEEK_SET);
   file.ReadArray(&dataFile->m_BPMem);
@@ -315,33 +459,104 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
+  // Only read the frame list. The frames themselves are read from the file when they are needed.
+  if (header.frameListOffset > fileSize ||
+      (fileSize - header.frameListOffset) / sizeof(FileFrameInfo) < header.frameCount)
   {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, SEEK_SET);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
+    return panic_failed_to_read();
+  }
+
+  dataFile->m_frame_index.resize(header.frameCount);
+  file.Seek(header.frameListOffset, SEEK_SET);
+  if (!file.ReadArray(dataFile->m_frame_index.data(), header.frameCount))
+    return panic_failed_to_read();
+
+  const bool compressed = dataFile->IsCompressed();
+  for (const FileFrameInfo& frame : dataFile->m_frame_index)
+  {
+    const u64 dataSize = compressed ? frame.compressedChunkSize : frame.fifoDataSize;
+    if (frame.fifoDataOffset > fileSize || fileSize - frame.fifoDataOffset < dataSize)
       return panic_failed_to_read();
+  }
 
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
+  dataFile->m_file = std::move(file);
+  dataFile->m_read_ahead_thread.Reset([data_file = dataFile.get()](FrameRead read) {
+    read.promise.set_value(data_file->ReadFrame(read.frame));
+  });
+
+  return dataFile;
+}
+
+FifoDataFile::FramePointer FifoDataFile::ReadFrame(u32 frame)
+{
+  if (IsCompressed())
+    return ReadCompressedFrame(frame);
+
+  const FileFrameInfo& srcFrame = m_frame_index[frame];
+
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoData.resize(srcFrame.fifoDataSize);
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  bool success;
+  {
+    std::lock_guard lk(m_file_lock);
 
-    file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
+    m_file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
+    m_file.ReadBytes(dstFrame->fifoData.data(), srcFrame.fifoDataSize);
 
     ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+                      dstFrame->memoryUpdates, m_file);
 
-    if (!file.IsGood())
-      return panic_failed_to_read();
+    success = m_file.IsGood();
+    m_file.Clear();
+  }
+
+  if (!success)
+    return FailedToReadFrame(srcFrame, frame);
+
+  return dstFrame;
+}
+
+FifoDataFile::FramePointer FifoDataFile::ReadCompressedFrame(u32 frame)
+{
+  const FileFrameInfo& srcFrame = m_frame_index[frame];
 
-    dataFile->AddFrame(dstFrame);
+  std::vector<u8> compressed(srcFrame.compressedChunkSize);
+  bool success;
+  {
+    std::lock_guard lk(m_file_lock);
+
+    m_file.Seek(srcFrame.fifoDataOffset, SEEK_SET);
+    success = m_file.ReadBytes(compressed.data(), compressed.size());
+    m_file.Clear();
   }
 
-  return dataFile;
+  // Decompress without holding the lock, so that the next frame can be read in the meantime.
+  std::vector<u8> chunk(srcFrame.chunkSize);
+  if (success)
+  {
+    const size_t result =
+        ZSTD_decompress(chunk.data(), chunk.size(), compressed.data(), compressed.size());
+    success = !ZSTD_isError(result) && result == chunk.size();
+  }
+
+  if (!success || srcFrame.fifoDataSize > chunk.size())
+    return FailedToReadFrame(srcFrame, frame);
+
+  auto dstFrame = std::make_shared<FifoFrameInfo>();
+  dstFrame->fifoData.assign(chunk.begin(), chunk.begin() + srcFrame.fifoDataSize);
+  dstFrame->fifoStart = srcFrame.fifoStart;
+  dstFrame->fifoEnd = srcFrame.fifoEnd;
+
+  if (!ParseMemoryUpdates(chunk, srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
+                          dstFrame->memoryUpdates))
+  {
+    return FailedToReadFrame(srcFrame, frame);
+  }
+
+  return dstFrame;
 }
 
 void FifoDataFile::PadFile(size_t numBytes, File::IOFile& file)
@@ -416,3 +631,34 @@ void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
     file.ReadBytes(dstUpdate.data.data(), srcUpdate.dataSize);
   }
 }
+
+bool FifoDataFile::ParseMemoryUpdates(const std::vector<u8>& chunk, u64 offset, u32 numUpdates,
+                                      std::vector<MemoryUpdate>& memUpdates)
+{
+  if (offset > chunk.size() || (chunk.size() - offset) / sizeof(FileMemoryUpdate) < numUpdates)
+    return false;
+
+  memUpdates.resize(numUpdates);
+
+  for (u32 i = 0; i < numUpdates; ++i)
+  {
+    FileMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, chunk.data() + offset + i * sizeof(FileMemoryUpdate),
+                sizeof(FileMemoryUpdate));
+
+    if (srcUpdate.dataOffset > chunk.size() ||
+        chunk.size() - srcUpdate.dataOffset < srcUpdate.dataSize)
+    {
+      return false;
+    }
+
+    MemoryUpdate& dstUpdate = memUpdates[i];
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.data.assign(chunk.begin() + srcUpdate.dataOffset,
+                          chunk.begin() + srcUpdate.dataOffset + srcUpdate.dataSize);
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+  }
+
+  return true;
+}
@@ -4,17 +4,20 @@
 #pragma once
 
 #include <array>
+#include <deque>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/XFMemory.h"
 
-namespace File
-{
-class IOFile;
-}
+struct FileFrameInfo;
 
 struct MemoryUpdate
 {
@@ -72,19 +75,48 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
+  bool IsCompressed() const;
+
   void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // The frames of a loaded file are only read from it when they are needed, and only the last few
+  // of them are kept in memory. Keep the returned frame around for as long as it is used.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame);
+  u32 GetFrameCount() const;
+
+  // Writes the original format, which older versions can read.
   bool Save(const std::string& filename);
+  // Writes every frame as a separate zstd-compressed chunk, so that they can be streamed from the
+  // file during playback like uncompressed ones.
+  bool SaveCompressed(const std::string& filename, int compression_level);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
 
 private:
   enum
   {
-    FLAG_IS_WII = 1
+    FLAG_IS_WII = 1,
+    FLAG_COMPRESSED = 2,
   };
 
+  // How many frames after the one being read are read ahead on another thread.
+  static constexpr u32 READ_AHEAD_FRAMES = 2;
+  static constexpr size_t FRAME_CACHE_SIZE = READ_AHEAD_FRAMES + 2;
+
+  using FramePointer = std::shared_ptr<const FifoFrameInfo>;
+
+  struct FrameRead
+  {
+    u32 frame;
+    std::promise<FramePointer> promise;
+  };
+
+  bool Save(const std::string& filename, bool compress, int compression_level);
+  bool WriteCompressedFrame(const FifoFrameInfo& frame, int compression_level,
+                            FileFrameInfo* frame_info, File::IOFile& file);
+
+  FramePointer ReadFrame(u32 frame);
+  FramePointer ReadCompressedFrame(u32 frame);
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
@@ -93,6 +125,8 @@ private:
   u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  static bool ParseMemoryUpdates(const std::vector<u8>& chunk, u64 offset, u32 numUpdates,
+                                 std::vector<MemoryUpdate>& memUpdates);
 
   std::array<u32, BP_MEM_SIZE> m_BPMem{};
   std::array<u32, CP_MEM_SIZE> m_CPMem{};
@@ -105,5 +139,14 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Frames which were added rather than loaded.
+  std::vector<FramePointer> m_Frames;
+
+  // Where the frames of a loaded file are, and the ones which have been read or are being read.
+  std::vector<FileFrameInfo> m_frame_index;
+  File::IOFile m_file;
+  std::mutex m_file_lock;
+  std::deque<std::pair<u32, std::shared_future<FramePointer>>> m_frame_cache;
+  std::mutex m_frame_cache_lock;
+  Common::WorkQueueThread<FrameRead> m_read_ahead_thread;
 };
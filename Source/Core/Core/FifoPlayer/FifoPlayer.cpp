@@ -5,6 +5,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <memory>
 #include <mutex>
 
 #include "Common/Assert.h"
@@ -75,7 +76,8 @@ void FifoPlaybackAnalyzer::AnalyzeFrames(FifoDataFile* file,
 
   for (u32 frame_no = 0; frame_no < file->GetFrameCount(); frame_no++)
   {
-    const FifoFrameInfo& frame = file->GetFrame(frame_no);
+    const std::shared_ptr<const FifoFrameInfo> frame_ptr = file->GetFrame(frame_no);
+    const FifoFrameInfo& frame = *frame_ptr;
     AnalyzedFrameInfo& analyzed = frame_info[frame_no];
 
     u32 offset = 0;
@@ -180,6 +182,20 @@ bool FifoPlayer::Open(const std::string& filename)
 
   m_File = FifoDataFile::Load(filename, false);
 
+  // The emulated memory sizes are set from the file when booting it, so this should never fail.
+  if (m_File && (m_File->GetRamSizeReal() != Memory::GetRamSizeReal() ||
+                 m_File->GetExRamSizeReal() != Memory::GetExRamSizeReal()))
+  {
+    CriticalAlertFmtT("Emulated memory size mismatch!\n"
+                      "Current: MEM1 {0:08X} ({1} MiB), MEM2 {2:08X} ({3} MiB)\n"
+                      "DFF: MEM1 {4:08X} ({5} MiB), MEM2 {6:08X} ({7} MiB)",
+                      Memory::GetRamSizeReal(), Memory::GetRamSizeReal() / 0x100000,
+                      Memory::GetExRamSizeReal(), Memory::GetExRamSizeReal() / 0x100000,
+                      m_File->GetRamSizeReal(), m_File->GetRamSizeReal() / 0x100000,
+                      m_File->GetExRamSizeReal(), m_File->GetExRamSizeReal() / 0x100000);
+    m_File.reset();
+  }
+
   if (m_File)
   {
     FifoPlaybackAnalyzer::AnalyzeFrames(m_File.get(), m_FrameInfo);
@@ -287,7 +303,7 @@ CPU::State FifoPlayer::AdvanceFrame()
   if (m_EarlyMemoryUpdates && m_CurrentFrame == m_FrameRangeStart)
     WriteAllMemoryUpdates();
 
-  WriteFrame(m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
+  WriteFrame(*m_File->GetFrame(m_CurrentFrame), m_FrameInfo[m_CurrentFrame]);
 
   ++m_CurrentFrame;
   return CPU::State::Running;
@@ -478,8 +494,8 @@ void FifoPlayer::WriteAllMemoryUpdates()
 
   for (u32 frameNum = 0; frameNum < m_File->GetFrameCount(); ++frameNum)
   {
-    const FifoFrameInfo& frame = m_File->GetFrame(frameNum);
-    for (auto& update : frame.memoryUpdates)
+    const std::shared_ptr<const FifoFrameInfo> frame = m_File->GetFrame(frameNum);
+    for (auto& update : frame->memoryUpdates)
     {
       WriteMemory(update);
     }
@@ -537,7 +553,8 @@ void FifoPlayer::SetupFifo()
   WriteCP(CommandProcessor::CTRL_REGISTER, 0);   // disable read, BP, interrupts
   WriteCP(CommandProcessor::CLEAR_REGISTER, 7);  // clear overflow, underflow, metrics
 
-  const FifoFrameInfo& frame = m_File->GetFrame(m_CurrentFrame);
+  const std::shared_ptr<const FifoFrameInfo> frame_ptr = m_File->GetFrame(m_CurrentFrame);
+  const FifoFrameInfo& frame = *frame_ptr;
 
   // Set fifo bounds
   WriteCP(CommandProcessor::FIFO_BASE_LO, frame.fifoStart);
@@ -682,6 +699,9 @@ void FifoPlayer::LoadTextureMemory()
   static_assert(static_cast<size_t>(TMEM_SIZE) == static_cast<size_t>(FifoDataFile::TEX_MEM_SIZE),
                 "TMEM_SIZE matches the size of texture memory in FifoDataFile");
   std::memcpy(texMem, m_File->GetTexMem(), FifoDataFile::TEX_MEM_SIZE);
+
+  // Let the GPU know that the textures it has cached from TMEM are stale.
+  LoadBPReg(BPMEM_TEXINVALIDATE, 0);
 }
 
 void FifoPlayer::WriteCP(u32 address, u16 value)
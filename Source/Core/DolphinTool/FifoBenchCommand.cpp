@@ -0,0 +1,320 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/FifoBenchCommand.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <variant>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/Flag.h"
+#include "Common/IOFile.h"
+#include "Common/WindowSystemInfo.h"
+#include "Core/Boot/Boot.h"
+#include "Core/BootManager.h"
+#include "Core/Config/GraphicsSettings.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/Core.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/Statistics.h"
+
+namespace DolphinTool
+{
+namespace
+{
+// The CPU time of a frame, split into stages which don't overlap.
+struct FrameTimes
+{
+  u64 total_ns = 0;
+  u64 opcode_decoding_ns = 0;
+  u64 vertex_loading_ns = 0;
+  u64 texture_loading_ns = 0;
+  u64 backend_submission_ns = 0;
+  // Everything outside of the GPU's command processing, mostly writing the frame to the FIFO.
+  u64 other_ns = 0;
+};
+
+u64 SaturatingSubtract(u64 a, u64 b)
+{
+  return a > b ? a - b : 0;
+}
+
+// The statistics measure nested stages, command processing contains vertex loading, draw
+// submission and EFB copies, and draw submission contains texture loading. Subtract them from each
+// other. EFB copies, clears and XFB copies are work for the backend just like draws are.
+FrameTimes GetFrameTimes(u64 total_ns, const Statistics::StageTimes& start,
+                         const Statistics::StageTimes& end)
+{
+  const u64 command_processing_ns = end.command_processing_ns - start.command_processing_ns;
+  const u64 draw_submission_ns = end.draw_submission_ns - start.draw_submission_ns;
+  const u64 efb_copy_ns = end.efb_copy_ns - start.efb_copy_ns;
+
+  FrameTimes times;
+  times.total_ns = total_ns;
+  times.vertex_loading_ns = end.vertex_loading_ns - start.vertex_loading_ns;
+  times.texture_loading_ns = end.texture_loading_ns - start.texture_loading_ns;
+  times.backend_submission_ns =
+      SaturatingSubtract(draw_submission_ns, times.texture_loading_ns) + efb_copy_ns;
+  times.opcode_decoding_ns = SaturatingSubtract(
+      command_processing_ns, times.vertex_loading_ns + draw_submission_ns + efb_copy_ns);
+  times.other_ns = SaturatingSubtract(total_ns, command_processing_ns);
+  return times;
+}
+
+// Records the times of every frame the FIFO player writes. The player calls back on the CPU
+// thread before writing each frame. The benchmark runs in single core, so that is also the thread
+// the GPU commands are processed on, and everything the GPU did since the last call belongs to
+// the last frame.
+class FrameRecorder
+{
+public:
+  explicit FrameRecorder(u32 num_loops) : m_num_loops(num_loops) {}
+
+  void OnFrameWritten()
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const Statistics::StageTimes stage_times = g_stats.GetTotalStageTimes();
+
+    if (m_frames_per_loop == 0)
+    {
+      m_frames_per_loop = FifoPlayer::GetInstance().GetFile()->GetFrameCount();
+      m_frames.reserve(static_cast<size_t>(m_frames_per_loop) * m_num_loops);
+    }
+    else if (!m_done.IsSet())
+    {
+      const u64 total_ns = static_cast<u64>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last_time).count());
+      m_frames.push_back(GetFrameTimes(total_ns, m_last_stage_times, stage_times));
+      if (m_frames.size() == static_cast<size_t>(m_frames_per_loop) * m_num_loops)
+        m_done.Set();
+    }
+
+    m_last_time = now;
+    m_last_stage_times = stage_times;
+  }
+
+  bool IsDone() const { return m_done.IsSet(); }
+
+  // Only safe to call once the emulation has stopped.
+  u32 GetFramesPerLoop() const { return m_frames_per_loop; }
+  const std::vector<FrameTimes>& GetFrames() const { return m_frames; }
+
+private:
+  const u32 m_num_loops;
+  u32 m_frames_per_loop = 0;
+  std::vector<FrameTimes> m_frames;
+  std::chrono::steady_clock::time_point m_last_time;
+  Statistics::StageTimes m_last_stage_times{};
+  Common::Flag m_done;
+};
+
+double ToMilliseconds(u64 ns)
+{
+  return ns / 1000000.0;
+}
+
+void PrintStage(std::string_view stage, const std::vector<FrameTimes>& frames,
+                u64 FrameTimes::*member)
+{
+  u64 sum_ns = 0;
+  u64 max_ns = 0;
+  u64 total_ns = 0;
+  for (const FrameTimes& frame : frames)
+  {
+    sum_ns += frame.*member;
+    max_ns = std::max(max_ns, frame.*member);
+    total_ns += frame.total_ns;
+  }
+
+  const double average_ms = ToMilliseconds(sum_ns) / frames.size();
+  const double share = total_ns > 0 ? 100.0 * sum_ns / total_ns : 0.0;
+  std::cout << fmt::format("{:<20} {:>10.3f} {:>10.3f} {:>7.1f}%", stage, average_ms,
+                           ToMilliseconds(max_ns), share)
+            << std::endl;
+}
+
+bool WriteCSV(const std::string& path, const std::vector<FrameTimes>& frames, u32 frames_per_loop)
+{
+  File::IOFile file(path, "w");
+  if (!file)
+    return false;
+
+  bool success = file.WriteString("loop,frame,total_us,opcode_decoding_us,vertex_loading_us,"
+                                  "texture_loading_us,backend_submission_us,other_us\n");
+  for (size_t i = 0; i < frames.size() && success; i++)
+  {
+    const FrameTimes& frame = frames[i];
+    success = file.WriteString(fmt::format(
+        "{},{},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f},{:.1f}\n", i / frames_per_loop,
+        i % frames_per_loop, frame.total_ns / 1000.0, frame.opcode_decoding_ns / 1000.0,
+        frame.vertex_loading_ns / 1000.0, frame.texture_loading_ns / 1000.0,
+        frame.backend_submission_ns / 1000.0, frame.other_ns / 1000.0));
+  }
+  return success;
+}
+
+Common::Flag s_emulation_stopped;
+}  // namespace
+
+int FifoBenchCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: fifobench [options]...");
+
+  parser->add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, whose settings are used. Will be automatically created if this "
+            "option is not set.");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to FIFO log FILE.")
+      .metavar("FILE");
+
+  parser->add_option("-b", "--backend")
+      .type("string")
+      .action("store")
+      .help("Optional. Video backend to replay the log on. Defaults to Null, which measures the "
+            "GPU thread without rendering anything. \"Software Renderer\" measures the software "
+            "rasterizer as part of the backend submission, without needing a GPU.")
+      .metavar("NAME");
+
+  parser->add_option("-n", "--loops")
+      .type("int")
+      .action("store")
+      .help("Optional. How many times to replay the whole log. Defaults to 1.")
+      .metavar("COUNT");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to a CSV FILE to write the times of every frame to.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  // Validate options
+  const std::string input_file_path = static_cast<const char*>(options.get("input"));
+  if (input_file_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  const int loops = options.is_set("loops") ? static_cast<int>(options.get("loops")) : 1;
+  if (loops <= 0)
+  {
+    std::cerr << "Error: Invalid loop count" << std::endl;
+    return 1;
+  }
+
+  std::unique_ptr<BootParameters> boot = BootParameters::GenerateFromFile(input_file_path);
+  if (!boot || !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+  {
+    std::cerr << "Error: " << input_file_path << " is not a FIFO log" << std::endl;
+    return 1;
+  }
+
+  // Run everything on one thread, so that each frame's GPU work is done before the next frame is
+  // written, and don't limit the speed. The per-stage times are only measured with the statistics
+  // enabled.
+  const std::string backend =
+      options.is_set("backend") ? static_cast<const char*>(options.get("backend")) : "Null";
+  Config::SetCurrent(Config::MAIN_GFX_BACKEND, backend);
+  Config::SetCurrent(Config::MAIN_CPU_THREAD, false);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::SetCurrent(Config::GFX_OVERLAY_STATS, true);
+
+  FrameRecorder recorder(static_cast<u32>(loops));
+  FifoPlayer::GetInstance().SetFrameWrittenCallback([&recorder] { recorder.OnFrameWritten(); });
+  Core::AddOnStateChangedCallback([](Core::State state) {
+    if (state == Core::State::Uninitialized)
+      s_emulation_stopped.Set();
+  });
+
+  const WindowSystemInfo wsi(WindowSystemType::Headless, nullptr, nullptr, nullptr);
+  if (!BootManager::BootCore(std::move(boot), wsi))
+  {
+    std::cerr << "Error: Unable to boot " << input_file_path << std::endl;
+    return 1;
+  }
+
+  while (!recorder.IsDone() && !s_emulation_stopped.IsSet())
+  {
+    Core::HostDispatchJobs();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  Core::Stop();
+  Core::Shutdown();
+  FifoPlayer::GetInstance().SetFrameWrittenCallback(nullptr);
+  UICommon::Shutdown();
+
+  const std::vector<FrameTimes>& frames = recorder.GetFrames();
+  if (!recorder.IsDone())
+  {
+    std::cerr << "Error: Emulation stopped after " << frames.size() << " frames" << std::endl;
+    return 1;
+  }
+
+  const u32 frames_per_loop = recorder.GetFramesPerLoop();
+  std::cout << "Replayed " << frames_per_loop << " frames " << loops << " times on " << backend
+            << std::endl
+            << std::endl;
+
+  std::cout << fmt::format("{:<20} {:>10} {:>10} {:>8}", "Stage", "ms/frame", "max ms", "share")
+            << std::endl;
+  PrintStage("Opcode decoding", frames, &FrameTimes::opcode_decoding_ns);
+  PrintStage("Vertex loading", frames, &FrameTimes::vertex_loading_ns);
+  PrintStage("Texture loading", frames, &FrameTimes::texture_loading_ns);
+  PrintStage("Backend submission", frames, &FrameTimes::backend_submission_ns);
+  PrintStage("Other", frames, &FrameTimes::other_ns);
+  PrintStage("Total", frames, &FrameTimes::total_ns);
+
+  // The first loop also compiles shaders and creates textures, so show whether it stands out.
+  std::cout << std::endl;
+  for (int loop = 0; loop < loops; loop++)
+  {
+    u64 loop_ns = 0;
+    for (u32 i = 0; i < frames_per_loop; i++)
+      loop_ns += frames[loop * frames_per_loop + i].total_ns;
+    std::cout << fmt::format("Loop {:<4} {:>10.3f} ms/frame", loop + 1,
+                             ToMilliseconds(loop_ns) / frames_per_loop)
+              << std::endl;
+  }
+
+  if (options.is_set("output"))
+  {
+    const std::string output_file_path = static_cast<const char*>(options.get("output"));
+    if (!WriteCSV(output_file_path, frames, frames_per_loop))
+    {
+      std::cerr << "Error: Unable to write " << output_file_path << std::endl;
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+}  // namespace DolphinTool
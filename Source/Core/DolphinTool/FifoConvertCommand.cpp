@@ -0,0 +1,118 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/FifoConvertCommand.h"
+
+#include <iostream>
+#include <memory>
+#include <utility>
+
+#include <OptionParser.h>
+
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "DiscIO/WIABlob.h"
+#include "UICommon/UICommon.h"
+
+namespace DolphinTool
+{
+int FifoConvertCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: fifoconvert [options]...");
+
+  parser->add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, whose settings are used. Will be automatically created if this "
+            "option is not set.");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to FIFO log FILE.")
+      .metavar("FILE");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Path to the destination FILE.")
+      .metavar("FILE");
+
+  parser->add_option("-c", "--compression")
+      .type("string")
+      .action("store")
+      .help("Compression method to use. 'none' writes files which older versions can read. "
+            "Default is zstd. [%choices]")
+      .choices({"none", "zstd"});
+
+  parser->add_option("-l", "--compression_level")
+      .type("int")
+      .action("store")
+      .help("Level of compression for the selected method. Ignored if 'none'. Default is 5.");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  // Validate options
+  const std::string input_file_path = static_cast<const char*>(options.get("input"));
+  if (input_file_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  const std::string output_file_path = static_cast<const char*>(options.get("output"));
+  if (output_file_path.empty())
+  {
+    std::cerr << "Error: No output set" << std::endl;
+    return 1;
+  }
+
+  if (output_file_path == input_file_path)
+  {
+    std::cerr << "Error: The output must be a different file than the input" << std::endl;
+    return 1;
+  }
+
+  const bool compress = !options.is_set("compression") ||
+                        std::string(static_cast<const char*>(options.get("compression"))) != "none";
+
+  const int compression_level =
+      options.is_set("compression_level") ? static_cast<int>(options.get("compression_level")) : 5;
+  const std::pair<int, int> range =
+      DiscIO::GetAllowedCompressionLevels(DiscIO::WIARVZCompressionType::Zstd);
+  if (compress && (compression_level < range.first || compression_level > range.second))
+  {
+    std::cerr << "Error: Compression level not in acceptable range" << std::endl;
+    return 1;
+  }
+
+  // The frames are read from the input while they are written, so this doesn't need to hold the
+  // whole log in memory.
+  std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(input_file_path, false);
+  if (!file)
+  {
+    std::cerr << "Error: Unable to open " << input_file_path << std::endl;
+    return 1;
+  }
+
+  const bool success = compress ? file->SaveCompressed(output_file_path, compression_level) :
+                                  file->Save(output_file_path);
+  if (!success)
+  {
+    std::cerr << "Error: Unable to write " << output_file_path << std::endl;
+    return 1;
+  }
+
+  std::cout << "Converted " << file->GetFrameCount() << " frames" << std::endl;
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,44 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/GraphicsConfig.h"
+
+#include <string>
+
+#include <OptionParser.h>
+
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/ConfigLoaders/GameConfigLoader.h"
+#include "UICommon/UICommon.h"
+#include "VideoCommon/VideoBackendBase.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DolphinTool
+{
+void InitGraphicsConfig(const optparse::Values& options)
+{
+  std::string user_directory;
+  if (options.is_set("user"))
+    user_directory = static_cast<const char*>(options.get("user"));
+
+  UICommon::SetUserDirectory(user_directory);
+  UICommon::Init();
+
+  const std::string game_id =
+      options.is_set("game_id") ? static_cast<const char*>(options.get("game_id")) : "";
+  if (!game_id.empty())
+  {
+    Config::AddLayer(ConfigLoaders::GenerateGlobalGameConfigLoader(game_id, 0));
+    Config::AddLayer(ConfigLoaders::GenerateLocalGameConfigLoader(game_id, 0));
+  }
+  if (options.is_set("backend"))
+  {
+    Config::SetCurrent(Config::MAIN_GFX_BACKEND,
+                       std::string(static_cast<const char*>(options.get("backend"))));
+  }
+  VideoBackendBase::PopulateBackendInfo();
+  UpdateActiveConfig();
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,18 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+namespace optparse
+{
+class Values;
+}
+
+namespace DolphinTool
+{
+// Sets up the user folder from the "user" option, and loads the graphics settings the game given
+// by the "game_id" option would boot with, optionally with the video backend overridden by the
+// "backend" option. Shader generation depends on both the settings and the backend's features.
+void InitGraphicsConfig(const optparse::Values& options);
+
+}  // namespace DolphinTool
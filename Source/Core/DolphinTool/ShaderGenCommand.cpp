@@ -0,0 +1,204 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ShaderGenCommand.h"
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <string_view>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/IOFile.h"
+#include "DolphinTool/GraphicsConfig.h"
+#include "VideoCommon/GXPipelineTypes.h"
+#include "VideoCommon/GeometryShaderGen.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/VertexShaderGen.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace DolphinTool
+{
+namespace
+{
+struct ShaderCorpus
+{
+  std::set<VertexShaderUid> vertex_shaders;
+  std::set<GeometryShaderUid> geometry_shaders;
+  std::set<PixelShaderUid> pixel_shaders;
+};
+
+// Collects the distinct shaders of the pipelines, the same way ShaderCache would look them up.
+ShaderCorpus
+BuildCorpus(const std::vector<VideoCommon::SerializedGXPipelineUid>& pipeline_uids,
+            APIType api_type, const ShaderHostConfig& host_config)
+{
+  ShaderCorpus corpus;
+  for (const VideoCommon::SerializedGXPipelineUid& uid : pipeline_uids)
+  {
+    corpus.vertex_shaders.insert(uid.vs_uid);
+
+    PixelShaderUid ps_uid = uid.ps_uid;
+    ClearUnusedPixelShaderUidBits(api_type, host_config, &ps_uid);
+    corpus.pixel_shaders.insert(ps_uid);
+
+    if (host_config.backend_geometry_shaders && !uid.gs_uid.GetUidData()->IsPassthrough())
+      corpus.geometry_shaders.insert(uid.gs_uid);
+  }
+  return corpus;
+}
+
+struct GenerationResult
+{
+  double seconds = 0.0;
+  u64 num_bytes = 0;
+};
+
+template <typename UidType, typename GenerateFunction>
+GenerationResult TimeGeneration(const std::set<UidType>& uids, u32 iterations,
+                                GenerateFunction generate)
+{
+  // Generate everything once first, so that the buffer has grown to fit the largest shader.
+  ShaderCode code;
+  for (const UidType& uid : uids)
+  {
+    code.Clear();
+    generate(code, uid);
+  }
+
+  GenerationResult result;
+  const auto start = std::chrono::steady_clock::now();
+  for (u32 i = 0; i < iterations; i++)
+  {
+    for (const UidType& uid : uids)
+    {
+      code.Clear();
+      generate(code, uid);
+      result.num_bytes += code.GetBuffer().size();
+    }
+  }
+  const auto end = std::chrono::steady_clock::now();
+  result.seconds = std::chrono::duration<double>(end - start).count();
+  return result;
+}
+
+void PrintResult(std::string_view stage, size_t num_shaders, u32 iterations,
+                 const GenerationResult& result)
+{
+  const double num_generated = static_cast<double>(num_shaders) * iterations;
+  const double microseconds_per_shader =
+      num_generated > 0 ? result.seconds * 1000000.0 / num_generated : 0.0;
+  const double mib_per_second =
+      result.seconds > 0 ? result.num_bytes / result.seconds / (1024.0 * 1024.0) : 0.0;
+  std::cout << fmt::format("{:<10} {:>6} shaders  {:>9.2f} us/shader  {:>8.1f} MiB/s", stage,
+                           num_shaders, microseconds_per_shader, mib_per_second)
+            << std::endl;
+}
+}  // namespace
+
+int ShaderGenCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: shadergen [options]...");
+
+  parser->add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, whose graphics settings and pipeline UID caches are used. Will be "
+            "automatically created if this option is not set.");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the pipeline UID cache FILE to generate shaders for, instead of "
+            "the game's one in the user folder.")
+      .metavar("FILE");
+
+  parser->add_option("-g", "--game_id")
+      .type("string")
+      .action("store")
+      .help("ID of the game whose settings and pipeline UID cache are used.")
+      .metavar("ID");
+
+  parser->add_option("-b", "--backend")
+      .type("string")
+      .action("store")
+      .help("Optional. Video backend to generate the shaders for. Defaults to the configured "
+            "backend.")
+      .metavar("NAME");
+
+  parser->add_option("-n", "--iterations")
+      .type("int")
+      .action("store")
+      .help("Optional. How many times to generate every shader. Defaults to 10.")
+      .metavar("COUNT");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // Validate options
+  const std::string game_id =
+      options.is_set("game_id") ? static_cast<const char*>(options.get("game_id")) : "";
+  if (game_id.empty() && !options.is_set("input"))
+  {
+    std::cerr << "Error: No game ID or input set" << std::endl;
+    return 1;
+  }
+
+  const int iterations =
+      options.is_set("iterations") ? static_cast<int>(options.get("iterations")) : 10;
+  if (iterations <= 0)
+  {
+    std::cerr << "Error: Invalid iteration count" << std::endl;
+    return 1;
+  }
+
+  InitGraphicsConfig(options);
+
+  const std::string input_file_path =
+      options.is_set("input") ? static_cast<const char*>(options.get("input")) :
+                                VideoCommon::ShaderCache::GetPipelineUIDCacheFilename(game_id);
+  std::vector<VideoCommon::SerializedGXPipelineUid> pipeline_uids;
+  File::IOFile input_file(input_file_path, "rb");
+  if (!input_file ||
+      !VideoCommon::ShaderCache::ReadPipelineUIDCache(input_file, &pipeline_uids))
+  {
+    std::cerr << "Error: Unable to read pipeline UID cache " << input_file_path << std::endl;
+    return 1;
+  }
+
+  const APIType api_type = g_ActiveConfig.backend_info.api_type;
+  const ShaderHostConfig host_config = ShaderHostConfig::GetCurrent();
+  const ShaderCorpus corpus = BuildCorpus(pipeline_uids, api_type, host_config);
+
+  std::cout << "Generating the shaders of " << pipeline_uids.size() << " pipelines "
+            << iterations << " times" << std::endl;
+
+  const u32 count = static_cast<u32>(iterations);
+  const GenerationResult vertex_result =
+      TimeGeneration(corpus.vertex_shaders, count, [&](ShaderCode& code, const auto& uid) {
+        GenerateVertexShaderCode(code, api_type, host_config, uid.GetUidData());
+      });
+  PrintResult("Vertex", corpus.vertex_shaders.size(), count, vertex_result);
+
+  const GenerationResult geometry_result =
+      TimeGeneration(corpus.geometry_shaders, count, [&](ShaderCode& code, const auto& uid) {
+        GenerateGeometryShaderCode(code, api_type, host_config, uid.GetUidData());
+      });
+  PrintResult("Geometry", corpus.geometry_shaders.size(), count, geometry_result);
+
+  const GenerationResult pixel_result =
+      TimeGeneration(corpus.pixel_shaders, count, [&](ShaderCode& code, const auto& uid) {
+        GeneratePixelShaderCode(code, api_type, host_config, uid.GetUidData());
+      });
+  PrintResult("Pixel", corpus.pixel_shaders.size(), count, pixel_result);
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,329 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ShaderUIDsCommand.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+#include <OptionParser.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/Swap.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "DolphinTool/GraphicsConfig.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/GXPipelineTypes.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/RenderState.h"
+#include "VideoCommon/ShaderCache.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace DolphinTool
+{
+namespace
+{
+using VideoCommon::SerializedGXPipelineUid;
+
+struct SerializedUidLess
+{
+  bool operator()(const SerializedGXPipelineUid& lhs, const SerializedGXPipelineUid& rhs) const
+  {
+    return std::memcmp(&lhs, &rhs, sizeof(lhs)) < 0;
+  }
+};
+
+using SerializedUidSet = std::set<SerializedGXPipelineUid, SerializedUidLess>;
+
+// Keeps bpmem and xfmem up to date the way the GPU thread would, and generates the pipeline UID
+// of every draw like VertexManagerBase::UpdatePipelineConfig does. Nothing is rendered, so register
+// writes have no side effects here.
+class UIDHarvester final : public OpcodeDecoder::Callback
+{
+public:
+  explicit UIDHarvester(FifoDataFile& file)
+  {
+    static_assert(sizeof(BPMemory) == FifoDataFile::BP_MEM_SIZE * sizeof(u32));
+    std::copy_n(file.GetBPMem(), FifoDataFile::BP_MEM_SIZE, reinterpret_cast<u32*>(&bpmem));
+    bpmem.bpMask = 0xFFFFFF;
+
+    u32* const xf_words = reinterpret_cast<u32*>(&xfmem);
+    std::copy_n(file.GetXFMem(), FifoDataFile::XF_MEM_SIZE, xf_words);
+    std::copy_n(file.GetXFRegs(), FifoDataFile::XF_REGS_SIZE, xf_words + XFMEM_REGISTERS_START);
+
+    const u32* const cp_regs = file.GetCPMem();
+    m_cp_state.LoadCPReg(VCD_LO, cp_regs[VCD_LO]);
+    m_cp_state.LoadCPReg(VCD_HI, cp_regs[VCD_HI]);
+    for (u8 i = 0; i < CP_NUM_VAT_REG; ++i)
+    {
+      m_cp_state.LoadCPReg(CP_VAT_REG_A + i, cp_regs[CP_VAT_REG_A + i]);
+      m_cp_state.LoadCPReg(CP_VAT_REG_B + i, cp_regs[CP_VAT_REG_B + i]);
+      m_cp_state.LoadCPReg(CP_VAT_REG_C + i, cp_regs[CP_VAT_REG_C + i]);
+    }
+
+    // Without a renderer to ask, whether the game has bounding box active is tracked here.
+    m_bbox_enabled = g_ActiveConfig.bBBoxEnable;
+    g_ActiveConfig.bBBoxEnable = false;
+  }
+
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data))
+  {
+    // Only the registers affect the UIDs, not the matrices or lights.
+    u32* const xf_words = reinterpret_cast<u32*>(&xfmem);
+    for (u32 i = 0; i < count; ++i)
+    {
+      const u32 reg = address + i;
+      if (reg >= XFMEM_REGISTERS_START && reg < XFMEM_REGISTERS_END)
+        xf_words[reg] = Common::swap32(data + i * sizeof(u32));
+    }
+  }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value)) { m_cp_state.LoadCPReg(command, value); }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    // Same masking as LoadBPReg.
+    u32& reg = reinterpret_cast<u32*>(&bpmem)[command];
+    reg = (reg & ~bpmem.bpMask) | (value & bpmem.bpMask);
+    if (command != BPMEM_BP_MASK)
+      bpmem.bpMask = 0xFFFFFF;
+
+    if (command == BPMEM_CLEARBBOX1 || command == BPMEM_CLEARBBOX2)
+      m_bbox_active = true;
+    else if (command == BPMEM_TRIGGER_EFB_COPY && bpmem.triggerEFBCopy.copy_to_xfb)
+      m_bbox_active = false;
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size)) {}
+  OPCODE_CALLBACK(void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat,
+                                          u32 vertex_size, u16 num_vertices,
+                                          const u8* vertex_data))
+  {
+    if (num_vertices == 0)
+      return;
+
+    // Culled triangles and quads never reach the backend.
+    if (bpmem.genMode.cullmode == CullMode::All &&
+        primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES)
+    {
+      return;
+    }
+
+    // This is an error in the command stream, which GetVertexShaderUid asserts on.
+    if (bpmem.genMode.numtexgens != xfmem.numTexGen.numTexGens ||
+        bpmem.genMode.numcolchans != xfmem.numChan.numColorChans)
+    {
+      m_num_invalid_draws++;
+      return;
+    }
+
+    const VertexLoaderBase* const loader = GetVertexLoader(vat);
+    VertexLoaderManager::g_current_components = loader->m_native_components;
+    const PrimitiveType primitive_type = GetPrimitiveType(primitive);
+
+    SerializedGXPipelineUid uid;
+    std::memset(reinterpret_cast<u8*>(&uid), 0, sizeof(uid));
+    uid.vertex_decl = loader->m_native_vtx_decl;
+    uid.vs_uid = GetVertexShaderUid();
+    uid.gs_uid = GetGeometryShaderUid(primitive_type);
+    uid.ps_uid = GetPixelShaderUid();
+    uid.ps_uid.GetUidData()->bounding_box = m_bbox_enabled && m_bbox_active;
+
+    RasterizationState rasterization_state = {};
+    rasterization_state.Generate(bpmem, primitive_type);
+    uid.rasterization_state_bits = rasterization_state.hex;
+    DepthState depth_state = {};
+    depth_state.Generate(bpmem);
+    uid.depth_state_bits = depth_state.hex;
+    BlendingState blending_state = {};
+    blending_state.Generate(bpmem);
+    uid.blending_state_bits = blending_state.hex;
+
+    if (m_known_uids.insert(uid).second)
+      m_uids.push_back(uid);
+  }
+  OPCODE_CALLBACK(void OnDisplayList(u32 address, u32 size))
+  {
+    // The FIFO recorder inlines display lists, so there shouldn't be any.
+    m_num_display_lists++;
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count)) {}
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data)) {}
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size)) {}
+  OPCODE_CALLBACK(CPState& GetCPState()) { return m_cp_state; }
+
+  // In the order they were first drawn with.
+  const std::vector<SerializedGXPipelineUid>& GetUIDs() const { return m_uids; }
+  u32 GetNumInvalidDraws() const { return m_num_invalid_draws; }
+  u32 GetNumDisplayLists() const { return m_num_display_lists; }
+
+private:
+  static PrimitiveType GetPrimitiveType(OpcodeDecoder::Primitive primitive)
+  {
+    // Same as VertexManagerBase::PrepareForAdditionalData.
+    switch (primitive)
+    {
+    case OpcodeDecoder::Primitive::GX_DRAW_LINES:
+    case OpcodeDecoder::Primitive::GX_DRAW_LINE_STRIP:
+      return PrimitiveType::Lines;
+    case OpcodeDecoder::Primitive::GX_DRAW_POINTS:
+      return PrimitiveType::Points;
+    default:
+      return g_ActiveConfig.backend_info.bSupportsPrimitiveRestart ? PrimitiveType::TriangleStrip :
+                                                                     PrimitiveType::Triangles;
+    }
+  }
+
+  const VertexLoaderBase* GetVertexLoader(u8 vat)
+  {
+    const VertexLoaderUID loader_uid(m_cp_state.vtx_desc, m_cp_state.vtx_attr[vat]);
+    std::unique_ptr<VertexLoaderBase>& loader = m_vertex_loaders[loader_uid];
+    if (!loader)
+      loader = VertexLoaderBase::CreateVertexLoader(m_cp_state.vtx_desc, m_cp_state.vtx_attr[vat]);
+    return loader.get();
+  }
+
+  CPState m_cp_state;
+  std::unordered_map<VertexLoaderUID, std::unique_ptr<VertexLoaderBase>> m_vertex_loaders;
+  bool m_bbox_enabled = false;
+  bool m_bbox_active = false;
+
+  SerializedUidSet m_known_uids;
+  std::vector<SerializedGXPipelineUid> m_uids;
+  u32 m_num_invalid_draws = 0;
+  u32 m_num_display_lists = 0;
+};
+}  // namespace
+
+int ShaderUIDsCommand::Main(const std::vector<std::string>& args)
+{
+  auto parser = std::make_unique<optparse::OptionParser>();
+
+  parser->usage("usage: shaderuids [options]...");
+
+  parser->add_option("-u", "--user")
+      .action("store")
+      .help("User folder path, whose graphics settings are used and whose pipeline UID cache is "
+            "updated. Will be automatically created if this option is not set.");
+
+  parser->add_option("-i", "--input")
+      .type("string")
+      .action("store")
+      .help("Path to FIFO log FILE.")
+      .metavar("FILE");
+
+  parser->add_option("-g", "--game_id")
+      .type("string")
+      .action("store")
+      .help("ID of the game the FIFO log was recorded from, which selects the game's settings and "
+            "its pipeline UID cache.")
+      .metavar("ID");
+
+  parser->add_option("-b", "--backend")
+      .type("string")
+      .action("store")
+      .help("Optional. Video backend to generate the UIDs for, as some depend on its features. "
+            "Defaults to the configured backend.")
+      .metavar("NAME");
+
+  parser->add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to the pipeline UID cache FILE to update, instead of the game's one in "
+            "the user folder.")
+      .metavar("FILE");
+
+  const optparse::Values& options = parser->parse_args(args);
+
+  // Validate options
+  const std::string input_file_path = static_cast<const char*>(options.get("input"));
+  if (input_file_path.empty())
+  {
+    std::cerr << "Error: No input set" << std::endl;
+    return 1;
+  }
+
+  const std::string game_id = static_cast<const char*>(options.get("game_id"));
+  if (game_id.empty())
+  {
+    std::cerr << "Error: No game ID set" << std::endl;
+    return 1;
+  }
+
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(input_file_path, false);
+  if (!file)
+  {
+    std::cerr << "Error: Unable to open FIFO log" << std::endl;
+    return 1;
+  }
+
+  // The UIDs depend on the graphics settings and the backend's features, so generate them with
+  // the same configuration the game will boot with.
+  InitGraphicsConfig(options);
+
+  UIDHarvester harvester(*file);
+  for (u32 frame = 0; frame < file->GetFrameCount(); ++frame)
+  {
+    const std::shared_ptr<const FifoFrameInfo> frame_info = file->GetFrame(frame);
+    const std::vector<u8>& data = frame_info->fifoData;
+    OpcodeDecoder::Run(data.data(), static_cast<u32>(data.size()), harvester);
+  }
+
+  if (harvester.GetNumInvalidDraws() != 0)
+  {
+    std::cerr << "Warning: Skipped " << harvester.GetNumInvalidDraws()
+              << " draws with mismatched texgen or color channel counts" << std::endl;
+  }
+  if (harvester.GetNumDisplayLists() != 0)
+  {
+    std::cerr << "Warning: Skipped " << harvester.GetNumDisplayLists()
+              << " display lists which weren't inlined when recording" << std::endl;
+  }
+
+  // Merge with the existing cache, keeping its order so that what the game drew first is still
+  // compiled first.
+  const std::string output_file_path =
+      options.is_set("output") ? static_cast<const char*>(options.get("output")) :
+                                 VideoCommon::ShaderCache::GetPipelineUIDCacheFilename(game_id);
+  std::vector<SerializedGXPipelineUid> uids;
+  {
+    File::IOFile existing_file(output_file_path, "rb");
+    if (existing_file && !VideoCommon::ShaderCache::ReadPipelineUIDCache(existing_file, &uids))
+      std::cerr << "Warning: Replacing invalid or outdated pipeline UID cache" << std::endl;
+  }
+
+  SerializedUidSet known_uids(uids.begin(), uids.end());
+  size_t num_new_uids = 0;
+  for (const SerializedGXPipelineUid& uid : harvester.GetUIDs())
+  {
+    if (known_uids.insert(uid).second)
+    {
+      uids.push_back(uid);
+      num_new_uids++;
+    }
+  }
+
+  File::CreateFullPath(output_file_path);
+  File::IOFile output_file(output_file_path, "wb");
+  if (!output_file || !VideoCommon::ShaderCache::WritePipelineUIDCacheHeader(output_file) ||
+      !output_file.WriteArray(uids.data(), uids.size()))
+  {
+    std::cerr << "Error: Unable to write " << output_file_path << std::endl;
+    return 1;
+  }
+
+  std::cout << "Found " << harvester.GetUIDs().size() << " pipelines in " << file->GetFrameCount()
+            << " frames, " << num_new_uids << " of them new" << std::endl;
+  std::cout << "Wrote " << uids.size() << " pipeline UIDs to " << output_file_path << std::endl;
+
+  return 0;
+}
+
+}  // namespace DolphinTool
@@ -0,0 +1,21 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "DolphinTool/Command.h"
+
+namespace DolphinTool
+{
+// Replays a FIFO log without rendering it, and adds the pipelines it draws with to a game's
+// pipeline UID cache, so that they are compiled when the game boots.
+class ShaderUIDsCommand final : public Command
+{
+public:
+  int Main(const std::vector<std::string>& args) override;
+};
+
+}  // namespace DolphinTool
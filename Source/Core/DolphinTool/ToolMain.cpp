@@ -10,12 +10,18 @@
 #include "Common/Version.h"
 #include "DolphinTool/Command.h"
 #include "DolphinTool/ConvertCommand.h"
+#include "DolphinTool/FifoBenchCommand.h"
+#include "DolphinTool/FifoConvertCommand.h"
+#include "DolphinTool/ShaderGenCommand.h"
+#include "DolphinTool/ShaderUIDsCommand.h"
 #include "DolphinTool/VerifyCommand.h"
 
 static int PrintUsage(int code)
 {
   std::cerr << "usage: dolphin-tool COMMAND -h" << std::endl << std::endl;
-  std::cerr << "commands supported: [convert, verify]" << std::endl;
+  std::cerr << "commands supported: [convert, verify, shaderuids, shadergen, fifobench, "
+               "fifoconvert]"
+            << std::endl;
 
   return code;
 }
@@ -38,6 +44,14 @@ int main(int argc, char* argv[])
     command = std::make_unique<DolphinTool::ConvertCommand>();
   else if (command_str == "verify")
     command = std::make_unique<DolphinTool::VerifyCommand>();
+  else if (command_str == "shaderuids")
+    command = std::make_unique<DolphinTool::ShaderUIDsCommand>();
+  else if (command_str == "shadergen")
+    command = std::make_unique<DolphinTool::ShaderGenCommand>();
+  else if (command_str == "fifobench")
+    command = std::make_unique<DolphinTool::FifoBenchCommand>();
+  else if (command_str == "fifoconvert")
+    command = std::make_unique<DolphinTool::FifoConvertCommand>();
   else
     return PrintUsage(1);
 
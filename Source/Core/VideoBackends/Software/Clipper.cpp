@@ -37,6 +37,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "VideoBackends/Software/Clipper.h"
 
 #include "Common/Assert.h"
+#include "Common/Intrinsics.h"
 
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Rasterizer.h"
@@ -73,9 +74,9 @@ enum
   CLIP_NEG_Z_BIT = 0x20
 };
 
-static inline int CalcClipMask(const OutputVertexData* v)
+u8 CalcClipMask(const OutputVertexData* v)
 {
-  int cmask = 0;
+  u8 cmask = 0;
   Vec4 pos = v->projectedPosition;
 
   if (pos.w - pos.x < 0)
@@ -99,6 +100,48 @@ static inline int CalcClipMask(const OutputVertexData* v)
   return cmask;
 }
 
+#if defined(_M_X86_64)
+// Returns the bit for each lane in which the comparison is true.
+static inline __m128i ClipBit(__m128 comparison, int bit)
+{
+  return _mm_and_si128(_mm_castps_si128(comparison), _mm_set1_epi32(bit));
+}
+#endif
+
+void CalcClipMasks(OutputVertexData* vertices, u32 count)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  const __m128 zero = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4)
+  {
+    OutputVertexData* v = vertices + i;
+    __m128 x = _mm_loadu_ps(&v[0].projectedPosition.x);
+    __m128 y = _mm_loadu_ps(&v[1].projectedPosition.x);
+    __m128 z = _mm_loadu_ps(&v[2].projectedPosition.x);
+    __m128 w = _mm_loadu_ps(&v[3].projectedPosition.x);
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+
+    // The same comparisons as CalcClipMask, for four vertices at once.
+    __m128i mask = ClipBit(_mm_cmplt_ps(_mm_sub_ps(w, x), zero), CLIP_POS_X_BIT);
+    mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_add_ps(x, w), zero), CLIP_NEG_X_BIT));
+    mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_sub_ps(w, y), zero), CLIP_POS_Y_BIT));
+    mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_add_ps(y, w), zero), CLIP_NEG_Y_BIT));
+    mask = _mm_or_si128(mask, ClipBit(_mm_cmpgt_ps(_mm_mul_ps(w, z), zero), CLIP_POS_Z_BIT));
+    mask = _mm_or_si128(mask, ClipBit(_mm_cmplt_ps(_mm_add_ps(z, w), zero), CLIP_NEG_Z_BIT));
+
+    alignas(16) s32 masks[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(masks), mask);
+    for (int j = 0; j < 4; j++)
+      v[j].clipMask = static_cast<u8>(masks[j]);
+  }
+#endif
+
+  for (; i < count; i++)
+    vertices[i].clipMask = CalcClipMask(&vertices[i]);
+}
+
 static inline void AddInterpolatedVertex(float t, int out, int in, int* numVertices)
 {
   Vertices[(*numVertices)++]->Lerp(t, Vertices[out], Vertices[in]);
@@ -190,9 +233,9 @@ static void ClipTriangle(int* indices, int* numIndices)
 {
   int mask = 0;
 
-  mask |= CalcClipMask(Vertices[0]);
-  mask |= CalcClipMask(Vertices[1]);
-  mask |= CalcClipMask(Vertices[2]);
+  mask |= Vertices[0]->clipMask;
+  mask |= Vertices[1]->clipMask;
+  mask |= Vertices[2]->clipMask;
 
   if (mask != 0)
   {
@@ -243,7 +286,7 @@ static void ClipLine(int* indices)
 
   for (int i = 0; i < 2; ++i)
   {
-    clip_mask[i] = CalcClipMask(Vertices[i]);
+    clip_mask[i] = Vertices[i]->clipMask;
     mask |= clip_mask[i];
   }
 
@@ -464,9 +507,9 @@ void ProcessPoint(OutputVertexData* center)
 bool CullTest(const OutputVertexData* v0, const OutputVertexData* v1, const OutputVertexData* v2,
               bool& backface)
 {
-  int mask = CalcClipMask(v0);
-  mask &= CalcClipMask(v1);
-  mask &= CalcClipMask(v2);
+  int mask = v0->clipMask;
+  mask &= v1->clipMask;
+  mask &= v2->clipMask;
 
   if (mask)
   {
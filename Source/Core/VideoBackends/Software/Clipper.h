@@ -3,12 +3,20 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
+
 struct OutputVertexData;
 
 namespace Clipper
 {
 void Init();
 
+// Computes the clip mask of the projected position of a vertex.
+u8 CalcClipMask(const OutputVertexData* v);
+
+// Sets clipMask of the given vertices, which has to happen before they are processed.
+void CalcClipMasks(OutputVertexData* vertices, u32 count);
+
 void ProcessTriangle(OutputVertexData* v0, OutputVertexData* v1, OutputVertexData* v2);
 
 void ProcessLine(OutputVertexData* v0, OutputVertexData* v1);
@@ -45,6 +45,9 @@ struct OutputVertexData
   std::array<Vec3, 3> normal{};
   std::array<std::array<u8, 4>, 2> color{};
   std::array<Vec3, 8> texCoords{};
+  // Which planes of the clip volume projectedPosition is outside of, see Clipper::CalcClipMasks.
+  // Only set for the vertices coming from the transform unit, not for clipped ones.
+  u8 clipMask = 0;
 
   void Lerp(float t, const OutputVertexData* a, const OutputVertexData* b)
   {
@@ -10,9 +10,13 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 
+// Triangles may be queued up and drawn on several threads. They are guaranteed to be drawn, and
+// their effects on the EFB, bounding box, perf queries and statistics visible, after Flush().
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+void Flush();
 
 void SetTevReg(int reg, int comp, s16 color);
 
@@ -9,6 +9,7 @@
 #include "Common/GL/GLUtil.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
+#include "Common/WindowSystemInfo.h"
 
 #include "VideoBackends/Software/SWTexture.h"
 
@@ -29,11 +30,26 @@ std::unique_ptr<SWOGLWindow> SWOGLWindow::Create(const WindowSystemInfo& wsi)
 
 bool SWOGLWindow::IsHeadless() const
 {
-  return m_gl_context->IsHeadless();
+  return !m_gl_context || m_gl_context->IsHeadless();
+}
+
+u32 SWOGLWindow::GetBackBufferWidth() const
+{
+  return m_gl_context ? m_gl_context->GetBackBufferWidth() : 0;
+}
+
+u32 SWOGLWindow::GetBackBufferHeight() const
+{
+  return m_gl_context ? m_gl_context->GetBackBufferHeight() : 0;
 }
 
 bool SWOGLWindow::Initialize(const WindowSystemInfo& wsi)
 {
+  // OpenGL is only used to show the image, so it isn't needed without a window. This lets the
+  // software renderer run where there is no GPU at all, e.g. when benchmarking it.
+  if (wsi.type == WindowSystemType::Headless)
+    return true;
+
   m_gl_context = GLContext::Create(wsi);
   if (!m_gl_context)
     return false;
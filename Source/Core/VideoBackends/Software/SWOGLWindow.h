@@ -17,8 +17,11 @@ class SWOGLWindow
 public:
   ~SWOGLWindow();
 
+  // There is no context when running headless.
   GLContext* GetContext() const { return m_gl_context.get(); }
   bool IsHeadless() const;
+  u32 GetBackBufferWidth() const;
+  u32 GetBackBufferHeight() const;
 
   // Image to show, will be swapped immediately
   void ShowImage(const AbstractTexture* image, const MathUtil::Rectangle<int>& xfb_region);
@@ -26,8 +26,8 @@
 namespace SW
 {
 SWRenderer::SWRenderer(std::unique_ptr<SWOGLWindow> window)
-    : ::Renderer(static_cast<int>(std::max(window->GetContext()->GetBackBufferWidth(), 1u)),
-                 static_cast<int>(std::max(window->GetContext()->GetBackBufferHeight(), 1u)), 1.0f,
+    : ::Renderer(static_cast<int>(std::max(window->GetBackBufferWidth(), 1u)),
+                 static_cast<int>(std::max(window->GetBackBufferHeight(), 1u)), 1.0f,
                  AbstractTextureFormat::RGBA8),
       m_window(std::move(window))
 {
@@ -64,6 +64,9 @@ void SWRenderer::BindBackbuffer(const ClearColor& clear_color)
     return;
 
   GLContext* context = m_window->GetContext();
+  if (!context)
+    return;
+
   context->Update();
   m_backbuffer_width = context->GetBackBufferWidth();
   m_backbuffer_height = context->GetBackBufferHeight();
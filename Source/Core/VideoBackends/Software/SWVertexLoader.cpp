@@ -3,6 +3,7 @@
 
 #include "VideoBackends/Software/SWVertexLoader.h"
 
+#include <algorithm>
 #include <cstddef>
 #include <limits>
 
@@ -10,11 +11,13 @@
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
 
+#include "VideoBackends/Software/Clipper.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
 #include "VideoBackends/Software/Rasterizer.h"
 #include "VideoBackends/Software/SWRenderer.h"
 #include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoBackends/Software/TransformUnit.h"
 
 #include "VideoCommon/CPMemory.h"
@@ -34,6 +37,7 @@ SWVertexLoader::~SWVertexLoader() = default;
 
 void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex)
 {
+  TextureSampler::BeginBatch();
   DebugUtil::OnObjectBegin();
 
   using OpcodeDecoder::Primitive;
@@ -69,33 +73,54 @@ void SWVertexLoader::DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_
     Rasterizer::SetTevReg(i, Tev::ALP_C, PixelShaderManager::constants.kcolors[i][3]);
   }
 
-  for (u32 i = 0; i < m_index_generator.GetIndexLen(); i++)
+  // The matrix indices are the same for the whole batch, so only the attributes need to be parsed
+  // for every vertex.
+  memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
+  SetFormat();
+
+  const PortableVertexDeclaration& vdec =
+      VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration();
+  const bool has_normals = (VertexLoaderManager::g_current_components & VB_HAS_NRM0) != 0;
+  const bool nbt = (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0;
+
+  const u32 num_vertices = m_index_generator.GetIndexLen();
+  for (u32 chunk_start = 0; chunk_start < num_vertices; chunk_start += VERTEX_CHUNK_SIZE)
   {
-    const u16 index = m_cpu_index_buffer[i];
-    memset(static_cast<void*>(&m_vertex), 0, sizeof(m_vertex));
-
-    // parse the videocommon format to our own struct format (m_vertex)
-    SetFormat();
-    ParseVertex(VertexLoaderManager::GetCurrentVertexFormat()->GetVertexDeclaration(), index);
-
-    // transform this vertex so that it can be used for rasterization (outVertex)
-    OutputVertexData* outVertex = m_setup_unit.GetVertex();
-    TransformUnit::TransformPosition(&m_vertex, outVertex);
-    outVertex->normal = {};
-    if (VertexLoaderManager::g_current_components & VB_HAS_NRM0)
+    const u32 chunk_size = std::min(num_vertices - chunk_start, VERTEX_CHUNK_SIZE);
+
+    // parse the videocommon format to our own struct format (m_input_vertices)
+    for (u32 i = 0; i < chunk_size; i++)
+    {
+      m_input_vertices[i] = m_vertex;
+      ParseVertex(vdec, m_cpu_index_buffer[chunk_start + i], &m_input_vertices[i]);
+      m_output_vertices[i] = {};
+    }
+
+    // transform the chunk so that it can be used for rasterization (m_output_vertices)
+    TransformUnit::TransformPositions(m_input_vertices.data(), m_output_vertices.data(),
+                                      chunk_size);
+    Clipper::CalcClipMasks(m_output_vertices.data(), chunk_size);
+    if (has_normals)
     {
-      TransformUnit::TransformNormal(
-          &m_vertex, (VertexLoaderManager::g_current_components & VB_HAS_NRM2) != 0, outVertex);
+      TransformUnit::TransformNormals(m_input_vertices.data(), nbt, m_output_vertices.data(),
+                                      chunk_size);
     }
-    TransformUnit::TransformColor(&m_vertex, outVertex);
-    TransformUnit::TransformTexCoord(&m_vertex, outVertex);
 
-    // assemble and rasterize the primitive
-    m_setup_unit.SetupVertex();
+    for (u32 i = 0; i < chunk_size; i++)
+    {
+      TransformUnit::TransformColor(&m_input_vertices[i], &m_output_vertices[i]);
+      TransformUnit::TransformTexCoord(&m_input_vertices[i], &m_output_vertices[i]);
+      *m_setup_unit.GetVertex() = m_output_vertices[i];
+
+      // assemble and rasterize the primitive
+      m_setup_unit.SetupVertex();
 
-    INCSTAT(g_stats.this_frame.num_vertices_loaded)
+      INCSTAT(g_stats.this_frame.num_vertices_loaded)
+    }
   }
 
+  Rasterizer::Flush();
+
   DebugUtil::OnObjectEnd();
 }
 
@@ -211,31 +236,32 @@ static void ParseColorAttributes(InputVertexData* dst, DataReader& src,
   }
 }
 
-void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index)
+void SWVertexLoader::ParseVertex(const PortableVertexDeclaration& vdec, int index,
+                                 InputVertexData* vertex)
 {
   DataReader src(m_cpu_vertex_buffer.data(),
                  m_cpu_vertex_buffer.data() + m_cpu_vertex_buffer.size());
   src.Skip(index * vdec.stride);
 
-  ReadVertexAttribute<float>(&m_vertex.position[0], src, vdec.position, 0, 3, false);
+  ReadVertexAttribute<float>(&vertex->position[0], src, vdec.position, 0, 3, false);
 
-  for (std::size_t i = 0; i < m_vertex.normal.size(); i++)
+  for (std::size_t i = 0; i < vertex->normal.size(); i++)
   {
-    ReadVertexAttribute<float>(&m_vertex.normal[i][0], src, vdec.normals[i], 0, 3, false);
+    ReadVertexAttribute<float>(&vertex->normal[i][0], src, vdec.normals[i], 0, 3, false);
   }
 
-  ParseColorAttributes(&m_vertex, src, vdec);
+  ParseColorAttributes(vertex, src, vdec);
 
-  for (std::size_t i = 0; i < m_vertex.texCoords.size(); i++)
+  for (std::size_t i = 0; i < vertex->texCoords.size(); i++)
   {
-    ReadVertexAttribute<float>(m_vertex.texCoords[i].data(), src, vdec.texcoords[i], 0, 2, false);
+    ReadVertexAttribute<float>(vertex->texCoords[i].data(), src, vdec.texcoords[i], 0, 2, false);
 
     // the texmtr is stored as third component of the texCoord
     if (vdec.texcoords[i].components >= 3)
     {
-      ReadVertexAttribute<u8>(&m_vertex.texMtx[i], src, vdec.texcoords[i], 2, 1, false);
+      ReadVertexAttribute<u8>(&vertex->texMtx[i], src, vdec.texcoords[i], 2, 1, false);
     }
   }
 
-  ReadVertexAttribute<u8>(&m_vertex.posMtx, src, vdec.posmtx, 0, 1, false);
+  ReadVertexAttribute<u8>(&vertex->posMtx, src, vdec.posmtx, 0, 1, false);
 }
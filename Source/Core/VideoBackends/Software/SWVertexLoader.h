@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -23,8 +24,13 @@ protected:
   void DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex) override;
 
   void SetFormat();
-  void ParseVertex(const PortableVertexDeclaration& vdec, int index);
+  void ParseVertex(const PortableVertexDeclaration& vdec, int index, InputVertexData* vertex);
+
+  // Vertices are transformed in chunks, so that the transform unit can work on several at once.
+  static constexpr u32 VERTEX_CHUNK_SIZE = 64;
 
   InputVertexData m_vertex{};
+  std::array<InputVertexData, VERTEX_CHUNK_SIZE> m_input_vertices{};
+  std::array<OutputVertexData, VERTEX_CHUNK_SIZE> m_output_vertices{};
   SetupUnit m_setup_unit;
 };
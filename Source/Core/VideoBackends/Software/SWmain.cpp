@@ -22,6 +22,7 @@
 #include "VideoBackends/Software/SWTexture.h"
 #include "VideoBackends/Software/SWVertexLoader.h"
 #include "VideoBackends/Software/TextureCache.h"
+#include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/TextureCacheBase.h"
@@ -133,6 +134,8 @@ void VideoSoftware::Shutdown()
   if (g_renderer)
     g_renderer->Shutdown();
 
+  Rasterizer::Shutdown();
+  TextureSampler::Shutdown();
   DebugUtil::Shutdown();
   g_texture_cache.reset();
   g_perf_query.reset();
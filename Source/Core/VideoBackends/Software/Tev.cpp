@@ -9,14 +9,13 @@
 
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "VideoBackends/Software/DebugUtil.h"
 #include "VideoBackends/Software/EfbInterface.h"
-#include "VideoBackends/Software/SWBoundingBox.h"
 #include "VideoBackends/Software/TextureSampler.h"
 
 #include "VideoCommon/PerfQueryBase.h"
 #include "VideoCommon/PixelShaderManager.h"
-#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
@@ -160,6 +159,36 @@ void Tev::Init()
   m_ScaleRShiftLUT[1] = 0;
   m_ScaleRShiftLUT[2] = 0;
   m_ScaleRShiftLUT[3] = 1;
+
+  // The same inputs for DrawQuad()
+  for (int i = 0; i < 9; i++)
+    std::fill(std::begin(m_QuadFixedConstants[i].lanes), std::end(m_QuadFixedConstants[i].lanes),
+              FixedConstants[i]);
+
+  for (int inp = BLU_INP; inp <= RED_INP; inp++)
+  {
+    const int comp = BLU_C + inp;
+    for (int reg = 0; reg < 4; reg++)
+    {
+      m_QuadColorInputLUT[reg * 2][inp] = &m_QuadReg[reg][comp];
+      m_QuadColorInputLUT[reg * 2 + 1][inp] = &m_QuadReg[reg][ALP_C];
+    }
+    m_QuadColorInputLUT[8][inp] = &m_QuadTexColor[comp];
+    m_QuadColorInputLUT[9][inp] = &m_QuadTexColor[ALP_C];
+    m_QuadColorInputLUT[10][inp] = &m_QuadRasColor[comp];
+    m_QuadColorInputLUT[11][inp] = &m_QuadRasColor[ALP_C];
+    m_QuadColorInputLUT[12][inp] = &m_QuadFixedConstants[8];
+    m_QuadColorInputLUT[13][inp] = &m_QuadFixedConstants[4];
+    m_QuadColorInputLUT[14][inp] = &m_QuadStageKonst[comp];
+    m_QuadColorInputLUT[15][inp] = &m_QuadFixedConstants[0];
+  }
+
+  for (int reg = 0; reg < 4; reg++)
+    m_QuadAlphaInputLUT[reg] = &m_QuadReg[reg][ALP_C];
+  m_QuadAlphaInputLUT[4] = &m_QuadTexColor[ALP_C];
+  m_QuadAlphaInputLUT[5] = &m_QuadRasColor[ALP_C];
+  m_QuadAlphaInputLUT[6] = &m_QuadStageKonst[ALP_C];
+  m_QuadAlphaInputLUT[7] = &m_QuadFixedConstants[0];
 }
 
 static inline s16 Clamp255(s16 in)
@@ -538,22 +567,8 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   }
 }
 
-void Tev::Draw()
+void Tev::SampleIndirectStages()
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
-
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
-
-  // initial color values
-  for (int i = 0; i < 4; i++)
-  {
-    Reg[i][RED_C] = PixelShaderManager::constants.colors[i][0];
-    Reg[i][GRN_C] = PixelShaderManager::constants.colors[i][1];
-    Reg[i][BLU_C] = PixelShaderManager::constants.colors[i][2];
-    Reg[i][ALP_C] = PixelShaderManager::constants.colors[i][3];
-  }
-
   for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
   {
     const int stageNum2 = stageNum >> 1;
@@ -587,59 +602,90 @@ void Tev::Draw()
     }
 #endif
   }
+}
 
-  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
-  {
-    const int stageNum2 = stageNum >> 1;
-    const int stageOdd = stageNum & 1;
-    const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
-    const TevKSel& kSel = bpmem.tevksel[stageNum2];
+// Samples the texture of a stage, and sets up its texture and rasterized colors.
+void Tev::SampleStage(unsigned int stageNum)
+{
+  const int stageOdd = stageNum & 1;
+  const TwoTevStageOrders& order = bpmem.tevorders[stageNum >> 1];
+  const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
 
-    // stage combiners
-    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
-    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
+  u32 texcoordSel = order.getTexCoord(stageOdd);
+  const u32 texmap = order.getTexMap(stageOdd);
 
-    u32 texcoordSel = order.getTexCoord(stageOdd);
-    const u32 texmap = order.getTexMap(stageOdd);
+  // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
+  // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
+  if (texcoordSel >= bpmem.genMode.numtexgens)
+    texcoordSel = 0;
 
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
+  Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
 
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
+  // sample texture
+  if (order.getEnable(stageOdd))
+  {
+    // RGBA
+    u8 texel[4];
 
-    // sample texture
-    if (order.getEnable(stageOdd))
+    if (bpmem.genMode.numtexgens > 0)
     {
-      // RGBA
-      u8 texel[4];
-
-      if (bpmem.genMode.numtexgens > 0)
-      {
-        TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
-      }
-      else
-      {
-        // It seems like the result is always black when no tex coords are enabled, but further
-        // hardware testing is needed.
-        std::memset(texel, 0, 4);
-      }
+      TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum], TextureLinear[stageNum],
+                             texmap, texel);
+    }
+    else
+    {
+      // It seems like the result is always black when no tex coords are enabled, but further
+      // hardware testing is needed.
+      std::memset(texel, 0, 4);
+    }
 
 #if ALLOW_TEV_DUMPS
-      if (g_ActiveConfig.bDumpTevTextureFetches)
-        DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
+    if (g_ActiveConfig.bDumpTevTextureFetches)
+      DebugUtil::DrawTempBuffer(texel, DIRECT_TFETCH + stageNum);
 #endif
 
-      int swaptable = ac.tswap * 2;
+    int swaptable = ac.tswap * 2;
 
-      TexColor[RED_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[GRN_C] = texel[bpmem.tevksel[swaptable].swap2];
-      swaptable++;
-      TexColor[BLU_C] = texel[bpmem.tevksel[swaptable].swap1];
-      TexColor[ALP_C] = texel[bpmem.tevksel[swaptable].swap2];
-    }
+    TexColor[RED_C] = texel[bpmem.tevksel[swaptable].swap1];
+    TexColor[GRN_C] = texel[bpmem.tevksel[swaptable].swap2];
+    swaptable++;
+    TexColor[BLU_C] = texel[bpmem.tevksel[swaptable].swap1];
+    TexColor[ALP_C] = texel[bpmem.tevksel[swaptable].swap2];
+  }
+
+  // set color
+  SetRasColor(order.getColorChan(stageOdd), ac.rswap * 2);
+}
+
+void Tev::Draw()
+{
+  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
+  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+
+  counters.tev_pixels_in++;
+
+  // initial color values
+  for (int i = 0; i < 4; i++)
+  {
+    Reg[i][RED_C] = PixelShaderManager::constants.colors[i][0];
+    Reg[i][GRN_C] = PixelShaderManager::constants.colors[i][1];
+    Reg[i][BLU_C] = PixelShaderManager::constants.colors[i][2];
+    Reg[i][ALP_C] = PixelShaderManager::constants.colors[i][3];
+  }
+
+  SampleIndirectStages();
+
+  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
+  {
+    const int stageNum2 = stageNum >> 1;
+    const int stageOdd = stageNum & 1;
+    const TevKSel& kSel = bpmem.tevksel[stageNum2];
+
+    // stage combiners
+    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
+    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
+
+    SampleStage(stageNum);
 
     // set konst for this stage
     const auto kc = u32(kSel.getKC(stageOdd));
@@ -649,9 +695,6 @@ void Tev::Draw()
     StageKonst[BLU_C] = *(m_KonstLUT[kc][BLU_C]);
     StageKonst[ALP_C] = *(m_KonstLUT[ka][ALP_C]);
 
-    // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap * 2);
-
     // combine inputs
     InputRegType inputs[4];
     for (int i = 0; i < 3; i++)
@@ -711,9 +754,37 @@ void Tev::Draw()
   u8 output[4] = {(u8)Reg[alpha_index][ALP_C], (u8)Reg[color_index][BLU_C],
                   (u8)Reg[color_index][GRN_C], (u8)Reg[color_index][RED_C]};
 
-  if (!TevAlphaTest(output[ALP_C]))
+  if (!OutputPixel(Position[0], Position[1], Position[2], TexColor, output))
     return;
 
+#if ALLOW_TEV_DUMPS
+  if (g_ActiveConfig.bDumpTevStages)
+  {
+    for (u32 i = 0; i < bpmem.genMode.numindstages; ++i)
+      DebugUtil::CopyTempBuffer(Position[0], Position[1], INDIRECT, i, "Indirect");
+    for (u32 i = 0; i <= bpmem.genMode.numtevstages; ++i)
+      DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT, i, "Stage");
+  }
+
+  if (g_ActiveConfig.bDumpTevTextureFetches)
+  {
+    for (u32 i = 0; i <= bpmem.genMode.numtevstages; ++i)
+    {
+      TwoTevStageOrders& order = bpmem.tevorders[i >> 1];
+      if (order.getEnable(i & 1))
+        DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT_TFETCH, i, "TFetch");
+    }
+  }
+#endif
+}
+
+// Runs the alpha test, z texture, fog and late depth test on the output of the last stage, and
+// blends it into the EFB. Returns whether the pixel was written.
+bool Tev::OutputPixel(s32 x, s32 y, s32 z, const s16 tex_color[4], u8 output[4])
+{
+  if (!TevAlphaTest(output[ALP_C]))
+    return false;
+
   // z texture
   if (bpmem.ztex2.op != ZTexOp::Disabled)
   {
@@ -721,22 +792,22 @@ void Tev::Draw()
     switch (bpmem.ztex2.type)
     {
     case ZTexFormat::U8:
-      ztex += TexColor[ALP_C];
+      ztex += tex_color[ALP_C];
       break;
     case ZTexFormat::U16:
-      ztex += TexColor[ALP_C] << 8 | TexColor[RED_C];
+      ztex += tex_color[ALP_C] << 8 | tex_color[RED_C];
       break;
     case ZTexFormat::U24:
-      ztex += TexColor[RED_C] << 16 | TexColor[GRN_C] << 8 | TexColor[BLU_C];
+      ztex += tex_color[RED_C] << 16 | tex_color[GRN_C] << 8 | tex_color[BLU_C];
       break;
     default:
       PanicAlertFmt("Invalid ztex format {}", bpmem.ztex2.type);
     }
 
     if (bpmem.ztex2.op == ZTexOp::Add)
-      ztex += Position[2];
+      ztex += z;
 
-    Position[2] = ztex & 0x00ffffff;
+    z = ztex & 0x00ffffff;
   }
 
   // fog
@@ -748,7 +819,7 @@ void Tev::Draw()
     {
       // perspective
       // ze = A/(B - (Zs >> B_SHF))
-      const s32 denom = bpmem.fog.b_magnitude - (Position[2] >> bpmem.fog.b_shift);
+      const s32 denom = bpmem.fog.b_magnitude - (z >> bpmem.fog.b_shift);
       // in addition downscale magnitude and zs to 0.24 bits
       ze = (bpmem.fog.GetA() * 16777215.0f) / static_cast<float>(denom);
     }
@@ -757,7 +828,7 @@ void Tev::Draw()
       // orthographic
       // ze = a*Zs
       // in addition downscale zs to 0.24 bits
-      ze = bpmem.fog.GetA() * (static_cast<float>(Position[2]) / 16777215.0f);
+      ze = bpmem.fog.GetA() * (static_cast<float>(z) / 16777215.0f);
     }
 
     if (bpmem.fogRange.Base.Enabled)
@@ -769,7 +840,7 @@ void Tev::Draw()
 
       // First, calculate the offset from the viewport center (normalized to 0..1)
       const float offset =
-          (Position[0] - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
+          (x - (static_cast<s32>(bpmem.fogRange.Base.Center.Value()) - 342)) /
           static_cast<float>(xfmem.viewport.wd);
 
       // Based on that, choose the index such that points which are far away from the z-axis use the
@@ -831,43 +902,415 @@ void Tev::Draw()
   if (late_ztest && bpmem.zmode.testenable)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    counters.perf_pixels[PQ_ZCOMP_INPUT]++;
 
-    if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
-      return;
+    if (!EfbInterface::ZCompare(x, y, z))
+      return false;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    counters.perf_pixels[PQ_ZCOMP_OUTPUT]++;
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  counters.bbox_left = std::min(counters.bbox_left, static_cast<u16>(x & ~1));
+  counters.bbox_right = std::max(counters.bbox_right, static_cast<u16>(x | 1));
+  counters.bbox_top = std::min(counters.bbox_top, static_cast<u16>(y & ~1));
+  counters.bbox_bottom = std::max(counters.bbox_bottom, static_cast<u16>(y | 1));
 
-#if ALLOW_TEV_DUMPS
-  if (g_ActiveConfig.bDumpTevStages)
+  counters.tev_pixels_out++;
+  counters.perf_pixels[PQ_BLEND_INPUT]++;
+
+  EfbInterface::BlendTev(x, y, output);
+  return true;
+}
+
+// DrawQuad() evaluates the TEV stages of the four pixels of a quad at once, on vectors holding one
+// component of each of them. Inputs are cut down to the bit widths of InputRegType on loading, so
+// that the results are the same as those of the functions above.
+#if defined(_M_X86_64)
+using QuadVector = __m128i;
+
+static inline QuadVector QuadLoad(const s32* lanes)
+{
+  return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+}
+
+static inline void QuadStore(s32* lanes, QuadVector value)
+{
+  _mm_store_si128(reinterpret_cast<__m128i*>(lanes), value);
+}
+
+static inline QuadVector QuadSet(s32 value)
+{
+  return _mm_set1_epi32(value);
+}
+
+static inline QuadVector QuadAdd(QuadVector a, QuadVector b)
+{
+  return _mm_add_epi32(a, b);
+}
+
+static inline QuadVector QuadSub(QuadVector a, QuadVector b)
+{
+  return _mm_sub_epi32(a, b);
+}
+
+static inline QuadVector QuadShiftLeft(QuadVector value, int shift)
+{
+  return _mm_sll_epi32(value, _mm_cvtsi32_si128(shift));
+}
+
+// Arithmetic shift, like >> on s32
+static inline QuadVector QuadShiftRight(QuadVector value, int shift)
+{
+  return _mm_sra_epi32(value, _mm_cvtsi32_si128(shift));
+}
+
+static inline QuadVector QuadAnd(QuadVector a, QuadVector b)
+{
+  return _mm_and_si128(a, b);
+}
+
+static inline QuadVector QuadOr(QuadVector a, QuadVector b)
+{
+  return _mm_or_si128(a, b);
+}
+
+// Only for values in [0, 32767], which fit into the low half of each lane
+static inline QuadVector QuadMul16(QuadVector a, QuadVector b)
+{
+  return _mm_madd_epi16(a, b);
+}
+
+// The comparisons return all bits set in the lanes where they are true
+static inline QuadVector QuadGreater(QuadVector a, QuadVector b)
+{
+  return _mm_cmpgt_epi32(a, b);
+}
+
+static inline QuadVector QuadEqual(QuadVector a, QuadVector b)
+{
+  return _mm_cmpeq_epi32(a, b);
+}
+
+static inline QuadVector QuadClamp(QuadVector value, s32 min, s32 max)
+{
+  const __m128i min_vector = _mm_set1_epi32(min);
+  const __m128i max_vector = _mm_set1_epi32(max);
+  const __m128i above = _mm_cmpgt_epi32(value, max_vector);
+  value = _mm_or_si128(_mm_and_si128(above, max_vector), _mm_andnot_si128(above, value));
+  const __m128i below = _mm_cmpgt_epi32(min_vector, value);
+  return _mm_or_si128(_mm_and_si128(below, min_vector), _mm_andnot_si128(below, value));
+}
+#else
+struct QuadVector
+{
+  s32 lanes[4];
+};
+
+template <typename Func>
+static inline QuadVector QuadMap(QuadVector a, QuadVector b, Func func)
+{
+  QuadVector result;
+  for (int i = 0; i < 4; i++)
+    result.lanes[i] = func(a.lanes[i], b.lanes[i]);
+  return result;
+}
+
+static inline QuadVector QuadLoad(const s32* lanes)
+{
+  QuadVector result;
+  std::copy_n(lanes, 4, result.lanes);
+  return result;
+}
+
+static inline void QuadStore(s32* lanes, QuadVector value)
+{
+  std::copy_n(value.lanes, 4, lanes);
+}
+
+static inline QuadVector QuadSet(s32 value)
+{
+  return {{value, value, value, value}};
+}
+
+static inline QuadVector QuadAdd(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x + y; });
+}
+
+static inline QuadVector QuadSub(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x - y; });
+}
+
+static inline QuadVector QuadShiftLeft(QuadVector value, int shift)
+{
+  return QuadMap(value, value, [shift](s32 x, s32) { return s32(u32(x) << shift); });
+}
+
+// Arithmetic shift, like >> on s32
+static inline QuadVector QuadShiftRight(QuadVector value, int shift)
+{
+  return QuadMap(value, value, [shift](s32 x, s32) { return x >> shift; });
+}
+
+static inline QuadVector QuadAnd(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x & y; });
+}
+
+static inline QuadVector QuadOr(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x | y; });
+}
+
+// Only for values in [0, 32767], like the SSE2 version
+static inline QuadVector QuadMul16(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x * y; });
+}
+
+// The comparisons return all bits set in the lanes where they are true
+static inline QuadVector QuadGreater(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x > y ? -1 : 0; });
+}
+
+static inline QuadVector QuadEqual(QuadVector a, QuadVector b)
+{
+  return QuadMap(a, b, [](s32 x, s32 y) { return x == y ? -1 : 0; });
+}
+
+static inline QuadVector QuadClamp(QuadVector value, s32 min, s32 max)
+{
+  return QuadMap(value, value, [min, max](s32 x, s32) { return std::clamp(x, min, max); });
+}
+#endif
+
+namespace
+{
+struct QuadInputs
+{
+  QuadVector a;
+  QuadVector b;
+  QuadVector c;
+  QuadVector d;
+};
+}  // namespace
+
+static inline QuadInputs QuadLoadInputs(const s32* a, const s32* b, const s32* c, const s32* d)
+{
+  const QuadVector mask = QuadSet(0xff);
+  return {QuadAnd(QuadLoad(a), mask), QuadAnd(QuadLoad(b), mask), QuadAnd(QuadLoad(c), mask),
+          QuadShiftRight(QuadShiftLeft(QuadLoad(d), 21), 21)};
+}
+
+// See Tev::DrawColorRegular
+static inline QuadVector QuadColorRegular(const QuadInputs& input, int lshift, int rshift,
+                                          s32 bias, s32 round, bool sub)
+{
+  const QuadVector c = QuadAdd(input.c, QuadShiftRight(input.c, 7));
+
+  QuadVector temp = QuadAdd(QuadMul16(input.a, QuadSub(QuadSet(256), c)), QuadMul16(input.b, c));
+  temp = QuadShiftLeft(temp, lshift);
+  temp = QuadAdd(temp, QuadSet(round));
+  temp = QuadShiftRight(temp, 8);
+  temp = sub ? QuadSub(QuadSet(0), temp) : temp;
+
+  const QuadVector result = QuadAdd(QuadShiftLeft(QuadAdd(input.d, QuadSet(bias)), lshift), temp);
+  return QuadShiftRight(result, rshift);
+}
+
+// See Tev::DrawAlphaRegular, which negates before shifting
+static inline QuadVector QuadAlphaRegular(const QuadInputs& input, int lshift, int rshift,
+                                          s32 bias, s32 round, bool sub)
+{
+  const QuadVector c = QuadAdd(input.c, QuadShiftRight(input.c, 7));
+
+  QuadVector temp = QuadAdd(QuadMul16(input.a, QuadSub(QuadSet(256), c)), QuadMul16(input.b, c));
+  temp = QuadShiftLeft(temp, lshift);
+  temp = QuadAdd(temp, QuadSet(round));
+  temp = QuadShiftRight(sub ? QuadSub(QuadSet(0), temp) : temp, 8);
+
+  const QuadVector result = QuadAdd(QuadShiftLeft(QuadAdd(input.d, QuadSet(bias)), lshift), temp);
+  return QuadShiftRight(result, rshift);
+}
+
+// See Tev::DrawColorCompare and Tev::DrawAlphaCompare
+static inline QuadVector QuadCompare(TevCompareMode mode, TevComparison comparison,
+                                     const QuadInputs inputs[4], int comp)
+{
+  // RGB8 and A8 compare each component on its own
+  QuadVector a = inputs[comp].a;
+  QuadVector b = inputs[comp].b;
+
+  switch (mode)
   {
-    for (u32 i = 0; i < bpmem.genMode.numindstages; ++i)
-      DebugUtil::CopyTempBuffer(Position[0], Position[1], INDIRECT, i, "Indirect");
-    for (u32 i = 0; i <= bpmem.genMode.numtevstages; ++i)
-      DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT, i, "Stage");
+  case TevCompareMode::R8:
+    a = inputs[Tev::RED_C].a;
+    b = inputs[Tev::RED_C].b;
+    break;
+
+  case TevCompareMode::GR16:
+    a = QuadOr(QuadShiftLeft(inputs[Tev::GRN_C].a, 8), inputs[Tev::RED_C].a);
+    b = QuadOr(QuadShiftLeft(inputs[Tev::GRN_C].b, 8), inputs[Tev::RED_C].b);
+    break;
+
+  case TevCompareMode::BGR24:
+    a = QuadOr(QuadOr(QuadShiftLeft(inputs[Tev::BLU_C].a, 16),
+                      QuadShiftLeft(inputs[Tev::GRN_C].a, 8)),
+               inputs[Tev::RED_C].a);
+    b = QuadOr(QuadOr(QuadShiftLeft(inputs[Tev::BLU_C].b, 16),
+                      QuadShiftLeft(inputs[Tev::GRN_C].b, 8)),
+               inputs[Tev::RED_C].b);
+    break;
+
+  default:
+    break;
   }
 
-  if (g_ActiveConfig.bDumpTevTextureFetches)
+  const QuadVector passed = comparison == TevComparison::GT ? QuadGreater(a, b) : QuadEqual(a, b);
+  return QuadAdd(inputs[comp].d, QuadAnd(passed, inputs[comp].c));
+}
+
+void Tev::AddQuadPixel()
+{
+  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
+  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
+  ASSERT(m_QuadSize < 4);
+
+  counters.tev_pixels_in++;
+
+  const u32 lane = m_QuadSize++;
+  std::copy_n(Position, 3, m_QuadPosition[lane]);
+
+  // Textures are sampled one pixel after the other, as Draw() does it, so the indirect and texture
+  // state left behind by a pixel is seen by the next one in the same way.
+  SampleIndirectStages();
+
+  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
   {
-    for (u32 i = 0; i <= bpmem.genMode.numtevstages; ++i)
+    SampleStage(stageNum);
+
+    QuadStageInputs& stage = m_QuadStages[stageNum];
+    for (int comp = 0; comp < 4; comp++)
     {
-      TwoTevStageOrders& order = bpmem.tevorders[i >> 1];
-      if (order.getEnable(i & 1))
-        DebugUtil::CopyTempBuffer(Position[0], Position[1], DIRECT_TFETCH, i, "TFetch");
+      stage.TexColor[comp].lanes[lane] = TexColor[comp];
+      stage.RasColor[comp].lanes[lane] = RasColor[comp];
     }
   }
-#endif
+}
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+void Tev::DrawQuadStage(unsigned int stageNum)
+{
+  const int stageOdd = stageNum & 1;
+  const TevKSel& kSel = bpmem.tevksel[stageNum >> 1];
+  const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
+  const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
+
+  const QuadStageInputs& stage = m_QuadStages[stageNum];
+  std::copy(std::begin(stage.TexColor), std::end(stage.TexColor), m_QuadTexColor);
+  std::copy(std::begin(stage.RasColor), std::end(stage.RasColor), m_QuadRasColor);
+
+  // set konst for this stage
+  const auto kc = u32(kSel.getKC(stageOdd));
+  const auto ka = u32(kSel.getKA(stageOdd));
+  QuadStore(m_QuadStageKonst[RED_C].lanes, QuadSet(*(m_KonstLUT[kc][RED_C])));
+  QuadStore(m_QuadStageKonst[GRN_C].lanes, QuadSet(*(m_KonstLUT[kc][GRN_C])));
+  QuadStore(m_QuadStageKonst[BLU_C].lanes, QuadSet(*(m_KonstLUT[kc][BLU_C])));
+  QuadStore(m_QuadStageKonst[ALP_C].lanes, QuadSet(*(m_KonstLUT[ka][ALP_C])));
+
+  // combine inputs
+  QuadInputs inputs[4];
+  for (int i = 0; i < 3; i++)
+  {
+    inputs[BLU_C + i] = QuadLoadInputs(m_QuadColorInputLUT[u32(cc.a.Value())][i]->lanes,
+                                       m_QuadColorInputLUT[u32(cc.b.Value())][i]->lanes,
+                                       m_QuadColorInputLUT[u32(cc.c.Value())][i]->lanes,
+                                       m_QuadColorInputLUT[u32(cc.d.Value())][i]->lanes);
+  }
+  inputs[ALP_C] = QuadLoadInputs(m_QuadAlphaInputLUT[u32(ac.a.Value())]->lanes,
+                                 m_QuadAlphaInputLUT[u32(ac.b.Value())]->lanes,
+                                 m_QuadAlphaInputLUT[u32(ac.c.Value())]->lanes,
+                                 m_QuadAlphaInputLUT[u32(ac.d.Value())]->lanes);
+
+  // The results always fit into the s16 registers of Draw(), so they are only clamped here.
+  const s32 color_min = cc.clamp ? 0 : -1024;
+  const s32 color_max = cc.clamp ? 255 : 1023;
+  for (int i = BLU_C; i <= RED_C; i++)
+  {
+    QuadVector result;
+    if (cc.bias != TevBias::Compare)
+    {
+      const u32 scale = u32(cc.scale.Value());
+      const s32 round = (cc.scale == TevScale::Divide2) ? 0 : (cc.op == TevOp::Sub) ? 127 : 128;
+      result = QuadColorRegular(inputs[i], m_ScaleLShiftLUT[scale], m_ScaleRShiftLUT[scale],
+                                m_BiasLUT[u32(cc.bias.Value())], round, cc.op == TevOp::Sub);
+    }
+    else
+    {
+      result = QuadCompare(cc.compare_mode, cc.comparison, inputs, i);
+    }
+
+    QuadStore(m_QuadReg[u32(cc.dest.Value())][i].lanes, QuadClamp(result, color_min, color_max));
+  }
+
+  QuadVector alpha;
+  if (ac.bias != TevBias::Compare)
+  {
+    const u32 scale = u32(ac.scale.Value());
+    const s32 round = (ac.scale != TevScale::Divide2) ? 0 : (ac.op == TevOp::Sub) ? 127 : 128;
+    alpha = QuadAlphaRegular(inputs[ALP_C], m_ScaleLShiftLUT[scale], m_ScaleRShiftLUT[scale],
+                             m_BiasLUT[u32(ac.bias.Value())], round, ac.op == TevOp::Sub);
+  }
+  else
+  {
+    alpha = QuadCompare(ac.compare_mode, ac.comparison, inputs, ALP_C);
+  }
+
+  const s32 alpha_min = ac.clamp ? 0 : -1024;
+  const s32 alpha_max = ac.clamp ? 255 : 1023;
+  QuadStore(m_QuadReg[u32(ac.dest.Value())][ALP_C].lanes, QuadClamp(alpha, alpha_min, alpha_max));
+}
+
+void Tev::DrawQuad()
+{
+  if (m_QuadSize == 0)
+    return;
+
+  // initial color values
+  for (int i = 0; i < 4; i++)
+  {
+    QuadStore(m_QuadReg[i][RED_C].lanes, QuadSet(PixelShaderManager::constants.colors[i][0]));
+    QuadStore(m_QuadReg[i][GRN_C].lanes, QuadSet(PixelShaderManager::constants.colors[i][1]));
+    QuadStore(m_QuadReg[i][BLU_C].lanes, QuadSet(PixelShaderManager::constants.colors[i][2]));
+    QuadStore(m_QuadReg[i][ALP_C].lanes, QuadSet(PixelShaderManager::constants.colors[i][3]));
+  }
+
+  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
+    DrawQuadStage(stageNum);
+
+  // the results of the last tev stage are put onto the screen, as in Draw()
+  const u32 color_index = u32(bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest.Value());
+  const u32 alpha_index = u32(bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest.Value());
+  const QuadStageInputs& last_stage = m_QuadStages[bpmem.genMode.numtevstages];
+
+  for (u32 lane = 0; lane < m_QuadSize; lane++)
+  {
+    u8 output[4] = {(u8)m_QuadReg[alpha_index][ALP_C].lanes[lane],
+                    (u8)m_QuadReg[color_index][BLU_C].lanes[lane],
+                    (u8)m_QuadReg[color_index][GRN_C].lanes[lane],
+                    (u8)m_QuadReg[color_index][RED_C].lanes[lane]};
+    const s16 tex_color[4] = {
+        s16(last_stage.TexColor[ALP_C].lanes[lane]), s16(last_stage.TexColor[BLU_C].lanes[lane]),
+        s16(last_stage.TexColor[GRN_C].lanes[lane]), s16(last_stage.TexColor[RED_C].lanes[lane])};
+
+    const s32* position = m_QuadPosition[lane];
+    OutputPixel(position[0], position[1], position[2], tex_color, output);
+  }
 
-  EfbInterface::BlendTev(Position[0], Position[1], output);
+  m_QuadSize = 0;
 }
 
 void Tev::SetRegColor(int reg, int comp, s16 color)
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <array>
+
+#include "Common/CommonTypes.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
@@ -56,6 +60,33 @@ class Tev
     INDIRECT = 32
   };
 
+  // One component of the pixels of a quad, see DrawQuad().
+  struct alignas(16) QuadComponent
+  {
+    s32 lanes[4];
+  };
+
+  // The texture and rasterized colors of a stage, for each pixel of the quad.
+  struct QuadStageInputs
+  {
+    QuadComponent TexColor[4];
+    QuadComponent RasColor[4];
+  };
+
+  QuadComponent m_QuadReg[4][4]{};
+  QuadComponent m_QuadTexColor[4]{};
+  QuadComponent m_QuadRasColor[4]{};
+  QuadComponent m_QuadStageKonst[4]{};
+  QuadComponent m_QuadFixedConstants[9]{};
+  std::array<QuadStageInputs, 16> m_QuadStages{};
+  s32 m_QuadPosition[4][3]{};
+  u32 m_QuadSize = 0;
+
+  const QuadComponent* m_QuadColorInputLUT[16][3];
+  const QuadComponent* m_QuadAlphaInputLUT[8];
+
+  void SampleIndirectStages();
+  void SampleStage(unsigned int stageNum);
   void SetRasColor(RasColorChan colorChan, int swaptable);
 
   void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
@@ -65,7 +96,24 @@ class Tev
 
   void Indirect(unsigned int stageNum, s32 s, s32 t);
 
+  void DrawQuadStage(unsigned int stageNum);
+  bool OutputPixel(s32 x, s32 y, s32 z, const s16 tex_color[4], u8 output[4]);
+
 public:
+  // Effects of drawn pixels on state that is shared by all instances. They are collected here and
+  // applied by the rasterizer, so that several instances can draw at the same time.
+  struct Counters
+  {
+    u32 rasterized_pixels = 0;
+    u32 tev_pixels_in = 0;
+    u32 tev_pixels_out = 0;
+    std::array<u32, PQ_NUM_MEMBERS> perf_pixels{};
+    u16 bbox_left = 0xffff;
+    u16 bbox_right = 0;
+    u16 bbox_top = 0xffff;
+    u16 bbox_bottom = 0;
+  };
+
   s32 Position[3];
   u8 Color[2][4];  // must be RGBA for correct swap table ordering
   TextureCoordinateType Uv[8];
@@ -73,6 +121,7 @@ public:
   bool IndirectLinear[4];
   s32 TextureLod[16];
   bool TextureLinear[16];
+  Counters counters;
 
   enum
   {
@@ -86,5 +135,11 @@ public:
 
   void Draw();
 
+  // Draws the pixels of a 2x2 block together, with the same results as drawing them one by one.
+  // The inputs of each pixel are set up as for Draw() and handed over with AddQuadPixel(), which
+  // samples its textures. DrawQuad() then evaluates the TEV stages of all of them at once.
+  void AddQuadPixel();
+  void DrawQuad();
+
   void SetRegColor(int reg, int comp, s16 color);
 };
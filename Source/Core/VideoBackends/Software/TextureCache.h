@@ -3,6 +3,7 @@
 #include <memory>
 #include "VideoBackends/Software/SWTexture.h"
 #include "VideoBackends/Software/TextureEncoder.h"
+#include "VideoBackends/Software/TextureSampler.h"
 #include "VideoCommon/TextureCacheBase.h"
 
 namespace SW
@@ -18,6 +19,7 @@ protected:
   {
     TextureEncoder::Encode(dst, params, native_width, bytes_per_row, num_blocks_y, memory_stride,
                            src_rect, scale_by_half, y_scale, gamma);
+    TextureSampler::Invalidate();
   }
   void CopyEFBToCacheEntry(TCacheEntry* entry, bool is_depth_copy,
                            const MathUtil::Rectangle<int>& src_rect, bool scale_by_half,
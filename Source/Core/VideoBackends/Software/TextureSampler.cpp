@@ -5,18 +5,269 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+#include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Core/HW/Memmap.h"
 
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureDecoder.h"
 
 #define ALLOW_MIPMAP 1
 
 namespace TextureSampler
 {
+// Once the decoded textures take up more than this, the ones which have not been used for the
+// longest time are thrown away.
+constexpr size_t DECODED_TEXTURE_CACHE_SIZE = 64 * 1024 * 1024;
+
+namespace
+{
+// Identifies a texture (or one of its mip levels) by where and how it is stored.
+struct TextureKey
+{
+  const u8* src;
+  const u8* src_odd;  // Second half of RGBA8 textures in TMEM
+  const u8* tlut;
+  TextureFormat format;
+  TLUTFormat tlut_format;
+  int width_minus_1;
+  int height_minus_1;
+
+  bool operator==(const TextureKey& other) const
+  {
+    return src == other.src && src_odd == other.src_odd && tlut == other.tlut &&
+           format == other.format && tlut_format == other.tlut_format &&
+           width_minus_1 == other.width_minus_1 && height_minus_1 == other.height_minus_1;
+  }
+};
+
+struct DecodedTexture
+{
+  TextureKey key;
+  u64 hash;
+  u64 last_used_batch;
+  u64 validated_generation;
+
+  // Texels in the same RGBA byte order as TexDecoder_DecodeTexel writes them, in rows of stride
+  // texels. The texture is decoded with its size rounded up to whole blocks.
+  std::vector<u32> texels;
+  int stride;
+};
+
+// Within a batch, neither TMEM nor the texture state can change.
+u64 s_batch = 1;
+
+// The textures are checked against their source once per generation. A new generation starts with
+// the first batch after TMEM was invalidated or loaded, or RAM was written by an EFB copy. Like on
+// the console, textures in RAM which are changed by the CPU are only seen after the game
+// invalidated the texture cache, or at the latest after the next EFB or XFB copy.
+u64 s_generation = 1;
+u32 s_tmem_invalidation_count = 0;
+bool s_invalidated = false;
+
+std::mutex s_decoded_textures_lock;
+std::vector<std::unique_ptr<DecodedTexture>> s_decoded_textures;
+size_t s_decoded_textures_size = 0;
+
+// Recently used textures of the thread, so that it doesn't have to take the lock for every sample.
+struct RecentTexture
+{
+  u64 batch;
+  const DecodedTexture* texture;
+};
+constexpr size_t NUM_RECENT_TEXTURES = 8;
+thread_local RecentTexture s_recent_textures[NUM_RECENT_TEXTURES];
+thread_local size_t s_next_recent_texture = 0;
+}  // Anonymous namespace
+
+static bool IsInEmulatedMemory(const u8* ptr, size_t size)
+{
+  const auto contains = [ptr, size](const u8* base, size_t base_size) {
+    return base && ptr >= base && ptr <= base + base_size && size <= base_size - (ptr - base);
+  };
+  return contains(texMem, TMEM_SIZE) || contains(Memory::m_pRAM, Memory::GetRamSizeReal()) ||
+         contains(Memory::m_pEXRAM, Memory::GetExRamSizeReal());
+}
+
+static u64 HashTextureSource(const TextureKey& key, u32 src_size)
+{
+  u64 hash = Common::GetHash64(key.src, src_size, 0);
+  if (key.src_odd)
+    hash ^= Common::GetHash64(key.src_odd, src_size, 0) * 31;
+  if (key.tlut)
+    hash ^= Common::GetHash64(key.tlut, TexDecoder_GetPaletteSize(key.format), 0) * 17;
+  return hash;
+}
+
+static void EvictDecodedTextures()
+{
+  if (s_decoded_textures_size <= DECODED_TEXTURE_CACHE_SIZE)
+    return;
+
+  std::sort(s_decoded_textures.begin(), s_decoded_textures.end(),
+            [](const auto& a, const auto& b) { return a->last_used_batch > b->last_used_batch; });
+  while (s_decoded_textures_size > DECODED_TEXTURE_CACHE_SIZE / 2)
+  {
+    s_decoded_textures_size -= s_decoded_textures.back()->texels.size() * sizeof(u32);
+    s_decoded_textures.pop_back();
+  }
+}
+
+void BeginBatch()
+{
+  std::lock_guard lk(s_decoded_textures_lock);
+  s_batch++;
+
+  const u32 tmem_invalidation_count = TMEM::GetInvalidationCount();
+  if (s_invalidated || tmem_invalidation_count != s_tmem_invalidation_count)
+  {
+    s_generation++;
+    s_tmem_invalidation_count = tmem_invalidation_count;
+    s_invalidated = false;
+  }
+
+  EvictDecodedTextures();
+}
+
+void Invalidate()
+{
+  std::lock_guard lk(s_decoded_textures_lock);
+  s_invalidated = true;
+}
+
+void Shutdown()
+{
+  std::lock_guard lk(s_decoded_textures_lock);
+  s_batch++;
+  s_decoded_textures.clear();
+  s_decoded_textures_size = 0;
+}
+
+// Returns the decoded texture, or nullptr if it can't be decoded as a whole.
+static const DecodedTexture* GetDecodedTexture(const TextureKey& key)
+{
+  for (const RecentTexture& recent : s_recent_textures)
+  {
+    if (recent.batch == s_batch && recent.texture->key == key)
+      return recent.texture;
+  }
+
+  const int block_width = TexDecoder_GetBlockWidthInTexels(key.format);
+  const int block_height = TexDecoder_GetBlockHeightInTexels(key.format);
+  const int width = (key.width_minus_1 / block_width + 1) * block_width;
+  const int height = (key.height_minus_1 / block_height + 1) * block_height;
+
+  // RGBA8 textures in TMEM are split into two halves of 16 bits per texel.
+  const u32 src_size =
+      key.src_odd ? static_cast<u32>(width * height * 2) :
+                    static_cast<u32>(TexDecoder_GetTextureSizeInBytes(width, height, key.format));
+  if (!IsInEmulatedMemory(key.src, src_size) ||
+      (key.src_odd && !IsInEmulatedMemory(key.src_odd, src_size)) ||
+      (key.tlut && !IsInEmulatedMemory(key.tlut, TexDecoder_GetPaletteSize(key.format))))
+  {
+    return nullptr;
+  }
+
+  std::lock_guard lk(s_decoded_textures_lock);
+
+  auto iter = std::find_if(s_decoded_textures.begin(), s_decoded_textures.end(),
+                           [&key](const auto& texture) { return texture->key == key; });
+  DecodedTexture* texture;
+  if (iter != s_decoded_textures.end())
+  {
+    texture = iter->get();
+  }
+  else
+  {
+    texture = s_decoded_textures.emplace_back(std::make_unique<DecodedTexture>()).get();
+    texture->key = key;
+    texture->last_used_batch = 0;
+    texture->validated_generation = 0;
+    texture->texels.resize(static_cast<size_t>(width) * height);
+    texture->stride = width;
+    s_decoded_textures_size += texture->texels.size() * sizeof(u32);
+  }
+
+  // Another thread may have checked it already.
+  if (texture->validated_generation != s_generation)
+  {
+    const u64 hash = HashTextureSource(key, src_size);
+    if (texture->validated_generation == 0 || texture->hash != hash)
+    {
+      // Decode on this thread, the decoding threads might be in use by another one.
+      if (key.src_odd)
+      {
+        _TexDecoder_DecodeRGBA8FromTmemImpl(texture->texels.data(), key.src, key.src_odd, width,
+                                            height);
+      }
+      else
+      {
+        _TexDecoder_DecodeImpl(texture->texels.data(), key.src, width, height, key.format,
+                               key.tlut, key.tlut_format);
+      }
+      texture->hash = hash;
+    }
+    texture->validated_generation = s_generation;
+  }
+  texture->last_used_batch = s_batch;
+
+  s_recent_textures[s_next_recent_texture] = {s_batch, texture};
+  s_next_recent_texture = (s_next_recent_texture + 1) % NUM_RECENT_TEXTURES;
+  return texture;
+}
+
+static inline u32 GetTexel(const DecodedTexture& texture, int s, int t)
+{
+  return texture.texels[static_cast<size_t>(t) * texture.stride + s];
+}
+
+// Same as weighting each texel with SetTexel/AddTexel and shifting the sum right by 14.
+static inline void BilinearFilter(u32 texel00, u32 texel10, u32 texel01, u32 texel11, int fractS,
+                                  int fractT, u8* sample)
+{
+  const s16 weight00 = static_cast<s16>((128 - fractS) * (128 - fractT));
+  const s16 weight10 = static_cast<s16>(fractS * (128 - fractT));
+  const s16 weight01 = static_cast<s16>((128 - fractS) * fractT);
+  const s16 weight11 = static_cast<s16>(fractS * fractT);
+
+#if defined(_M_X86_64)
+  // The weights add up to 128 * 128, so the sums fit in 32 bits.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i top = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel00), _mm_cvtsi32_si128(texel10)), zero);
+  const __m128i bottom = _mm_unpacklo_epi8(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(texel01), _mm_cvtsi32_si128(texel11)), zero);
+  const __m128i top_weights = _mm_set1_epi32((weight10 << 16) | static_cast<u16>(weight00));
+  const __m128i bottom_weights = _mm_set1_epi32((weight11 << 16) | static_cast<u16>(weight01));
+  __m128i sum = _mm_add_epi32(_mm_madd_epi16(top, top_weights),
+                              _mm_madd_epi16(bottom, bottom_weights));
+  sum = _mm_srli_epi32(sum, 14);
+  sum = _mm_packs_epi32(sum, sum);
+  const u32 result = static_cast<u32>(_mm_cvtsi128_si32(_mm_packus_epi16(sum, sum)));
+  std::memcpy(sample, &result, sizeof(result));
+#else
+  u8 in[4][4];
+  std::memcpy(in[0], &texel00, sizeof(u32));
+  std::memcpy(in[1], &texel10, sizeof(u32));
+  std::memcpy(in[2], &texel01, sizeof(u32));
+  std::memcpy(in[3], &texel11, sizeof(u32));
+  for (int i = 0; i < 4; i++)
+  {
+    sample[i] = static_cast<u8>((in[0][i] * weight00 + in[1][i] * weight10 +
+                                 in[2][i] * weight01 + in[3][i] * weight11) >>
+                                14);
+  }
+#endif
+}
+
 static inline void WrapCoord(int* coordp, WrapMode wrap_mode, int image_size)
 {
   int coord = *coordp;
@@ -171,6 +422,18 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     }
   }
 
+  const bool rgba8_from_tmem =
+      texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed;
+  const bool has_tlut = TexDecoder_GetPaletteSize(texfmt) != 0;
+  const TextureKey key{imageSrc,
+                       rgba8_from_tmem ? imageSrcOdd : nullptr,
+                       has_tlut ? tlut : nullptr,
+                       texfmt,
+                       has_tlut ? tlutfmt : TLUTFormat::IA8,
+                       image_width_minus_1,
+                       image_height_minus_1};
+  const DecodedTexture* decoded = GetDecodedTexture(key);
+
   if (linear)
   {
     // offset linear sampling
@@ -196,7 +459,15 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageSPlus1, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageTPlus1, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
+    if (decoded)
+    {
+      BilinearFilter(GetTexel(*decoded, imageS, imageT), GetTexel(*decoded, imageSPlus1, imageT),
+                     GetTexel(*decoded, imageS, imageTPlus1),
+                     GetTexel(*decoded, imageSPlus1, imageTPlus1), fractS, fractT, sample);
+      return;
+    }
+
+    if (!rgba8_from_tmem)
     {
       TexDecoder_DecodeTexel(sampledTex, imageSrc, imageS, imageT, image_width_minus_1, texfmt,
                              tlut, tlutfmt);
@@ -248,12 +519,21 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
 
-    if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
+    if (decoded)
+    {
+      const u32 texel = GetTexel(*decoded, imageS, imageT);
+      std::memcpy(sample, &texel, sizeof(texel));
+    }
+    else if (!rgba8_from_tmem)
+    {
       TexDecoder_DecodeTexel(sample, imageSrc, imageS, imageT, image_width_minus_1, texfmt, tlut,
                              tlutfmt);
+    }
     else
+    {
       TexDecoder_DecodeTexelRGBA8FromTmem(sample, imageSrc, imageSrcOdd, imageS, imageT,
                                           image_width_minus_1);
+    }
   }
 }
 }  // namespace TextureSampler
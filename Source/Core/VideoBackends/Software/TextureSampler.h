@@ -7,6 +7,15 @@
 
 namespace TextureSampler
 {
+// Textures are sampled from a cache of decoded textures. BeginBatch() has to be called before
+// drawing with a different texture state than the previous draw. The cached textures are only
+// checked against their source again once TMEM has been invalidated or loaded, or Invalidate() has
+// been called since the last batch.
+void BeginBatch();
+// Called after the software renderer wrote textures to RAM, e.g. with an EFB copy.
+void Invalidate();
+void Shutdown();
+
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
@@ -10,6 +10,7 @@
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -108,6 +109,187 @@ void TransformNormal(const InputVertexData* src, bool nbt, OutputVertexData* dst
   }
 }
 
+#if defined(_M_X86_64)
+// The batched functions below keep four vertices in structure-of-arrays form, one vertex per SIMD
+// lane. Every lane does the same operations in the same order as the scalar functions above, and
+// without fused multiply-adds, so the results match them exactly.
+namespace
+{
+struct Vec3x4
+{
+  __m128 x;
+  __m128 y;
+  __m128 z;
+};
+
+// The matrices of four vertices. Vertices of a batch usually share their matrix, in which case
+// the elements can be broadcast instead of gathered.
+class MatrixLanes
+{
+public:
+  MatrixLanes(const float* m0, const float* m1, const float* m2, const float* m3)
+      : m_matrices{m0, m1, m2, m3}, m_uniform(m0 == m1 && m0 == m2 && m0 == m3)
+  {
+  }
+
+  __m128 Element(int index) const
+  {
+    if (m_uniform)
+      return _mm_set1_ps(m_matrices[0][index]);
+    return _mm_setr_ps(m_matrices[0][index], m_matrices[1][index], m_matrices[2][index],
+                       m_matrices[3][index]);
+  }
+
+private:
+  std::array<const float*, 4> m_matrices;
+  bool m_uniform;
+};
+
+template <typename GetVec3>
+Vec3x4 LoadVec3x4(GetVec3 get)
+{
+  return {_mm_setr_ps(get(0).x, get(1).x, get(2).x, get(3).x),
+          _mm_setr_ps(get(0).y, get(1).y, get(2).y, get(3).y),
+          _mm_setr_ps(get(0).z, get(1).z, get(2).z, get(3).z)};
+}
+
+template <typename GetVec3>
+void StoreVec3x4(const Vec3x4& v, GetVec3 get)
+{
+  alignas(16) float x[4];
+  alignas(16) float y[4];
+  alignas(16) float z[4];
+  _mm_store_ps(x, v.x);
+  _mm_store_ps(y, v.y);
+  _mm_store_ps(z, v.z);
+  for (int i = 0; i < 4; i++)
+    get(i) = Vec3(x[i], y[i], z[i]);
+}
+
+// Same as MultiplyVec3Mat34 and MultiplyVec3Mat33.
+template <bool translate>
+__m128 MultiplyRow(const MatrixLanes& mat, int first, const Vec3x4& vec)
+{
+  __m128 result = _mm_mul_ps(mat.Element(first), vec.x);
+  result = _mm_add_ps(result, _mm_mul_ps(mat.Element(first + 1), vec.y));
+  result = _mm_add_ps(result, _mm_mul_ps(mat.Element(first + 2), vec.z));
+  if (translate)
+    result = _mm_add_ps(result, mat.Element(first + 3));
+  return result;
+}
+
+Vec3x4 MultiplyVec3Mat34x4(const Vec3x4& vec, const MatrixLanes& mat)
+{
+  return {MultiplyRow<true>(mat, 0, vec), MultiplyRow<true>(mat, 4, vec),
+          MultiplyRow<true>(mat, 8, vec)};
+}
+
+Vec3x4 MultiplyVec3Mat33x4(const Vec3x4& vec, const MatrixLanes& mat)
+{
+  return {MultiplyRow<false>(mat, 0, vec), MultiplyRow<false>(mat, 3, vec),
+          MultiplyRow<false>(mat, 6, vec)};
+}
+
+// Same as Vec3::Normalize.
+Vec3x4 Normalize(const Vec3x4& vec)
+{
+  __m128 length = _mm_mul_ps(vec.x, vec.x);
+  length = _mm_add_ps(length, _mm_mul_ps(vec.y, vec.y));
+  length = _mm_add_ps(length, _mm_mul_ps(vec.z, vec.z));
+  length = _mm_sqrt_ps(length);
+  const __m128 inverse = _mm_div_ps(_mm_set1_ps(1.0f), length);
+  return {_mm_mul_ps(vec.x, inverse), _mm_mul_ps(vec.y, inverse), _mm_mul_ps(vec.z, inverse)};
+}
+}  // namespace
+#endif
+
+void TransformPositions(const InputVertexData* src, OutputVertexData* dst, u32 count)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  const Projection::Raw& proj = xfmem.projection.rawProjection;
+  const bool perspective = xfmem.projection.type == ProjectionType::Perspective;
+  const __m128 p0 = _mm_set1_ps(proj[0]);
+  const __m128 p1 = _mm_set1_ps(proj[1]);
+  const __m128 p2 = _mm_set1_ps(proj[2]);
+  const __m128 p3 = _mm_set1_ps(proj[3]);
+  const __m128 p4 = _mm_set1_ps(proj[4]);
+  const __m128 p5 = _mm_set1_ps(proj[5]);
+
+  for (; i + 4 <= count; i += 4)
+  {
+    const InputVertexData* in = src + i;
+    OutputVertexData* out = dst + i;
+
+    const MatrixLanes mat(
+        &xfmem.posMatrices[in[0].posMtx * 4], &xfmem.posMatrices[in[1].posMtx * 4],
+        &xfmem.posMatrices[in[2].posMtx * 4], &xfmem.posMatrices[in[3].posMtx * 4]);
+    const Vec3x4 mv =
+        MultiplyVec3Mat34x4(LoadVec3x4([in](int j) -> const Vec3& { return in[j].position; }), mat);
+    StoreVec3x4(mv, [out](int j) -> Vec3& { return out[j].mvPosition; });
+
+    __m128 x, y, z, w;
+    if (perspective)
+    {
+      // Same as MultipleVec3Perspective.
+      x = _mm_add_ps(_mm_mul_ps(p0, mv.x), _mm_mul_ps(p1, mv.z));
+      y = _mm_add_ps(_mm_mul_ps(p2, mv.y), _mm_mul_ps(p3, mv.z));
+      z = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(p4, mv.z), p5), _mm_set1_ps(1.0f - (float)1e-7));
+      w = _mm_xor_ps(mv.z, _mm_set1_ps(-0.0f));
+    }
+    else
+    {
+      // Same as MultipleVec3Ortho.
+      x = _mm_add_ps(_mm_mul_ps(p0, mv.x), p1);
+      y = _mm_add_ps(_mm_mul_ps(p2, mv.y), p3);
+      z = _mm_add_ps(_mm_mul_ps(p4, mv.z), p5);
+      w = _mm_set1_ps(1.0f);
+    }
+
+    _MM_TRANSPOSE4_PS(x, y, z, w);
+    _mm_storeu_ps(&out[0].projectedPosition.x, x);
+    _mm_storeu_ps(&out[1].projectedPosition.x, y);
+    _mm_storeu_ps(&out[2].projectedPosition.x, z);
+    _mm_storeu_ps(&out[3].projectedPosition.x, w);
+  }
+#endif
+
+  for (; i < count; i++)
+    TransformPosition(&src[i], &dst[i]);
+}
+
+void TransformNormals(const InputVertexData* src, bool nbt, OutputVertexData* dst, u32 count)
+{
+  u32 i = 0;
+
+#if defined(_M_X86_64)
+  for (; i + 4 <= count; i += 4)
+  {
+    const InputVertexData* in = src + i;
+    OutputVertexData* out = dst + i;
+
+    const MatrixLanes mat(&xfmem.normalMatrices[(in[0].posMtx & 31) * 3],
+                          &xfmem.normalMatrices[(in[1].posMtx & 31) * 3],
+                          &xfmem.normalMatrices[(in[2].posMtx & 31) * 3],
+                          &xfmem.normalMatrices[(in[3].posMtx & 31) * 3]);
+
+    const size_t num_normals = nbt ? 3 : 1;
+    for (size_t n = 0; n < num_normals; n++)
+    {
+      Vec3x4 normal = MultiplyVec3Mat33x4(
+          LoadVec3x4([in, n](int j) -> const Vec3& { return in[j].normal[n]; }), mat);
+      if (n == 0)
+        normal = Normalize(normal);
+      StoreVec3x4(normal, [out, n](int j) -> Vec3& { return out[j].normal[n]; });
+    }
+  }
+#endif
+
+  for (; i < count; i++)
+    TransformNormal(&src[i], nbt, &dst[i]);
+}
+
 static void TransformTexCoordRegular(const TexMtxInfo& texinfo, int coordNum,
                                      const InputVertexData* srcVertex, OutputVertexData* dstVertex)
 {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include "Common/CommonTypes.h"
+
 struct InputVertexData;
 struct OutputVertexData;
 
@@ -12,4 +14,9 @@ void TransformPosition(const InputVertexData* src, OutputVertexData* dst);
 void TransformNormal(const InputVertexData* src, bool nbt, OutputVertexData* dst);
 void TransformColor(const InputVertexData* src, OutputVertexData* dst);
 void TransformTexCoord(const InputVertexData* src, OutputVertexData* dst);
+
+// Batched versions of TransformPosition and TransformNormal, which transform four vertices at a
+// time. The results are bit-identical to calling the per-vertex functions on each vertex.
+void TransformPositions(const InputVertexData* src, OutputVertexData* dst, u32 count);
+void TransformNormals(const InputVertexData* src, bool nbt, OutputVertexData* dst, u32 count);
 }  // namespace TransformUnit
@@ -0,0 +1,116 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Buckets guest memory ranges by the fixed-size pages they cover, so that ranges touching a given
+// address can be found by looking at a single page, instead of everything stored below it.
+//
+// Ranges are identified by their start address, size and value, all of which have to be passed
+// unchanged when removing them again. Empty ranges don't cover any memory and aren't stored.
+template <typename T>
+class AddressRangeIndex
+{
+public:
+  static constexpr u32 PAGE_SHIFT = 16;
+
+  void Add(u32 address, u32 size, T value)
+  {
+    if (size == 0)
+      return;
+
+    const u32 last_page = GetLastPage(address, size);
+    if (last_page >= m_pages.size())
+      m_pages.resize(last_page + 1);
+
+    for (u32 page = address >> PAGE_SHIFT; page <= last_page; page++)
+      m_pages[page].push_back({address, size, value});
+  }
+
+  void Remove(u32 address, u32 size, T value)
+  {
+    if (size == 0)
+      return;
+
+    const u32 last_page = GetLastPage(address, size);
+    for (u32 page = address >> PAGE_SHIFT; page <= last_page && page < m_pages.size(); page++)
+    {
+      std::vector<Range>& ranges = m_pages[page];
+      const auto iter = std::find_if(ranges.begin(), ranges.end(), [&](const Range& range) {
+        return range.address == address && range.size == size && range.value == value;
+      });
+      if (iter == ranges.end())
+        continue;
+
+      // Order within a page doesn't matter.
+      *iter = ranges.back();
+      ranges.pop_back();
+    }
+  }
+
+  void Clear() { m_pages.clear(); }
+
+  // Returns the lowest start address of all ranges covering the given address, or the address
+  // itself if there are none. Any range overlapping memory starting at that address therefore
+  // starts between the returned address and the end of that memory.
+  u32 GetLowestOverlappingAddress(u32 address) const
+  {
+    // Ranges starting below the address can only overlap the queried range by covering the
+    // address itself, so they're all stored in its page.
+    const u32 page = address >> PAGE_SHIFT;
+    if (page >= m_pages.size())
+      return address;
+
+    u32 lowest_address = address;
+    for (const Range& range : m_pages[page])
+    {
+      if (range.address < lowest_address && u64(range.address) + range.size > address)
+        lowest_address = range.address;
+    }
+    return lowest_address;
+  }
+
+  // Calls func(value) for every range which overlaps [address, address + size). Ranges spanning
+  // several of the queried pages are visited once.
+  template <typename Func>
+  void ForEachOverlapping(u32 address, u32 size, Func func) const
+  {
+    if (size == 0)
+      return;
+
+    const u32 first_page = address >> PAGE_SHIFT;
+    const u32 last_page = GetLastPage(address, size);
+    for (u32 page = first_page; page <= last_page && page < m_pages.size(); page++)
+    {
+      for (const Range& range : m_pages[page])
+      {
+        // Only report a range in the first queried page it covers.
+        if (page != first_page && range.address >> PAGE_SHIFT != page)
+          continue;
+
+        if (range.address < u64(address) + size && u64(range.address) + range.size > address)
+          func(range.value);
+      }
+    }
+  }
+
+private:
+  struct Range
+  {
+    u32 address;
+    u32 size;
+    T value;
+  };
+
+  static u32 GetLastPage(u32 address, u32 size)
+  {
+    return static_cast<u32>((u64(address) + size - 1) >> PAGE_SHIFT);
+  }
+
+  std::vector<std::vector<Range>> m_pages;
+};
@@ -3,6 +3,8 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
+#include <limits>
 #include <thread>
 
 #include "Common/Assert.h"
@@ -22,20 +24,27 @@ AsyncShaderCompiler::~AsyncShaderCompiler()
   ASSERT(!HasWorkerThreads());
 }
 
-void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
+void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority, u64 deadline)
 {
   // If no worker threads are available, compile synchronously.
   if (!HasWorkerThreads())
   {
     item->Compile();
     m_completed_work.push_back(std::move(item));
+    return;
   }
-  else
+
+  // Spread the work over the worker queues, the worker threads balance it out by stealing.
+  WorkerQueue& queue = *m_worker_queues[m_next_queue++ % m_worker_queues.size()];
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
-    m_worker_thread_wake.notify_one();
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.items.emplace(std::make_pair(deadline, priority),
+                        PendingWorkItem{std::move(item), deadline, Clock::now()});
+    m_pending_items++;
   }
+
+  std::lock_guard<std::mutex> guard(m_worker_thread_wake_lock);
+  m_worker_thread_wake.notify_one();
 }
 
 void AsyncShaderCompiler::RetrieveWorkItems()
@@ -55,8 +64,8 @@ void AsyncShaderCompiler::RetrieveWorkItems()
 
 bool AsyncShaderCompiler::HasPendingWork()
 {
-  std::lock_guard<std::mutex> guard(m_pending_work_lock);
-  return !m_pending_work.empty() || m_busy_workers.load() != 0;
+  // Workers become busy before the item they take stops counting as pending.
+  return m_pending_items.load() != 0 || m_busy_workers.load() != 0;
 }
 
 bool AsyncShaderCompiler::HasCompletedWork()
@@ -91,33 +100,56 @@ void AsyncShaderCompiler::WaitUntilCompletion(
   // Grab the number of pending items. We use this to work out how many are left.
   size_t total_items = 0;
   {
-    // Safe to hold both locks here, since nowhere else does.
-    std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
     std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-    total_items = m_completed_work.size() + m_pending_work.size() + m_busy_workers.load() + 1;
+    total_items = m_completed_work.size() + m_pending_items.load() + m_busy_workers.load() + 1;
   }
 
   // Update progress while the compiles complete.
-  for (;;)
+  while (HasPendingWork())
   {
-    size_t remaining_items;
-    {
-      std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
-      if (m_pending_work.empty() && !m_busy_workers.load())
-        break;
-      remaining_items = m_pending_work.size();
-    }
-
+    const size_t remaining_items = std::min(m_pending_items.load(), total_items);
     progress_callback(total_items - remaining_items, total_items);
     std::this_thread::sleep_for(CHECK_INTERVAL);
   }
 }
 
+AsyncShaderCompiler::Metrics AsyncShaderCompiler::GetMetrics()
+{
+  Metrics metrics = {};
+  metrics.queue_depth = m_pending_items.load();
+
+  std::array<u32, LATENCY_SAMPLES> samples;
+  size_t num_samples;
+  {
+    std::lock_guard<std::mutex> guard(m_completed_work_lock);
+    metrics.num_compiled = m_num_compiled;
+    metrics.num_cancelled = m_num_cancelled;
+    metrics.num_deadlines_missed = m_num_deadlines_missed;
+    num_samples = std::min(m_num_latency_samples, LATENCY_SAMPLES);
+    samples = m_latency_samples_us;
+  }
+
+  if (num_samples == 0)
+    return metrics;
+
+  const auto percentile = [&samples, num_samples](size_t percent) {
+    const auto nth = samples.begin() + (num_samples - 1) * percent / 100;
+    std::nth_element(samples.begin(), nth, samples.begin() + num_samples);
+    return std::chrono::microseconds(*nth);
+  };
+  metrics.latency_p50 = percentile(50);
+  metrics.latency_p99 = percentile(99);
+  return metrics;
+}
+
 bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
 {
   if (num_worker_threads == 0)
     return true;
 
+  // Work left over from the previous worker threads is picked up by the new ones.
+  RedistributePendingWork(num_worker_threads);
+
   for (u32 i = 0; i < num_worker_threads; i++)
   {
     void* thread_param = nullptr;
@@ -129,7 +161,7 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
 
     m_worker_thread_start_result.store(false);
 
-    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param);
+    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param, size_t(i));
     m_init_event.Wait();
 
     if (!m_worker_thread_start_result.load())
@@ -166,7 +198,7 @@ void AsyncShaderCompiler::StopWorkerThreads()
 
   // Signal worker threads to stop, and wake all of them.
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    std::lock_guard<std::mutex> guard(m_worker_thread_wake_lock);
     m_exit_flag.Set();
     m_worker_thread_wake.notify_all();
   }
@@ -192,7 +224,72 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 {
 }
 
-void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
+void AsyncShaderCompiler::RedistributePendingWork(size_t num_queues)
+{
+  std::vector<std::unique_ptr<WorkerQueue>> old_queues(num_queues);
+  std::swap(m_worker_queues, old_queues);
+  for (auto& queue : m_worker_queues)
+    queue = std::make_unique<WorkerQueue>();
+
+  m_next_queue = 0;
+  for (auto& old_queue : old_queues)
+  {
+    for (auto& [key, pending] : old_queue->items)
+      m_worker_queues[m_next_queue++ % num_queues]->items.emplace(key, std::move(pending));
+  }
+}
+
+bool AsyncShaderCompiler::PopWorkItem(size_t queue_index, PendingWorkItem* item)
+{
+  // Thieves take the most urgent item as well, rather than the least urgent one, as otherwise
+  // deadlines would be ignored whenever the work isn't evenly spread.
+  const size_t num_queues = m_worker_queues.size();
+  for (size_t i = 0; i < num_queues; i++)
+  {
+    WorkerQueue& queue = *m_worker_queues[(queue_index + i) % num_queues];
+    std::lock_guard<std::mutex> guard(queue.lock);
+    if (queue.items.empty())
+      continue;
+
+    auto iter = queue.items.begin();
+    *item = std::move(iter->second);
+    queue.items.erase(iter);
+    m_busy_workers++;
+    m_pending_items--;
+    return true;
+  }
+
+  return false;
+}
+
+void AsyncShaderCompiler::CompleteWorkItem(PendingWorkItem item)
+{
+  // The item may be cancelled while it's being compiled, in which case it still counts.
+  const bool cancelled = item.item->IsCancelled();
+  const bool retrieve = cancelled || item.item->Compile();
+
+  const auto latency =
+      std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - item.queue_time);
+
+  std::lock_guard<std::mutex> guard(m_completed_work_lock);
+  if (cancelled)
+  {
+    m_num_cancelled++;
+  }
+  else
+  {
+    m_num_compiled++;
+    if (item.deadline < GetCurrentFrame())
+      m_num_deadlines_missed++;
+    m_latency_samples_us[m_num_latency_samples++ % LATENCY_SAMPLES] =
+        static_cast<u32>(std::min<s64>(latency.count(), std::numeric_limits<u32>::max()));
+  }
+
+  if (retrieve)
+    m_completed_work.push_back(std::move(item.item));
+}
+
+void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param, size_t queue_index)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
 
@@ -208,35 +305,27 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
   m_worker_thread_start_result.store(true);
   m_init_event.Set();
 
-  WorkerThreadRun();
+  WorkerThreadRun(queue_index);
 
   WorkerThreadExit(param);
 }
 
-void AsyncShaderCompiler::WorkerThreadRun()
+void AsyncShaderCompiler::WorkerThreadRun(size_t queue_index)
 {
-  std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
-    m_worker_thread_wake.wait(pending_lock);
-
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+    PendingWorkItem item;
+    if (!PopWorkItem(queue_index, &item))
     {
-      m_busy_workers++;
-      auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
-      m_pending_work.erase(iter);
-      pending_lock.unlock();
-
-      if (item->Compile())
-      {
-        std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-        m_completed_work.push_back(std::move(item));
-      }
-
-      pending_lock.lock();
-      m_busy_workers--;
+      std::unique_lock<std::mutex> wake_lock(m_worker_thread_wake_lock);
+      m_worker_thread_wake.wait(wake_lock, [this] {
+        return m_exit_flag.IsSet() || m_pending_items.load() != 0;
+      });
+      continue;
     }
+
+    CompleteWorkItem(std::move(item));
+    m_busy_workers--;
   }
 }
 
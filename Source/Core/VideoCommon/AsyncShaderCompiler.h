@@ -3,10 +3,13 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
+#include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -29,10 +32,34 @@ public:
     virtual ~WorkItem() = default;
     virtual bool Compile() = 0;
     virtual void Retrieve() = 0;
+
+    // Cancelled items which haven't started compiling yet are skipped by the worker threads, but
+    // are still retrieved, so that their owner can clean up after them. Thread-safe.
+    void Cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+    bool IsCancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic_bool m_cancelled{false};
   };
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
 
+  // Deadline of work items which aren't needed by any particular frame.
+  static constexpr u64 NO_DEADLINE = std::numeric_limits<u64>::max();
+
+  struct Metrics
+  {
+    // Work items which are queued, but not yet being compiled.
+    size_t queue_depth;
+    u64 num_compiled;
+    u64 num_cancelled;
+    // Work items which were compiled after the frame they were needed by.
+    u64 num_deadlines_missed;
+    // Time from queuing to the end of compiling, over the last LATENCY_SAMPLES work items.
+    std::chrono::microseconds latency_p50;
+    std::chrono::microseconds latency_p99;
+  };
+
   AsyncShaderCompiler();
   virtual ~AsyncShaderCompiler();
 
@@ -42,13 +69,20 @@ public:
     return std::make_unique<T>(std::forward<Params>(params)...);
   }
 
-  // Queues a new work item to the compiler threads. The lower the priority, the sooner
-  // this work item will be compiled, relative to the other work items.
-  void QueueWorkItem(WorkItemPtr item, u32 priority);
+  // Queues a new work item to the compiler threads. Work items with an earlier deadline frame are
+  // compiled first. Of the work items with the same deadline, the lower the priority, the sooner
+  // the work item will be compiled.
+  void QueueWorkItem(WorkItemPtr item, u32 priority, u64 deadline = NO_DEADLINE);
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
 
+  // Deadlines are counted in frames, which the owner advances once per frame.
+  void AdvanceFrame() { m_current_frame.fetch_add(1, std::memory_order_relaxed); }
+  u64 GetCurrentFrame() const { return m_current_frame.load(std::memory_order_relaxed); }
+
+  Metrics GetMetrics();
+
   // Simpler version without progress updates.
   void WaitUntilCompletion();
 
@@ -67,8 +101,33 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
-  void WorkerThreadEntryPoint(void* param);
-  void WorkerThreadRun();
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr size_t LATENCY_SAMPLES = 256;
+
+  struct PendingWorkItem
+  {
+    WorkItemPtr item;
+    u64 deadline;
+    Clock::time_point queue_time;
+  };
+
+  // Each worker thread takes work from its own queue first, and steals from the other queues once
+  // its own runs dry. This keeps the worker threads from contending on a single lock.
+  struct WorkerQueue
+  {
+    // Ordered by deadline, then priority. A multimap is used, because we can't move the
+    // unique_ptr out of a priority_queue.
+    std::multimap<std::pair<u64, u32>, PendingWorkItem> items;
+    std::mutex lock;
+  };
+
+  void RedistributePendingWork(size_t num_queues);
+  bool PopWorkItem(size_t queue_index, PendingWorkItem* item);
+  void CompleteWorkItem(PendingWorkItem item);
+
+  void WorkerThreadEntryPoint(void* param, size_t queue_index);
+  void WorkerThreadRun(size_t queue_index);
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -76,15 +135,25 @@ private:
   std::vector<std::thread> m_worker_threads;
   std::atomic_bool m_worker_thread_start_result{false};
 
-  // A multimap is used to store the work items. We can't use a priority_queue here, because
-  // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
-  std::mutex m_pending_work_lock;
-  std::condition_variable m_worker_thread_wake;
+  // Only resized while no worker threads are running.
+  std::vector<std::unique_ptr<WorkerQueue>> m_worker_queues;
+  size_t m_next_queue = 0;
+  std::atomic_size_t m_pending_items{0};
   std::atomic_size_t m_busy_workers{0};
+  std::mutex m_worker_thread_wake_lock;
+  std::condition_variable m_worker_thread_wake;
+
+  std::atomic<u64> m_current_frame{0};
 
   std::deque<WorkItemPtr> m_completed_work;
   std::mutex m_completed_work_lock;
+
+  // Guarded by m_completed_work_lock.
+  std::array<u32, LATENCY_SAMPLES> m_latency_samples_us{};
+  size_t m_num_latency_samples = 0;
+  u64 m_num_compiled = 0;
+  u64 m_num_cancelled = 0;
+  u64 m_num_deadlines_missed = 0;
 };
 
 }  // namespace VideoCommon
@@ -4,6 +4,7 @@
 #include "VideoCommon/BPStructs.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstring>
 #include <string>
@@ -32,9 +33,11 @@
 #include "VideoCommon/PixelEngine.h"
 #include "VideoCommon/PixelShaderManager.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/TMEM.h"
 #include "VideoCommon/TextureCacheBase.h"
 #include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
 #include "VideoCommon/VideoBackendBase.h"
 #include "VideoCommon/VideoCommon.h"
@@ -82,6 +85,7 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
           bp.address == BPMEM_TEXINVALIDATE || bp.address == BPMEM_PRELOAD_MODE ||
           bp.address == BPMEM_CLEAR_PIXEL_PERF))
     {
+      g_vertex_manager->SkipRedundantFlush();
       return;
     }
   }
@@ -215,6 +219,10 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
     // The values in bpmem.copyTexSrcXY and bpmem.copyTexSrcWH are updated in case 0x49 and 0x4a in
     // this function
 
+    const bool measure_time = g_ActiveConfig.bOverlayStats;
+    const auto start = measure_time ? std::chrono::steady_clock::now() :
+                                      std::chrono::steady_clock::time_point();
+
     u32 destAddr = bpmem.copyTexDest << 5;
     u32 destStride = bpmem.copyMipMapStrideChannels << 5;
 
@@ -334,6 +342,14 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
       ClearScreen(srcRect);
     }
 
+    if (measure_time)
+    {
+      ADDSTAT(g_stats.this_frame.efb_copy_ns,
+              std::chrono::duration_cast<std::chrono::nanoseconds>(
+                  std::chrono::steady_clock::now() - start)
+                  .count());
+    }
+
     return;
   }
   case BPMEM_LOADTLUT0:  // This one updates bpmem.tlutXferSrc, no need to do anything here.
@@ -348,6 +364,7 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
     if (!SConfig::GetInstance().bWii)
       addr = addr & 0x01FFFFFF;
 
+    g_texture_cache->FlushEFBCopies(addr, tlutXferCount);
     Memory::CopyFromEmu(texMem + tlutTMemAddr, addr, tlutXferCount);
 
     if (OpcodeDecoder::g_record_fifo_data)
@@ -534,6 +551,11 @@ static void BPWritten(const BPCmd& bp, int cycles_into_future)
       u32 bytes_read = 0;
       u32 tmem_addr_even = tmem_cfg.preload_tmem_even * TMEM_LINE_SIZE;
 
+      // RGBA8 tiles read two lines each, see below.
+      const u32 lines_per_tile = tmem_cfg.preload_tile_info.type != 3 ? 1 : 2;
+      g_texture_cache->FlushEFBCopies(
+          src_addr, tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE * lines_per_tile);
+
       if (tmem_cfg.preload_tile_info.type != 3)
       {
         bytes_read = tmem_cfg.preload_tile_info.count * TMEM_LINE_SIZE;
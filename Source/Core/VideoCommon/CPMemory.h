@@ -636,6 +636,9 @@ struct CPState final
 
   // Mutates the CP state based on the given command and value.
   void LoadCPReg(u8 sub_cmd, u32 value);
+  // Returns whether the command would leave the vertex descriptor, attribute formats and arrays
+  // unchanged. Always false for the matrix indices and unknown commands.
+  bool IsRedundantWrite(u8 sub_cmd, u32 value) const;
   // Fills memory with data from CP regs.  There should be space for 0x100 values in memory.
   void FillCPMemoryArray(u32* memory) const;
 
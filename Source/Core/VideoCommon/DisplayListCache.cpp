@@ -0,0 +1,93 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/DisplayListCache.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace OpcodeDecoder
+{
+// How many bytes at the start of the command decide how it is decoded. XF and vertex data is
+// passed on from the display list when replaying, so it doesn't need to be compared.
+static u32 GetDecodedSize(const DecodedCommand& command)
+{
+  switch (command.type)
+  {
+  case DecodedCommand::Type::XF:
+    return 5;
+  case DecodedCommand::Type::Primitive:
+    return 3;
+  default:
+    return command.size;
+  }
+}
+
+void DisplayListCache::Clear()
+{
+  m_entries.clear();
+}
+
+DisplayListCache::VertexFormat DisplayListCache::GetVertexFormat(const CPState& state)
+{
+  VertexFormat format;
+  format[0] = state.vtx_desc.low.Hex;
+  format[1] = state.vtx_desc.high.Hex;
+  for (size_t i = 0; i < CP_NUM_VAT_REG; i++)
+  {
+    format[2 + i * 3] = state.vtx_attr[i].g0.Hex;
+    format[3 + i * 3] = state.vtx_attr[i].g1.Hex;
+    format[4 + i * 3] = state.vtx_attr[i].g2.Hex;
+  }
+  return format;
+}
+
+void DisplayListCache::GetCommandBytes(const std::vector<DecodedCommand>& commands,
+                                       const u8* data, u32 size, std::vector<u8>* bytes)
+{
+  bytes->clear();
+  u32 end = 0;
+  for (const DecodedCommand& command : commands)
+  {
+    const u8* const start = data + command.offset;
+    bytes->insert(bytes->end(), start, start + GetDecodedSize(command));
+    end = command.offset + command.size;
+  }
+  bytes->insert(bytes->end(), data + end, data + size);
+}
+
+bool DisplayListCache::CommandBytesMatch(const Entry& entry, const u8* data, u32 size)
+{
+  const u8* bytes = entry.command_bytes.data();
+  u32 end = 0;
+  for (const DecodedCommand& command : entry.commands)
+  {
+    const u32 decoded_size = GetDecodedSize(command);
+    if (std::memcmp(data + command.offset, bytes, decoded_size) != 0)
+      return false;
+    bytes += decoded_size;
+    end = command.offset + command.size;
+  }
+  return std::memcmp(data + end, bytes, size - end) == 0;
+}
+
+void DisplayListCache::EvictLeastRecentlyUsed()
+{
+  std::vector<u64> last_used;
+  last_used.reserve(m_entries.size());
+  for (const auto& [key, entry] : m_entries)
+    last_used.push_back(entry.last_used);
+
+  const auto median = last_used.begin() + last_used.size() / 2;
+  std::nth_element(last_used.begin(), median, last_used.end());
+  const u64 oldest_kept = *median;
+
+  for (auto iter = m_entries.begin(); iter != m_entries.end();)
+  {
+    if (iter->second.last_used < oldest_kept)
+      iter = m_entries.erase(iter);
+    else
+      ++iter;
+  }
+}
+}  // namespace OpcodeDecoder
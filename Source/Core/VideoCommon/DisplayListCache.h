@@ -0,0 +1,239 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace OpcodeDecoder
+{
+// A command of a display list, as RunCommand decoded it.
+struct DecodedCommand
+{
+  enum class Type : u8
+  {
+    Nop,
+    CP,
+    XF,
+    BP,
+    IndexedLoad,
+    Primitive,
+  };
+
+  Type type;
+  u8 command;           // CP command, BP register, primitive VAT
+  u8 count;             // XF transfer size, indexed load size
+  Primitive primitive;  // Primitive type
+  CPArray array;        // Indexed load array
+  u16 address;          // XF and indexed load address
+  u16 num_vertices;     // Primitive vertex count
+  u32 value;            // CP and BP value, indexed load index, vertex size, number of NOPs
+  u32 offset;           // Offset of the command within the display list
+  u32 size;             // Size of the command
+};
+
+// Remembers how display lists were decoded, so that calling the same display list again doesn't
+// need to decode every command of it again. Games tend to call the same static display lists from
+// RAM every frame.
+//
+// The size of the vertices in a display list depends on the vertex format it is called with, so
+// a decoded display list is only reused if both its commands and the vertex descriptor and
+// attribute formats are the same as when it was decoded. There's no way to find out whether the
+// CPU wrote to the display list in the meantime, so the bytes the commands were decoded from are
+// compared on every call. The vertex and XF data is left out, as replaying passes it on from the
+// display list itself, and it makes up most of a display list.
+class DisplayListCache
+{
+public:
+  // Limits the memory used by display lists which are built in different places every frame.
+  // Once there are more, the half which was called the longest time ago is thrown away.
+  static constexpr size_t MAX_ENTRIES = 8192;
+
+  // Runs the display list through the callback. Returns true if its commands were replayed from
+  // the cache, and false if it had to be decoded.
+  template <typename T>
+  bool Run(u32 address, const u8* data, u32 size, T& callback);
+
+  void Clear();
+
+private:
+  // The vertex descriptor and all vertex attribute formats, as raw register values.
+  using VertexFormat = std::array<u32, 2 + 3 * CP_NUM_VAT_REG>;
+
+  struct Entry
+  {
+    VertexFormat vertex_format{};
+    // Display lists calling other display lists, or containing unknown commands, are not replayed.
+    bool replayable = false;
+    u64 last_used = 0;
+    std::vector<DecodedCommand> commands;
+    // The bytes of the commands without their XF and vertex data, followed by the bytes after the
+    // last command (a truncated command, if any).
+    std::vector<u8> command_bytes;
+  };
+
+  static VertexFormat GetVertexFormat(const CPState& state);
+  static void GetCommandBytes(const std::vector<DecodedCommand>& commands, const u8* data,
+                              u32 size, std::vector<u8>* bytes);
+  static bool CommandBytesMatch(const Entry& entry, const u8* data, u32 size);
+  void EvictLeastRecentlyUsed();
+
+  std::unordered_map<u64, Entry> m_entries;
+  u64 m_calls = 0;
+};
+
+// Passes commands on to another callback, recording them as they go. (This can't live in detail,
+// as argument-dependent lookup would make the calls to RunCommand ambiguous.)
+template <typename T>
+class DisplayListRecorder final : public Callback
+{
+public:
+  DisplayListRecorder(T& callback, const u8* start, std::vector<DecodedCommand>* commands)
+      : m_callback(callback), m_start(start), m_commands(commands)
+  {
+  }
+
+  OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data))
+  {
+    m_command = {.type = DecodedCommand::Type::XF, .count = count, .address = address};
+    m_callback.OnXF(address, count, data);
+  }
+  OPCODE_CALLBACK(void OnCP(u8 command, u32 value))
+  {
+    m_command = {.type = DecodedCommand::Type::CP, .command = command, .value = value};
+    m_callback.OnCP(command, value);
+  }
+  OPCODE_CALLBACK(void OnBP(u8 command, u32 value))
+  {
+    m_command = {.type = DecodedCommand::Type::BP, .command = command, .value = value};
+    m_callback.OnBP(command, value);
+  }
+  OPCODE_CALLBACK(void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size))
+  {
+    m_command = {.type = DecodedCommand::Type::IndexedLoad,
+                 .count = size,
+                 .array = array,
+                 .address = address,
+                 .value = index};
+    m_callback.OnIndexedLoad(array, index, address, size);
+  }
+  OPCODE_CALLBACK(void OnPrimitiveCommand(Primitive primitive, u8 vat, u32 vertex_size,
+                                          u16 num_vertices, const u8* vertex_data))
+  {
+    m_command = {.type = DecodedCommand::Type::Primitive,
+                 .command = vat,
+                 .primitive = primitive,
+                 .num_vertices = num_vertices,
+                 .value = vertex_size};
+    m_callback.OnPrimitiveCommand(primitive, vat, vertex_size, num_vertices, vertex_data);
+  }
+  OPCODE_CALLBACK(void OnDisplayList(u32 address, u32 size))
+  {
+    m_replayable = false;
+    m_callback.OnDisplayList(address, size);
+  }
+  OPCODE_CALLBACK(void OnNop(u32 count))
+  {
+    m_command = {.type = DecodedCommand::Type::Nop, .value = count};
+    m_callback.OnNop(count);
+  }
+  OPCODE_CALLBACK(void OnUnknown(u8 opcode, const u8* data))
+  {
+    m_replayable = false;
+    m_callback.OnUnknown(opcode, data);
+  }
+  OPCODE_CALLBACK(void OnCommand(const u8* data, u32 size))
+  {
+    m_command.offset = static_cast<u32>(data - m_start);
+    m_command.size = size;
+    m_commands->push_back(m_command);
+    m_callback.OnCommand(data, size);
+  }
+  OPCODE_CALLBACK(CPState& GetCPState()) { return m_callback.GetCPState(); }
+
+  bool IsReplayable() const { return m_replayable; }
+
+private:
+  T& m_callback;
+  const u8* m_start;
+  std::vector<DecodedCommand>* m_commands;
+  DecodedCommand m_command{};
+  bool m_replayable = true;
+};
+
+// Calls the callback the same way Run did when the commands were recorded.
+template <typename T>
+void ReplayDisplayList(const std::vector<DecodedCommand>& commands, const u8* start, T& callback)
+{
+  for (const DecodedCommand& command : commands)
+  {
+    const u8* const data = start + command.offset;
+    switch (command.type)
+    {
+    case DecodedCommand::Type::Nop:
+      callback.OnNop(command.value);
+      break;
+    case DecodedCommand::Type::CP:
+      callback.OnCP(command.command, command.value);
+      break;
+    case DecodedCommand::Type::XF:
+      callback.OnXF(command.address, command.count, data + 5);
+      break;
+    case DecodedCommand::Type::BP:
+      callback.OnBP(command.command, command.value);
+      break;
+    case DecodedCommand::Type::IndexedLoad:
+      callback.OnIndexedLoad(command.array, command.value, command.address, command.count);
+      break;
+    case DecodedCommand::Type::Primitive:
+      callback.OnPrimitiveCommand(command.primitive, command.command, command.value,
+                                  command.num_vertices, data + 3);
+      break;
+    }
+    callback.OnCommand(data, command.size);
+  }
+}
+
+template <typename T>
+bool DisplayListCache::Run(u32 address, const u8* data, u32 size, T& callback)
+{
+  const VertexFormat vertex_format = GetVertexFormat(callback.GetCPState());
+
+  const auto [iter, inserted] = m_entries.try_emplace(u64(address) << 32 | size);
+  Entry& entry = iter->second;
+  entry.last_used = ++m_calls;
+  if (!inserted && entry.replayable && entry.vertex_format == vertex_format &&
+      CommandBytesMatch(entry, data, size))
+  {
+    ReplayDisplayList(entry.commands, data, callback);
+    return true;
+  }
+
+  entry.vertex_format = vertex_format;
+  entry.commands.clear();
+
+  DisplayListRecorder<T> recorder(callback, data, &entry.commands);
+  OpcodeDecoder::Run(data, size, recorder);
+  entry.replayable = recorder.IsReplayable();
+  if (entry.replayable)
+  {
+    GetCommandBytes(entry.commands, data, size, &entry.command_bytes);
+  }
+  else
+  {
+    entry.commands = {};
+    entry.command_bytes = {};
+  }
+
+  if (m_entries.size() > MAX_ENTRIES)
+    EvictLeastRecentlyUsed();
+
+  return false;
+}
+}  // namespace OpcodeDecoder
@@ -0,0 +1,56 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/EFBPeekPredictor.h"
+
+#include <utility>
+
+void EFBPeekPredictor::Reset(u32 num_tiles)
+{
+  for (std::vector<bool>& prefetched : m_prefetched)
+    prefetched.assign(num_tiles, false);
+
+  m_peeks_this_frame.clear();
+  m_predicted_peeks.clear();
+  m_next_predicted_peek = 0;
+}
+
+bool EFBPeekPredictor::OnPeek(bool depth, u32 tile_index, u32 draw_counter, bool miss)
+{
+  if (tile_index >= m_prefetched[depth].size())
+    return false;
+
+  if (miss)
+  {
+    m_prefetched[depth][tile_index] = false;
+    RecordPeek(depth, tile_index, draw_counter);
+    return false;
+  }
+
+  if (!m_prefetched[depth][tile_index])
+    return false;
+
+  RecordPeek(depth, tile_index, draw_counter);
+  return true;
+}
+
+void EFBPeekPredictor::RecordPeek(bool depth, u32 tile_index, u32 draw_counter)
+{
+  // Tiles are usually peeked many times after the same draw, only the first one has to be kept.
+  for (auto it = m_peeks_this_frame.rbegin();
+       it != m_peeks_this_frame.rend() && it->draw_counter == draw_counter; ++it)
+  {
+    if (it->tile_index == tile_index && it->depth == depth)
+      return;
+  }
+
+  m_peeks_this_frame.push_back({draw_counter, tile_index, depth});
+}
+
+void EFBPeekPredictor::OnEndFrame()
+{
+  // The peeks were recorded in the order of the draws, which is the order OnDraw expects.
+  m_predicted_peeks = std::move(m_peeks_this_frame);
+  m_peeks_this_frame.clear();
+  m_next_predicted_peek = 0;
+}
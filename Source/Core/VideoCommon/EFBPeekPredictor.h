@@ -0,0 +1,67 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Remembers which EFB cache tiles the CPU peeked in a frame, and after how many draws, so that the
+// same tiles can be read back ahead of time in the next frame.
+//
+// Tiles are identified by their index in the color or depth cache. Every peek which had to read
+// its tile back, or which found a tile that was prefetched for it, is recorded for the next frame.
+class EFBPeekPredictor
+{
+public:
+  struct Tile
+  {
+    u32 draw_counter;
+    u32 tile_index;
+    bool depth;
+  };
+
+  // Forgets everything, e.g. when the cache tile size changes.
+  void Reset(u32 num_tiles);
+
+  // Calls prefetch(depth, tile_index) for every tile which was peeked after this draw in the last
+  // frame. It returns whether the tile was read back, which isn't needed if it is still cached.
+  template <typename PrefetchFunc>
+  void OnDraw(u32 draw_counter, PrefetchFunc prefetch)
+  {
+    for (; m_next_predicted_peek < m_predicted_peeks.size(); m_next_predicted_peek++)
+    {
+      const Tile& tile = m_predicted_peeks[m_next_predicted_peek];
+      if (tile.draw_counter > draw_counter)
+        break;
+      if (tile.draw_counter < draw_counter)
+        continue;
+
+      if (prefetch(tile.depth, tile.tile_index))
+        m_prefetched[tile.depth][tile.tile_index] = true;
+    }
+  }
+
+  // Called for every peek. A miss means that the tile had to be read back for the peek itself.
+  // Returns whether the peek found a prefetched tile.
+  bool OnPeek(bool depth, u32 tile_index, u32 draw_counter, bool miss);
+
+  void OnEndFrame();
+
+  const std::vector<Tile>& GetPredictedPeeks() const { return m_predicted_peeks; }
+
+private:
+  void RecordPeek(bool depth, u32 tile_index, u32 draw_counter);
+
+  // Whether the contents of a tile were read back ahead of time, indexed by [depth][tile_index].
+  // Cleared when a peek misses the tile, as it was invalidated since.
+  std::array<std::vector<bool>, 2> m_prefetched;
+
+  // Tiles peeked this frame, and the ones peeked last frame which are yet to be read back.
+  std::vector<Tile> m_peeks_this_frame;
+  std::vector<Tile> m_predicted_peeks;
+  size_t m_next_predicted_peek = 0;
+};
@@ -88,6 +88,9 @@ static void RefreshConfig()
 
 void DoState(PointerWrap& p)
 {
+  // Queued vertices are converted from the video buffer, which is about to be replaced.
+  VertexLoaderManager::WaitForVertexLoading();
+
   p.DoArray(s_video_buffer, FIFO_SIZE);
   u8* write_ptr = s_video_buffer_write_ptr;
   p.DoPointer(write_ptr, s_video_buffer);
@@ -258,6 +261,8 @@ static void ReadDataFromFifo(u32 readPtr)
       PanicAlertFmt("FIFO out of bounds (existing {} + new {} > {})", existing_len, len, FIFO_SIZE);
       return;
     }
+    // Queued vertices may still be read from the already decoded part of the buffer.
+    VertexLoaderManager::WaitForVertexLoading();
     memmove(s_video_buffer, s_video_buffer_read_ptr, existing_len);
     s_video_buffer_write_ptr = s_video_buffer + existing_len;
     s_video_buffer_read_ptr = s_video_buffer;
@@ -305,6 +310,8 @@ static void ReadDataFromFifoOnCPU(u32 readPtr)
 
 void ResetVideoBuffer()
 {
+  VertexLoaderManager::WaitForVertexLoading();
+
   s_video_buffer_read_ptr = s_video_buffer;
   s_video_buffer_write_ptr = s_video_buffer;
   s_video_buffer_seen_ptr = s_video_buffer;
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/FramebufferManager.h"
 
+#include <chrono>
 #include <fmt/format.h>
 #include <memory>
 
@@ -18,6 +19,7 @@
 #include "VideoCommon/DriverDetails.h"
 #include "VideoCommon/FramebufferShaderGen.h"
 #include "VideoCommon/RenderBase.h"
+#include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
@@ -388,8 +390,12 @@ u32 FramebufferManager::PeekEFBColor(u32 x, u32 y)
     y = EFB_HEIGHT - 1 - y;
 
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(false, x, y, &tile_index))
+  const bool miss = !IsEFBCacheTilePresent(false, x, y, &tile_index);
+  if (miss)
     PopulateEFBCache(false, tile_index);
+  else if (m_efb_color_cache.readback_pending)
+    WaitForEFBCacheReadback(m_efb_color_cache);
+  RecordEFBPeek(false, tile_index, miss);
 
   u32 value;
   m_efb_color_cache.readback_texture->ReadTexel(x, y, &value);
@@ -403,8 +409,12 @@ float FramebufferManager::PeekEFBDepth(u32 x, u32 y)
     y = EFB_HEIGHT - 1 - y;
 
   u32 tile_index;
-  if (!IsEFBCacheTilePresent(true, x, y, &tile_index))
+  const bool miss = !IsEFBCacheTilePresent(true, x, y, &tile_index);
+  if (miss)
     PopulateEFBCache(true, tile_index);
+  else if (m_efb_depth_cache.readback_pending)
+    WaitForEFBCacheReadback(m_efb_depth_cache);
+  RecordEFBPeek(true, tile_index, miss);
 
   float value;
   m_efb_depth_cache.readback_texture->ReadTexel(x, y, &value);
@@ -564,11 +574,12 @@ bool FramebufferManager::CreateReadbackFramebuffer()
   if (!m_efb_color_cache.readback_texture || !m_efb_depth_cache.readback_texture)
     return false;
 
+  u32 total_tiles = 1;
   if (IsUsingTiledEFBCache())
   {
     const u32 tiles_wide = ((EFB_WIDTH + (m_efb_cache_tile_size - 1)) / m_efb_cache_tile_size);
     const u32 tiles_high = ((EFB_HEIGHT + (m_efb_cache_tile_size - 1)) / m_efb_cache_tile_size);
-    const u32 total_tiles = tiles_wide * tiles_high;
+    total_tiles = tiles_wide * tiles_high;
     m_efb_color_cache.tiles.resize(total_tiles);
     std::fill(m_efb_color_cache.tiles.begin(), m_efb_color_cache.tiles.end(), false);
     m_efb_depth_cache.tiles.resize(total_tiles);
@@ -576,6 +587,9 @@ bool FramebufferManager::CreateReadbackFramebuffer()
     m_efb_cache_tiles_wide = tiles_wide;
   }
 
+  // Both the cached tiles and the recorded peeks are gone with the old readback textures.
+  m_efb_peek_predictor.Reset(total_tiles);
+
   return true;
 }
 
@@ -586,6 +600,7 @@ void FramebufferManager::DestroyReadbackFramebuffer()
     data.framebuffer.reset();
     data.texture.reset();
     data.valid = false;
+    data.readback_pending = false;
   };
   DestroyCache(m_efb_color_cache);
   DestroyCache(m_efb_depth_cache);
@@ -595,6 +610,12 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
 {
   g_vertex_manager->OnCPUEFBAccess();
 
+  CopyEFBCacheTile(depth, tile_index);
+  WaitForEFBCacheReadback(depth ? m_efb_depth_cache : m_efb_color_cache);
+}
+
+void FramebufferManager::CopyEFBCacheTile(bool depth, u32 tile_index)
+{
   // Force the path through the intermediate texture, as we can't do an image copy from a depth
   // buffer directly to a staging texture (must be the whole resource).
   const bool force_intermediate_copy =
@@ -649,14 +670,56 @@ void FramebufferManager::PopulateEFBCache(bool depth, u32 tile_index)
     data.readback_texture->CopyFromTexture(src_texture, rect, 0, 0, rect);
   }
 
-  // Wait until the copy is complete.
-  data.readback_texture->Flush();
   data.valid = true;
   data.out_of_date = false;
+  data.readback_pending = true;
   if (IsUsingTiledEFBCache())
     data.tiles[tile_index] = true;
 }
 
+void FramebufferManager::WaitForEFBCacheReadback(EFBCacheData& data)
+{
+  const auto start = std::chrono::steady_clock::now();
+  data.readback_texture->Flush();
+  data.readback_pending = false;
+  ADDSTAT(g_stats.this_frame.efb_peek_stall_ns,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() -
+                                                               start)
+              .count());
+}
+
+void FramebufferManager::RecordEFBPeek(bool depth, u32 tile_index, bool miss)
+{
+  if (!g_ActiveConfig.bEFBAccessPrefetch)
+    return;
+
+  if (m_efb_peek_predictor.OnPeek(depth, tile_index, g_vertex_manager->GetDrawCounter(), miss))
+    INCSTAT(g_stats.this_frame.num_efb_peeks_prefetched);
+}
+
+void FramebufferManager::OnDraw(u32 draw_counter)
+{
+  bool copied = false;
+  m_efb_peek_predictor.OnDraw(draw_counter, [&](bool depth, u32 tile_index) {
+    const EFBCacheData& data = depth ? m_efb_depth_cache : m_efb_color_cache;
+    if (data.valid && (!IsUsingTiledEFBCache() || data.tiles[tile_index]))
+      return false;
+
+    CopyEFBCacheTile(depth, tile_index);
+    copied = true;
+    return true;
+  });
+
+  // Submit the copies now, so that they have completed by the time the CPU peeks.
+  if (copied)
+    g_renderer->Flush();
+}
+
+void FramebufferManager::OnEndFrame()
+{
+  m_efb_peek_predictor.OnEndFrame();
+}
+
 void FramebufferManager::ClearEFB(const MathUtil::Rectangle<int>& rc, bool clear_color,
                                   bool clear_alpha, bool clear_z, u32 color, u32 z)
 {
@@ -759,7 +822,11 @@ void FramebufferManager::PokeEFBColor(u32 x, u32 y, u32 color)
   // Update the peek cache if it's valid, since we know the color of the pixel now.
   u32 tile_index;
   if (IsEFBCacheTilePresent(false, x, y, &tile_index))
+  {
+    if (m_efb_color_cache.readback_pending)
+      WaitForEFBCacheReadback(m_efb_color_cache);
     m_efb_color_cache.readback_texture->WriteTexel(x, y, &color);
+  }
 }
 
 void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
@@ -777,7 +844,11 @@ void FramebufferManager::PokeEFBDepth(u32 x, u32 y, float depth)
   // Update the peek cache if it's valid, since we know the color of the pixel now.
   u32 tile_index;
   if (IsEFBCacheTilePresent(true, x, y, &tile_index))
+  {
+    if (m_efb_depth_cache.readback_pending)
+      WaitForEFBCacheReadback(m_efb_depth_cache);
     m_efb_depth_cache.readback_texture->WriteTexel(x, y, &depth);
+  }
 }
 
 void FramebufferManager::CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x,
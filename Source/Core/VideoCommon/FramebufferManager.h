@@ -14,6 +14,7 @@
 #include "VideoCommon/AbstractPipeline.h"
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/EFBPeekPredictor.h"
 #include "VideoCommon/RenderState.h"
 #include "VideoCommon/TextureConfig.h"
 
@@ -101,6 +102,11 @@ public:
   void InvalidatePeekCache(bool forced = true);
   void FlagPeekCacheAsOutOfDate();
 
+  // Readback prediction - reads back the tiles which were peeked after the same draw in the last
+  // frame without waiting for them, so that the peeks find them already resident.
+  void OnDraw(u32 draw_counter);
+  void OnEndFrame();
+
   // Writes a value to the framebuffer. This will never block, and writes will be batched.
   void PokeEFBColor(u32 x, u32 y, u32 color);
   void PokeEFBDepth(u32 x, u32 y, float depth);
@@ -128,6 +134,8 @@ protected:
     std::vector<bool> tiles;
     bool out_of_date;
     bool valid;
+    // A copy into readback_texture was issued, but not waited for yet.
+    bool readback_pending;
   };
 
   bool CreateEFBFramebuffer();
@@ -152,6 +160,9 @@ protected:
   bool IsEFBCacheTilePresent(bool depth, u32 x, u32 y, u32* tile_index) const;
   MathUtil::Rectangle<int> GetEFBCacheTileRect(u32 tile_index) const;
   void PopulateEFBCache(bool depth, u32 tile_index);
+  void CopyEFBCacheTile(bool depth, u32 tile_index);
+  void WaitForEFBCacheReadback(EFBCacheData& data);
+  void RecordEFBPeek(bool depth, u32 tile_index, bool miss);
 
   void CreatePokeVertices(std::vector<EFBPokeVertex>* destination_list, u32 x, u32 y, float z,
                           u32 color);
@@ -185,6 +196,8 @@ protected:
   EFBCacheData m_efb_color_cache = {};
   EFBCacheData m_efb_depth_cache = {};
 
+  EFBPeekPredictor m_efb_peek_predictor;
+
   // EFB clear pipelines
   // Indexed by [color_write_enabled][alpha_write_enabled][depth_write_enabled]
   std::array<std::array<std::array<std::unique_ptr<AbstractPipeline>, 2>, 2>, 2>
@@ -58,6 +58,14 @@ ShaderCode GenerateGeometryShaderCode(APIType api_type, const ShaderHostConfig&
                                       const geometry_shader_uid_data* uid_data)
 {
   ShaderCode out;
+  GenerateGeometryShaderCode(out, api_type, host_config, uid_data);
+  return out;
+}
+
+void GenerateGeometryShaderCode(ShaderCode& out, APIType api_type,
+                                const ShaderHostConfig& host_config,
+                                const geometry_shader_uid_data* uid_data)
+{
   // Non-uid template parameters will write to the dummy data (=> gets optimized out)
 
   const bool wireframe = host_config.wireframe;
@@ -320,8 +328,6 @@ ShaderCode GenerateGeometryShaderCode(APIType api_type, const ShaderHostConfig&
     out.Write("\t}}\n");
 
   out.Write("}}\n");
-
-  return out;
 }
 
 static void EmitVertex(ShaderCode& out, const ShaderHostConfig& host_config,
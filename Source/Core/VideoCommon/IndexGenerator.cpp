@@ -7,15 +7,99 @@
 #include <cstddef>
 #include <cstring>
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #include "Common/CommonTypes.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "VideoCommon/OpcodeDecoding.h"
-#include "VideoCommon/VideoConfig.h"
 
 namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// The indices written by one iteration of a generator's vectorized loop. Each index is the first
+// vertex of the primitive plus an offset, and advances by its step in every iteration. Primitive
+// restart indices use an offset of s_primitive_restart and a step of 0.
+template <size_t N>
+struct IndexPattern
+{
+  static_assert(N % 8 == 0, "Patterns have to fill whole vectors");
+
+  std::array<u16, N> offsets{};
+  std::array<u16, N> steps{};
+};
+
+// Writes the pattern the given number of times, which produces exactly the same indices as the
+// scalar loops the pattern was taken from.
+template <size_t N>
+u16* AddPattern(u16* index_ptr, u32 iterations, u32 index, const IndexPattern<N>& pattern)
+{
+  constexpr size_t num_vectors = N / 8;
+
+#if defined(_M_X86_64)
+  const __m128i index_vec = _mm_set1_epi16(static_cast<s16>(index));
+  const __m128i restart = _mm_set1_epi16(static_cast<s16>(s_primitive_restart));
+  __m128i indices[num_vectors];
+  __m128i steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    const __m128i offsets =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.offsets.data() + i * 8));
+    const __m128i is_restart = _mm_cmpeq_epi16(offsets, restart);
+    indices[i] = _mm_add_epi16(offsets, _mm_andnot_si128(is_restart, index_vec));
+    steps[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pattern.steps.data() + i * 8));
+  }
+
+  for (u32 i = 0; i < iterations; i++)
+  {
+    for (size_t j = 0; j < num_vectors; j++)
+    {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(index_ptr + j * 8), indices[j]);
+      indices[j] = _mm_add_epi16(indices[j], steps[j]);
+    }
+    index_ptr += N;
+  }
+#elif defined(_M_ARM_64)
+  const uint16x8_t index_vec = vdupq_n_u16(static_cast<u16>(index));
+  const uint16x8_t restart = vdupq_n_u16(s_primitive_restart);
+  uint16x8_t indices[num_vectors];
+  uint16x8_t steps[num_vectors];
+  for (size_t i = 0; i < num_vectors; i++)
+  {
+    const uint16x8_t offsets = vld1q_u16(pattern.offsets.data() + i * 8);
+    const uint16x8_t is_restart = vceqq_u16(offsets, restart);
+    indices[i] = vaddq_u16(offsets, vbicq_u16(index_vec, is_restart));
+    steps[i] = vld1q_u16(pattern.steps.data() + i * 8);
+  }
+
+  for (u32 i = 0; i < iterations; i++)
+  {
+    for (size_t j = 0; j < num_vectors; j++)
+    {
+      vst1q_u16(index_ptr + j * 8, indices[j]);
+      indices[j] = vaddq_u16(indices[j], steps[j]);
+    }
+    index_ptr += N;
+  }
+#else
+  for (u32 i = 0; i < iterations; i++)
+  {
+    for (size_t j = 0; j < N; j++)
+    {
+      const u16 offset = pattern.offsets[j];
+      *index_ptr++ = offset == s_primitive_restart ?
+                         s_primitive_restart :
+                         static_cast<u16>(index + offset + i * pattern.steps[j]);
+    }
+  }
+#endif
+
+  return index_ptr;
+}
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -37,12 +121,42 @@ u16* AddList(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+// 8 vertices of a strip with primitive restart.
+constexpr auto s_strip_pr_pattern = [] {
+  IndexPattern<8> pattern;
+  for (u16 i = 0; i < 8; i++)
+  {
+    pattern.offsets[i] = i;
+    pattern.steps[i] = 8;
+  }
+  return pattern;
+}();
+
+// 8 triangles of a strip, alternating the winding.
+constexpr auto s_strip_pattern = [] {
+  IndexPattern<24> pattern;
+  for (u16 i = 0; i < 4; i++)
+  {
+    const u16 first = i * 2;
+    const std::array<u16, 6> offsets{first,          u16(first + 1), u16(first + 2),
+                                     u16(first + 1), u16(first + 3), u16(first + 2)};
+    for (size_t j = 0; j < offsets.size(); j++)
+    {
+      pattern.offsets[i * 6 + j] = offsets[j];
+      pattern.steps[i * 6 + j] = 8;
+    }
+  }
+  return pattern;
+}();
+
 template <bool pr>
 u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
   if constexpr (pr)
   {
-    for (u32 i = 0; i < num_verts; ++i)
+    const u32 iterations = num_verts / 8;
+    index_ptr = AddPattern(index_ptr, iterations, index, s_strip_pr_pattern);
+    for (u32 i = iterations * 8; i < num_verts; ++i)
     {
       *index_ptr++ = index + i;
     }
@@ -50,8 +164,12 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
+    // Whole iterations always cover an even number of triangles, so the winding starts over.
+    const u32 iterations = num_verts > 2 ? (num_verts - 2) / 8 : 0;
+    index_ptr = AddPattern(index_ptr, iterations, index, s_strip_pattern);
+
     bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    for (u32 i = 2 + iterations * 8; i < num_verts; ++i)
     {
       index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
 
@@ -61,6 +179,38 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+// 4 groups of 3 fan triangles as strips, as in the primitive restart loop below.
+constexpr auto s_fan_pr_pattern = [] {
+  IndexPattern<24> pattern;
+  for (u16 i = 0; i < 4; i++)
+  {
+    const u16 vertex = 2 + i * 3;
+    const std::array<u16, 6> offsets{u16(vertex - 1), vertex,          0,
+                                     u16(vertex + 1), u16(vertex + 2), s_primitive_restart};
+    for (size_t j = 0; j < offsets.size(); j++)
+    {
+      pattern.offsets[i * 6 + j] = offsets[j];
+      pattern.steps[i * 6 + j] = (j == 2 || j == 5) ? 0 : 12;
+    }
+  }
+  return pattern;
+}();
+
+// 8 fan triangles, which all share the first vertex.
+constexpr auto s_fan_pattern = [] {
+  IndexPattern<24> pattern;
+  for (u16 i = 0; i < 8; i++)
+  {
+    pattern.offsets[i * 3] = 0;
+    pattern.offsets[i * 3 + 1] = i + 1;
+    pattern.offsets[i * 3 + 2] = i + 2;
+    pattern.steps[i * 3] = 0;
+    pattern.steps[i * 3 + 1] = 8;
+    pattern.steps[i * 3 + 2] = 8;
+  }
+  return pattern;
+}();
+
 /**
  * FAN simulator:
  *
@@ -87,6 +237,10 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
 
   if constexpr (pr)
   {
+    const u32 iterations = num_verts > 2 ? (num_verts - 2) / 12 : 0;
+    index_ptr = AddPattern(index_ptr, iterations, index, s_fan_pr_pattern);
+    i += iterations * 12;
+
     for (; i + 3 <= num_verts; i += 3)
     {
       *index_ptr++ = index + i - 1;
@@ -106,6 +260,12 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
       *index_ptr++ = s_primitive_restart;
     }
   }
+  else
+  {
+    const u32 iterations = num_verts > 2 ? (num_verts - 2) / 8 : 0;
+    index_ptr = AddPattern(index_ptr, iterations, index, s_fan_pattern);
+    i += iterations * 8;
+  }
 
   for (; i < num_verts; ++i)
   {
@@ -114,6 +274,40 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+// 8 quads as strips, separated by primitive restart.
+constexpr auto s_quads_pr_pattern = [] {
+  IndexPattern<40> pattern;
+  for (u16 i = 0; i < 8; i++)
+  {
+    const u16 first = i * 4;
+    const std::array<u16, 5> offsets{u16(first + 1), u16(first + 2), first, u16(first + 3),
+                                     s_primitive_restart};
+    for (size_t j = 0; j < offsets.size(); j++)
+    {
+      pattern.offsets[i * 5 + j] = offsets[j];
+      pattern.steps[i * 5 + j] = j == 4 ? 0 : 32;
+    }
+  }
+  return pattern;
+}();
+
+// 4 quads as pairs of triangles.
+constexpr auto s_quads_pattern = [] {
+  IndexPattern<24> pattern;
+  for (u16 i = 0; i < 4; i++)
+  {
+    const u16 first = i * 4;
+    const std::array<u16, 6> offsets{first, u16(first + 1), u16(first + 2),
+                                     first, u16(first + 2), u16(first + 3)};
+    for (size_t j = 0; j < offsets.size(); j++)
+    {
+      pattern.offsets[i * 6 + j] = offsets[j];
+      pattern.steps[i * 6 + j] = 16;
+    }
+  }
+  return pattern;
+}();
+
 /*
  * QUAD simulator
  *
@@ -135,6 +329,19 @@ template <bool pr>
 u16* AddQuads(u16* index_ptr, u32 num_verts, u32 index)
 {
   u32 i = 3;
+  if constexpr (pr)
+  {
+    const u32 iterations = num_verts / 32;
+    index_ptr = AddPattern(index_ptr, iterations, index, s_quads_pr_pattern);
+    i += iterations * 32;
+  }
+  else
+  {
+    const u32 iterations = num_verts / 16;
+    index_ptr = AddPattern(index_ptr, iterations, index, s_quads_pattern);
+    i += iterations * 16;
+  }
+
   for (; i < num_verts; i += 4)
   {
     if constexpr (pr)
@@ -178,11 +385,27 @@ u16* AddLineList(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+// 4 lines of a strip.
+constexpr auto s_line_strip_pattern = [] {
+  IndexPattern<8> pattern;
+  for (u16 i = 0; i < 4; i++)
+  {
+    pattern.offsets[i * 2] = i;
+    pattern.offsets[i * 2 + 1] = i + 1;
+    pattern.steps[i * 2] = 4;
+    pattern.steps[i * 2 + 1] = 4;
+  }
+  return pattern;
+}();
+
 // Shouldn't be used as strips as LineLists are much more common
 // so converting them to lists
 u16* AddLineStrip(u16* index_ptr, u32 num_verts, u32 index)
 {
-  for (u32 i = 1; i < num_verts; ++i)
+  const u32 iterations = num_verts > 1 ? (num_verts - 1) / 4 : 0;
+  index_ptr = AddPattern(index_ptr, iterations, index, s_line_strip_pattern);
+
+  for (u32 i = 1 + iterations * 4; i < num_verts; ++i)
   {
     *index_ptr++ = index + i - 1;
     *index_ptr++ = index + i;
@@ -200,11 +423,11 @@ u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
 }
 }  // Anonymous namespace
 
-void IndexGenerator::Init()
+void IndexGenerator::Init(bool primitive_restart)
 {
   using OpcodeDecoder::Primitive;
 
-  if (g_Config.backend_info.bSupportsPrimitiveRestart)
+  if (primitive_restart)
   {
     m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<true>;
     m_primitive_table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
@@ -10,10 +10,13 @@
 // Note that it IS NOT GENERALLY POSSIBLE to precompile display lists! You can compile them as they
 // are while interpreting them, and hope that the vertex format doesn't change, though, if you do
 // it right when they are called. The reason is that the vertex format affects the sizes of the
-// vertices.
+// vertices. DisplayListCache does the latter, checking that neither the commands nor the vertex
+// format changed since the last call.
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <chrono>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
@@ -22,22 +25,26 @@
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/DisplayListCache.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 #include "VideoCommon/XFMemory.h"
 #include "VideoCommon/XFStructs.h"
 
 namespace OpcodeDecoder
 {
 static bool s_is_fifo_error_seen = false;
+static DisplayListCache s_display_list_cache;
 bool g_record_fifo_data = false;
 
 void Init()
 {
   s_is_fifo_error_seen = false;
+  s_display_list_cache.Clear();
 }
 
 template <bool is_preprocess>
@@ -59,6 +66,16 @@ public:
   {
     m_cycles += 12;
     const u8 sub_command = command & CP_COMMAND_MASK;
+
+    // Games often rewrite the vertex format between draws without changing it, which doesn't
+    // require looking up loaders or array pointers again.
+    if (GetCPState().IsRedundantWrite(command, value))
+    {
+      if constexpr (!is_preprocess)
+        INCSTAT(g_stats.this_frame.num_cp_loads);
+      return;
+    }
+
     if constexpr (!is_preprocess)
     {
       if (sub_command == MATINDEX_A)
@@ -128,7 +145,8 @@ public:
     // HACK
     DataReader src{const_cast<u8*>(vertex_data), const_cast<u8*>(vertex_data) + size};
     const u32 bytes =
-        VertexLoaderManager::RunVertices(vat, primitive, num_vertices, src, is_preprocess);
+        VertexLoaderManager::RunVertices(vat, primitive, num_vertices, src, is_preprocess,
+                                         m_in_display_list);
 
     ASSERT(bytes == size);
 
@@ -176,7 +194,8 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
-          Run(start_address, size, *this);
+          if (s_display_list_cache.Run(address, start_address, size, *this))
+            INCSTAT(g_stats.this_frame.num_dlists_replayed);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
           // un-swap
@@ -253,8 +272,21 @@ u8* RunFifo(DataReader src, u32* cycles)
 {
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
+
+  const bool measure_time = !is_preprocess && g_ActiveConfig.bOverlayStats;
+  const auto start = measure_time ? std::chrono::steady_clock::now() :
+                                    std::chrono::steady_clock::time_point();
+
   u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
 
+  if (measure_time)
+  {
+    ADDSTAT(g_stats.this_frame.command_processing_ns,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+  }
+
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
 
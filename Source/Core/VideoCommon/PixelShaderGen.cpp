@@ -864,7 +864,13 @@ ShaderCode GeneratePixelShaderCode(APIType api_type, const ShaderHostConfig& hos
                                    const pixel_shader_uid_data* uid_data)
 {
   ShaderCode out;
+  GeneratePixelShaderCode(out, api_type, host_config, uid_data);
+  return out;
+}
 
+void GeneratePixelShaderCode(ShaderCode& out, APIType api_type, const ShaderHostConfig& host_config,
+                             const pixel_shader_uid_data* uid_data)
+{
   const bool per_pixel_lighting = g_ActiveConfig.bEnablePixelLighting;
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
@@ -1327,8 +1333,6 @@ ShaderCode GeneratePixelShaderCode(APIType api_type, const ShaderHostConfig& hos
     out.Write("\tUpdateBoundingBox(rawpos.xy);\n");
 
   out.Write("}}\n");
-
-  return out;
 }
 
 static void WriteStage(ShaderCode& out, const pixel_shader_uid_data* uid_data, int n,
@@ -25,6 +25,9 @@ std::unique_ptr<VideoCommon::ShaderCache> g_shader_cache;
 
 namespace VideoCommon
 {
+constexpr u32 UID_CACHE_FILE_MAGIC = 0x44495550;  // PUID
+constexpr size_t UID_CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+
 ShaderCache::ShaderCache() : m_api_type{APIType::Nothing}
 {
 }
@@ -97,6 +100,31 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+  CancelStalePipelineCompiles();
+  if (g_ActiveConfig.bOverlayStats)
+    UpdateCompilerStatistics();
+
+  m_async_shader_compiler->AdvanceFrame();
+}
+
+void ShaderCache::CancelStalePipelineCompiles()
+{
+  const u64 current_frame = m_async_shader_compiler->GetCurrentFrame();
+  for (auto& [uid, on_demand] : m_on_demand_pipelines)
+  {
+    if (on_demand.work_item && current_frame - on_demand.last_used_frame > STALE_PIPELINE_FRAMES)
+      on_demand.work_item->Cancel();
+  }
+}
+
+void ShaderCache::UpdateCompilerStatistics()
+{
+  const AsyncShaderCompiler::Metrics metrics = m_async_shader_compiler->GetMetrics();
+  SETSTAT(g_stats.num_shader_compiles_queued, metrics.queue_depth);
+  SETSTAT(g_stats.num_shader_compiles_cancelled, metrics.num_cancelled);
+  SETSTAT(g_stats.num_shader_compile_deadlines_missed, metrics.num_deadlines_missed);
+  g_stats.shader_compile_latency_p50_us = metrics.latency_p50.count();
+  g_stats.shader_compile_latency_p99_us = metrics.latency_p99.count();
 }
 
 void ShaderCache::Shutdown()
@@ -133,12 +161,26 @@ std::optional<const AbstractPipeline*> ShaderCache::GetPipelineForUidAsync(const
     // .second is the pending flag, i.e. compiling in the background.
     if (!it->second.second)
       return it->second.first.get();
-    else
-      return {};
+
+    // Still needed, so don't cancel it, or queue it again if it was cancelled already.
+    auto on_demand_it = m_on_demand_pipelines.find(uid);
+    if (on_demand_it != m_on_demand_pipelines.end())
+    {
+      on_demand_it->second.last_used_frame = m_async_shader_compiler->GetCurrentFrame();
+      if (!on_demand_it->second.work_item)
+      {
+        QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE,
+                             m_async_shader_compiler->GetCurrentFrame() + 1);
+      }
+    }
+    return {};
   }
 
+  // The pipeline is needed by the next frame, so that we use the ubershader for as few frames as
+  // possible.
   AppendGXPipelineUID(uid);
-  QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE);
+  QueuePipelineCompile(uid, COMPILE_PRIORITY_ONDEMAND_PIPELINE,
+                       m_async_shader_compiler->GetCurrentFrame() + 1);
   return {};
 }
 
@@ -372,6 +414,7 @@ void ShaderCache::LoadCaches()
 void ShaderCache::ClearCaches()
 {
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
+  m_on_demand_pipelines.clear();
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
   ClearShaderCache(m_ps_cache);
@@ -409,7 +452,8 @@ void ShaderCache::CompileMissingPipelines()
   for (auto& it : m_gx_pipeline_cache)
   {
     if (!it.second.first)
-      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
+      QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE,
+                           AsyncShaderCompiler::NO_DEADLINE);
   }
   for (auto& it : m_gx_uber_pipeline_cache)
   {
@@ -418,33 +462,42 @@ void ShaderCache::CompileMissingPipelines()
   }
 }
 
+// Shaders are generated on the compiler threads as well as the GPU thread. Each thread keeps one
+// buffer to generate into, which stops allocating once it has grown to fit the largest shader.
+static ShaderCode& GetShaderCodeBuffer()
+{
+  thread_local ShaderCode buffer;
+  buffer.Clear();
+  return buffer;
+}
+
 std::unique_ptr<AbstractShader> ShaderCache::CompileVertexShader(const VertexShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      GenerateVertexShaderCode(m_api_type, m_host_config, uid.GetUidData());
+  ShaderCode& source_code = GetShaderCodeBuffer();
+  GenerateVertexShaderCode(source_code, m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
 }
 
 std::unique_ptr<AbstractShader>
 ShaderCache::CompileVertexUberShader(const UberShader::VertexShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      UberShader::GenVertexShader(m_api_type, m_host_config, uid.GetUidData());
+  ShaderCode& source_code = GetShaderCodeBuffer();
+  UberShader::GenVertexShader(source_code, m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Vertex, source_code.GetBuffer());
 }
 
 std::unique_ptr<AbstractShader> ShaderCache::CompilePixelShader(const PixelShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      GeneratePixelShaderCode(m_api_type, m_host_config, uid.GetUidData());
+  ShaderCode& source_code = GetShaderCodeBuffer();
+  GeneratePixelShaderCode(source_code, m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
 }
 
 std::unique_ptr<AbstractShader>
 ShaderCache::CompilePixelUberShader(const UberShader::PixelShaderUid& uid) const
 {
-  const ShaderCode source_code =
-      UberShader::GenPixelShader(m_api_type, m_host_config, uid.GetUidData());
+  ShaderCode& source_code = GetShaderCodeBuffer();
+  UberShader::GenPixelShader(source_code, m_api_type, m_host_config, uid.GetUidData());
   return g_renderer->CreateShaderFromSource(ShaderStage::Pixel, source_code.GetBuffer());
 }
 
@@ -538,8 +591,8 @@ const AbstractShader* ShaderCache::InsertPixelUberShader(const UberShader::Pixel
 
 const AbstractShader* ShaderCache::CreateGeometryShader(const GeometryShaderUid& uid)
 {
-  const ShaderCode source_code =
-      GenerateGeometryShaderCode(m_api_type, m_host_config, uid.GetUidData());
+  ShaderCode& source_code = GetShaderCodeBuffer();
+  GenerateGeometryShaderCode(source_code, m_api_type, m_host_config, uid.GetUidData());
   std::unique_ptr<AbstractShader> shader =
       g_renderer->CreateShaderFromSource(ShaderStage::Geometry, source_code.GetBuffer(),
                                          fmt::format("Geometry shader: {}", *uid.GetUidData()));
@@ -728,52 +781,63 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
+std::string ShaderCache::GetPipelineUIDCacheFilename(const std::string& game_id)
+{
+  return File::GetUserPath(D_CACHE_IDX) + game_id + ".uidcache";
+}
+
+bool ShaderCache::ReadPipelineUIDCache(File::IOFile& file,
+                                       std::vector<SerializedGXPipelineUid>* uids)
+{
+  // Validate the version before reading entries.
+  u32 existing_magic;
+  u32 existing_version;
+  if (!file.ReadBytes(&existing_magic, sizeof(existing_magic)) ||
+      !file.ReadBytes(&existing_version, sizeof(existing_version)) ||
+      existing_magic != UID_CACHE_FILE_MAGIC || existing_version != GX_PIPELINE_UID_VERSION)
+  {
+    return false;
+  }
+
+  // Ensure the expected size matches the actual size of the file. If it doesn't, it means
+  // the cache file may be corrupted, and we should not proceed with loading potentially
+  // garbage or invalid UIDs.
+  const u64 file_size = file.GetSize();
+  const size_t uid_count =
+      static_cast<size_t>(file_size - UID_CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
+  const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + UID_CACHE_HEADER_SIZE;
+  if (file_size != expected_size)
+    return false;
+
+  for (size_t i = 0; i < uid_count; i++)
+  {
+    SerializedGXPipelineUid serialized_uid;
+    if (!file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+      return false;
+    uids->push_back(serialized_uid);
+  }
+
+  // The file may be open for reading and writing, so we must seek to the end before writing.
+  return file.Seek(expected_size, SEEK_SET);
+}
+
+bool ShaderCache::WritePipelineUIDCacheHeader(File::IOFile& file)
+{
+  return file.WriteBytes(&UID_CACHE_FILE_MAGIC, sizeof(UID_CACHE_FILE_MAGIC)) &&
+         file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION));
+}
+
 void ShaderCache::LoadPipelineUIDCache()
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
-  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
+  const std::string filename = GetPipelineUIDCacheFilename(SConfig::GetInstance().GetGameID());
   if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
   {
-    // If an existing case exists, validate the version before reading entries.
-    u32 existing_magic;
-    u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
-    {
-      // Ensure the expected size matches the actual size of the file. If it doesn't, it means
-      // the cache file may be corrupted, and we should not proceed with loading potentially
-      // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
-      const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
-      uid_file_valid = file_size == expected_size;
-      if (uid_file_valid)
-      {
-        for (size_t i = 0; i < uid_count; i++)
-        {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
-          {
-            // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
-          }
-          else
-          {
-            uid_file_valid = false;
-            break;
-          }
-        }
-      }
+    std::vector<SerializedGXPipelineUid> uids;
+    const bool uid_file_valid = ReadPipelineUIDCache(m_gx_pipeline_uid_cache_file, &uids);
 
-      // We open the file for reading and writing, so we must seek to the end before writing.
-      if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, SEEK_SET);
-    }
+    // This just adds the pipelines to the map, they are compiled later.
+    for (const SerializedGXPipelineUid& uid : uids)
+      AddSerializedGXPipelineUID(uid);
 
     // If the file is invalid, close it. We re-open and truncate it below.
     if (!uid_file_valid)
@@ -786,9 +850,7 @@ void ShaderCache::LoadPipelineUIDCache()
     if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
     {
       // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
+      WritePipelineUIDCacheHeader(m_gx_pipeline_uid_cache_file);
 
       // Write any current UIDs out to the file.
       // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
@@ -835,7 +897,8 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
   }
 }
 
-void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
+void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority,
+                                          u64 deadline)
 {
   class VertexShaderWorkItem final : public AsyncShaderCompiler::WorkItem
   {
@@ -861,7 +924,7 @@ void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 prior
 
   m_vs_cache.shader_map[uid].pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<VertexShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority, deadline);
 }
 
 void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority)
@@ -893,7 +956,8 @@ void ShaderCache::QueueVertexUberShaderCompile(const UberShader::VertexShaderUid
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
-void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority)
+void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority,
+                                          u64 deadline)
 {
   class PixelShaderWorkItem final : public AsyncShaderCompiler::WorkItem
   {
@@ -919,7 +983,7 @@ void ShaderCache::QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priorit
 
   m_ps_cache.shader_map[uid].pending = true;
   auto wi = m_async_shader_compiler->CreateWorkItem<PixelShaderWorkItem>(this, uid);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority, deadline);
 }
 
 void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority)
@@ -951,13 +1015,14 @@ void ShaderCache::QueuePixelUberShaderCompile(const UberShader::PixelShaderUid&
   m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
 }
 
-void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
+void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority, u64 deadline)
 {
   class PipelineWorkItem final : public AsyncShaderCompiler::WorkItem
   {
   public:
-    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_)
-        : shader_cache(shader_cache_), uid(uid_), priority(priority_)
+    PipelineWorkItem(ShaderCache* shader_cache_, const GXPipelineUid& uid_, u32 priority_,
+                     u64 deadline_)
+        : shader_cache(shader_cache_), uid(uid_), priority(priority_), deadline(deadline_)
     {
       // Check if all the stages required for this pipeline have been compiled.
       // If not, this work item becomes a no-op, and re-queues the pipeline for the next frame.
@@ -972,7 +1037,7 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       auto vs_it = shader_cache->m_vs_cache.shader_map.find(uid.vs_uid);
       stages_ready &= vs_it != shader_cache->m_vs_cache.shader_map.end() && !vs_it->second.pending;
       if (vs_it == shader_cache->m_vs_cache.shader_map.end())
-        shader_cache->QueueVertexShaderCompile(uid.vs_uid, priority);
+        shader_cache->QueueVertexShaderCompile(uid.vs_uid, priority, deadline);
 
       PixelShaderUid ps_uid = uid.ps_uid;
       ClearUnusedPixelShaderUidBits(shader_cache->m_api_type, shader_cache->m_host_config, &ps_uid);
@@ -980,13 +1045,14 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
       auto ps_it = shader_cache->m_ps_cache.shader_map.find(ps_uid);
       stages_ready &= ps_it != shader_cache->m_ps_cache.shader_map.end() && !ps_it->second.pending;
       if (ps_it == shader_cache->m_ps_cache.shader_map.end())
-        shader_cache->QueuePixelShaderCompile(ps_uid, priority);
+        shader_cache->QueuePixelShaderCompile(ps_uid, priority, deadline);
 
       return stages_ready;
     }
 
     bool Compile() override
     {
+      compiled = true;
       if (config)
         pipeline = g_renderer->CreatePipeline(*config);
       return true;
@@ -994,16 +1060,26 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
 
     void Retrieve() override
     {
-      if (stages_ready)
+      if (!compiled)
+      {
+        // Cancelled, leave the pipeline pending until it's drawn with again.
+        auto on_demand_it = shader_cache->m_on_demand_pipelines.find(uid);
+        if (on_demand_it != shader_cache->m_on_demand_pipelines.end())
+          on_demand_it->second.work_item = nullptr;
+      }
+      else if (stages_ready)
       {
+        shader_cache->m_on_demand_pipelines.erase(uid);
         shader_cache->InsertGXPipeline(uid, std::move(pipeline));
       }
       else
       {
         // Re-queue for next frame.
-        auto wi = shader_cache->m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(
-            shader_cache, uid, priority);
-        shader_cache->m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+        const u64 next_deadline =
+            deadline != AsyncShaderCompiler::NO_DEADLINE ?
+                shader_cache->m_async_shader_compiler->GetCurrentFrame() + 1 :
+                AsyncShaderCompiler::NO_DEADLINE;
+        shader_cache->QueuePipelineCompile(uid, priority, next_deadline);
       }
     }
 
@@ -1012,12 +1088,22 @@ void ShaderCache::QueuePipelineCompile(const GXPipelineUid& uid, u32 priority)
     std::unique_ptr<AbstractPipeline> pipeline;
     GXPipelineUid uid;
     u32 priority;
+    u64 deadline;
     std::optional<AbstractPipelineConfig> config;
     bool stages_ready;
+    bool compiled = false;
   };
 
-  auto wi = m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority);
-  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority);
+  auto wi =
+      m_async_shader_compiler->CreateWorkItem<PipelineWorkItem>(this, uid, priority, deadline);
+  if (deadline != AsyncShaderCompiler::NO_DEADLINE)
+  {
+    // Only the most recent work item of a pipeline is cancelled.
+    auto [on_demand_it, inserted] = m_on_demand_pipelines.try_emplace(
+        uid, OnDemandPipeline{nullptr, m_async_shader_compiler->GetCurrentFrame()});
+    on_demand_it->second.work_item = wi.get();
+  }
+  m_async_shader_compiler->QueueWorkItem(std::move(wi), priority, deadline);
   m_gx_pipeline_cache[uid].second = true;
 }
 
@@ -1134,22 +1220,23 @@ void ShaderCache::QueueUberShaderPipelines()
 
   // Populate the pipeline configs with empty entries, these will be compiled afterwards.
   UberShader::EnumerateVertexShaderUids([&](const UberShader::VertexShaderUid& vuid) {
-    UberShader::EnumeratePixelShaderUids([&](const UberShader::PixelShaderUid& puid) {
-      // UIDs must have compatible texgens, a mismatching combination will never be queried.
-      if (vuid.GetUidData()->num_texgens != puid.GetUidData()->num_texgens)
-        return;
-
-      UberShader::PixelShaderUid cleared_puid = puid;
-      UberShader::ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &cleared_puid);
-      EnumerateGeometryShaderUids([&](const GeometryShaderUid& guid) {
-        if (guid.GetUidData()->numTexGens != vuid.GetUidData()->num_texgens ||
-            (!guid.GetUidData()->IsPassthrough() && !m_host_config.backend_geometry_shaders))
-        {
-          return;
-        }
-        QueueDummyPipeline(vuid, guid, cleared_puid);
-      });
-    });
+    UberShader::EnumeratePixelShaderUids(
+        m_host_config, [&](const UberShader::PixelShaderUid& puid) {
+          // UIDs must have compatible texgens, a mismatching combination will never be queried.
+          if (vuid.GetUidData()->num_texgens != puid.GetUidData()->num_texgens)
+            return;
+
+          UberShader::PixelShaderUid cleared_puid = puid;
+          UberShader::ClearUnusedPixelShaderUidBits(m_api_type, m_host_config, &cleared_puid);
+          EnumerateGeometryShaderUids([&](const GeometryShaderUid& guid) {
+            if (guid.GetUidData()->numTexGens != vuid.GetUidData()->num_texgens ||
+                (!guid.GetUidData()->IsPassthrough() && !m_host_config.backend_geometry_shaders))
+            {
+              return;
+            }
+            QueueDummyPipeline(vuid, guid, cleared_puid);
+          });
+        });
   });
 }
 
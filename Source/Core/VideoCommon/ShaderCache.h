@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -112,6 +113,14 @@ public:
   // Texture decoding compute shaders
   const AbstractShader* GetTextureDecodingShader(TextureFormat format, TLUTFormat palette_format);
 
+  // The pipeline UID cache lists the pipelines a game has used, so that they can be compiled
+  // before they are needed next time. Unlike the shader caches, it doesn't depend on the driver.
+  static std::string GetPipelineUIDCacheFilename(const std::string& game_id);
+  // Reads all entries and leaves the file positioned at the end. Returns false if the file is
+  // corrupted or from a different version, in which case it should be rewritten.
+  static bool ReadPipelineUIDCache(File::IOFile& file, std::vector<SerializedGXPipelineUid>* uids);
+  static bool WritePipelineUIDCacheHeader(File::IOFile& file);
+
 private:
   static constexpr size_t NUM_PALETTE_CONVERSION_SHADERS = 3;
 
@@ -161,12 +170,14 @@ private:
   void AppendGXPipelineUID(const GXPipelineUid& config);
 
   // ASync Compiler Methods
-  void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
+  void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority, u64 deadline);
   void QueueVertexUberShaderCompile(const UberShader::VertexShaderUid& uid, u32 priority);
-  void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority);
+  void QueuePixelShaderCompile(const PixelShaderUid& uid, u32 priority, u64 deadline);
   void QueuePixelUberShaderCompile(const UberShader::PixelShaderUid& uid, u32 priority);
-  void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority);
+  void QueuePipelineCompile(const GXPipelineUid& uid, u32 priority, u64 deadline);
   void QueueUberPipelineCompile(const GXUberPipelineUid& uid, u32 priority);
+  void CancelStalePipelineCompiles();
+  void UpdateCompilerStatistics();
 
   // Populating various caches.
   template <ShaderStage stage, typename K, typename T>
@@ -190,6 +201,10 @@ private:
     COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
   };
 
+  // Pipelines compiled on demand are cancelled once nothing has drawn with them for this many
+  // frames, e.g. because the game moved on to another scene.
+  static constexpr u64 STALE_PIPELINE_FRAMES = 30;
+
   // Configuration bits.
   APIType m_api_type;
   ShaderHostConfig m_host_config = {};
@@ -227,6 +242,15 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
+
+  // Pending pipelines which were queued on demand. The work item is null once it was cancelled,
+  // in which case the pipeline is queued again the next time it's drawn with.
+  struct OnDemandPipeline
+  {
+    AsyncShaderCompiler::WorkItem* work_item;
+    u64 last_used_frame;
+  };
+  std::map<GXPipelineUid, OnDemandPipeline> m_on_demand_pipelines;
   LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
@@ -105,6 +105,10 @@ public:
   ShaderCode() { m_buffer.reserve(16384); }
   const std::string& GetBuffer() const { return m_buffer; }
 
+  // Empties the buffer, but keeps its storage. Once a reused ShaderCode has grown to fit the
+  // largest shader, generating shaders into it doesn't allocate any memory.
+  void Clear() { m_buffer.clear(); }
+
   // Writes format strings using fmtlib format strings.
   template <typename... Args>
   void Write(std::string_view format, Args&&... args)
@@ -173,6 +177,7 @@ union ShaderHostConfig
   BitField<24, 1, bool, u32> manual_texture_sampling;
   BitField<25, 1, bool, u32> manual_texture_sampling_custom_texture_sizes;
   BitField<26, 1, bool, u32> backend_sampler_lod_bias;
+  BitField<27, 1, bool, u32> ubershader_variants;
 
   static ShaderHostConfig GetCurrent();
 };
@@ -202,14 +207,60 @@ void AssignVSOutputMembers(ShaderCode& object, std::string_view a, std::string_v
 const char* GetInterpolationQualifier(bool msaa, bool ssaa, bool in_glsl_interface_block = false,
                                       bool in = false);
 
+// A bitfieldExtract call on a BitField member. It's formatted straight into the shader code, so
+// that no temporary string needs to be allocated for it.
+struct BitfieldExtractExpression
+{
+  std::string_view source;
+  bool is_signed;
+  u32 start_bit;
+  u32 num_bits;
+};
+
+template <>
+struct fmt::formatter<BitfieldExtractExpression>
+{
+  constexpr auto parse(format_parse_context& ctx) { return ctx.begin(); }
+  template <typename FormatContext>
+  auto format(const BitfieldExtractExpression& expr, FormatContext& ctx)
+  {
+    return fmt::format_to(ctx.out(), "bitfieldExtract({}({}), {}, {})",
+                          expr.is_signed ? "int" : "uint", expr.source, expr.start_bit,
+                          expr.num_bits);
+  }
+};
+
 // bitfieldExtract generator for BitField types
 template <auto ptr_to_bitfield_member>
-std::string BitfieldExtract(std::string_view source)
+constexpr BitfieldExtractExpression BitfieldExtract(std::string_view source)
 {
   using BitFieldT = Common::MemberType<ptr_to_bitfield_member>;
-  return fmt::format("bitfieldExtract({}({}), {}, {})", BitFieldT::IsSigned() ? "int" : "uint",
-                     source, static_cast<u32>(BitFieldT::StartBit()),
-                     static_cast<u32>(BitFieldT::NumBits()));
+  return {source, BitFieldT::IsSigned(), static_cast<u32>(BitFieldT::StartBit()),
+          static_cast<u32>(BitFieldT::NumBits())};
+}
+
+template <auto last_member>
+void WriteSwitchTree(ShaderCode& out, std::string_view variable,
+                     const Common::EnumMap<std::string_view, last_member>& values, u32 indent,
+                     u32 low, u32 high)
+{
+  // Each generated statement is for low <= x < high
+  if (high == low + 1)
+  {
+    // Down to 1 case (low <= x < low + 1 means x == low)
+    const auto key = static_cast<decltype(last_member)>(low);
+    // Note that this indentation behaves poorly for multi-line code
+    out.Write("{:{}}{}  // {}\n", "", indent, values[key], key);
+  }
+  else
+  {
+    const u32 mid = low + ((high - low) / 2);
+    out.Write("{:{}}if ({} < {}u) {{\n", "", indent, variable, mid);
+    WriteSwitchTree<last_member>(out, variable, values, indent + 2, low, mid);
+    out.Write("{:{}}}} else {{\n", "", indent);
+    WriteSwitchTree<last_member>(out, variable, values, indent + 2, mid, high);
+    out.Write("{:{}}}}\n", "", indent);
+  }
 }
 
 template <auto last_member, typename = decltype(last_member)>
@@ -245,28 +296,8 @@ void WriteSwitch(ShaderCode& out, APIType ApiType, std::string_view variable,
   else
   {
     // Generate a tree of if statements recursively
-    // std::function must be used because auto won't capture before initialization and thus can't be
-    // used recursively
-    std::function<void(u32, u32, u32)> BuildTree = [&](u32 cur_indent, u32 low, u32 high) {
-      // Each generated statement is for low <= x < high
-      if (high == low + 1)
-      {
-        // Down to 1 case (low <= x < low + 1 means x == low)
-        const enum_type key = static_cast<enum_type>(low);
-        // Note that this indentation behaves poorly for multi-line code
-        out.Write("{:{}}{}  // {}\n", "", cur_indent, values[key], key);
-      }
-      else
-      {
-        u32 mid = low + ((high - low) / 2);
-        out.Write("{:{}}if ({} < {}u) {{\n", "", cur_indent, variable, mid);
-        BuildTree(cur_indent + 2, low, mid);
-        out.Write("{:{}}}} else {{\n", "", cur_indent);
-        BuildTree(cur_indent + 2, mid, high);
-        out.Write("{:{}}}}\n", "", cur_indent);
-      }
-    };
-    BuildTree(indent, 0, static_cast<u32>(last_member) + 1);
+    WriteSwitchTree<last_member>(out, variable, values, indent, 0,
+                                 static_cast<u32>(last_member) + 1);
   }
 }
 
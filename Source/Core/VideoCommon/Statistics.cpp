@@ -3,10 +3,12 @@
 
 #include "VideoCommon/Statistics.h"
 
+#include <cinttypes>
 #include <utility>
 
 #include <imgui.h>
 
+#include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VideoCommon.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -14,9 +16,22 @@ Statistics g_stats;
 
 void Statistics::ResetFrame()
 {
+  if (this_frame.num_ubershader_draws != 0)
+    num_ubershader_frames++;
+
+  past_stage_times = GetTotalStageTimes();
   this_frame = {};
 }
 
+Statistics::StageTimes Statistics::GetTotalStageTimes() const
+{
+  return {past_stage_times.command_processing_ns + this_frame.command_processing_ns,
+          past_stage_times.vertex_loading_ns + this_frame.vertex_loading_ns,
+          past_stage_times.texture_loading_ns + this_frame.texture_loading_ns,
+          past_stage_times.draw_submission_ns + this_frame.draw_submission_ns,
+          past_stage_times.efb_copy_ns + this_frame.efb_copy_ns};
+}
+
 void Statistics::SwapDL()
 {
   std::swap(this_frame.num_dl_prims, this_frame.num_prims);
@@ -63,14 +78,33 @@ void Statistics::Display() const
   draw_statistic("Textures created", "%d", num_textures_created);
   draw_statistic("Textures uploaded", "%d", num_textures_uploaded);
   draw_statistic("Textures alive", "%d", num_textures_alive);
+  draw_statistic("Textures resident", "%zu MB", bytes_textures_resident / (1024 * 1024));
+  draw_statistic("Textures evicted", "%d", num_textures_evicted);
+  draw_statistic("Texture pool hit rate", "%.1f%%",
+                 num_texture_pool_hits + num_textures_created > 0 ?
+                     100.0f * num_texture_pool_hits /
+                         (num_texture_pool_hits + num_textures_created) :
+                     0.0f);
   draw_statistic("pshaders created", "%d", num_pixel_shaders_created);
   draw_statistic("pshaders alive", "%d", num_pixel_shaders_alive);
   draw_statistic("vshaders created", "%d", num_vertex_shaders_created);
   draw_statistic("vshaders alive", "%d", num_vertex_shaders_alive);
   draw_statistic("shaders changes", "%d", this_frame.num_shader_changes);
+  draw_statistic("Ubershader draws", "%d", this_frame.num_ubershader_draws);
+  draw_statistic("Ubershader frames", "%d", num_ubershader_frames);
+  draw_statistic("Shader compiles queued", "%d", num_shader_compiles_queued);
+  draw_statistic("Shader compile p50/p99", "%.1f / %.1f ms",
+                 shader_compile_latency_p50_us / 1000.0, shader_compile_latency_p99_us / 1000.0);
+  draw_statistic("Shader compiles cancelled", "%d", num_shader_compiles_cancelled);
+  draw_statistic("Shader deadlines missed", "%d", num_shader_compile_deadlines_missed);
   draw_statistic("dlists called", "%d", this_frame.num_dlists_called);
+  draw_statistic("dlist cache hit rate", "%.1f%%",
+                 this_frame.num_dlists_called > 0 ?
+                     100.0f * this_frame.num_dlists_replayed / this_frame.num_dlists_called :
+                     0.0f);
   draw_statistic("Primitive joins", "%d", this_frame.num_primitive_joins);
   draw_statistic("Draw calls", "%d", this_frame.num_draw_calls);
+  draw_statistic("Draws avoided", "%d", this_frame.num_draws_avoided);
   draw_statistic("Primitives", "%d", this_frame.num_prims);
   draw_statistic("Primitives (DL)", "%d", this_frame.num_dl_prims);
   draw_statistic("XF loads", "%d", this_frame.num_xf_loads);
@@ -82,12 +116,50 @@ void Statistics::Display() const
   draw_statistic("Vertex streamed", "%i kB", this_frame.bytes_vertex_streamed / 1024);
   draw_statistic("Index streamed", "%i kB", this_frame.bytes_index_streamed / 1024);
   draw_statistic("Uniform streamed", "%i kB", this_frame.bytes_uniform_streamed / 1024);
+  draw_statistic("Uniform skipped", "%i kB", this_frame.bytes_uniform_skipped / 1024);
   draw_statistic("Vertex Loaders", "%d", num_vertex_loaders);
   draw_statistic("EFB peeks:", "%d", this_frame.num_efb_peeks);
   draw_statistic("EFB pokes:", "%d", this_frame.num_efb_pokes);
+  draw_statistic("EFB peeks prefetched:", "%d", this_frame.num_efb_peeks_prefetched);
+  draw_statistic("EFB peek stall", "%.2f ms", this_frame.efb_peek_stall_ns / 1000000.0);
+  draw_statistic("Command processing", "%.2f ms", this_frame.command_processing_ns / 1000000.0);
+  draw_statistic("Vertex loading", "%.2f ms", this_frame.vertex_loading_ns / 1000000.0);
+  draw_statistic("Vertex loading stall", "%.2f ms",
+                 this_frame.vertex_loading_stall_ns / 1000000.0);
+  draw_statistic("Texture loading", "%.2f ms", this_frame.texture_loading_ns / 1000000.0);
+  draw_statistic("Draw submission", "%.2f ms", this_frame.draw_submission_ns / 1000000.0);
+  draw_statistic("EFB copies", "%.2f ms", this_frame.efb_copy_ns / 1000000.0);
 
   ImGui::Columns(1);
 
+  if (ImGui::CollapsingHeader("Vertex Loaders"))
+  {
+    ImGui::Columns(4, "Vertex Loaders", true);
+    ImGui::TextUnformatted("UID");
+    ImGui::NextColumn();
+    ImGui::TextUnformatted("Stride");
+    ImGui::NextColumn();
+    ImGui::TextUnformatted("Vertices");
+    ImGui::NextColumn();
+    ImGui::TextUnformatted("Time");
+    ImGui::NextColumn();
+    ImGui::Separator();
+
+    for (const auto& loader : VertexLoaderManager::GetLoaderStatistics())
+    {
+      ImGui::TextUnformatted(loader.name.c_str());
+      ImGui::NextColumn();
+      ImGui::Text("%u", loader.vertex_size);
+      ImGui::NextColumn();
+      ImGui::Text("%" PRIu64, loader.num_vertices);
+      ImGui::NextColumn();
+      ImGui::Text("%.2f ms", loader.load_time_ns / 1000000.0);
+      ImGui::NextColumn();
+    }
+
+    ImGui::Columns(1);
+  }
+
   ImGui::End();
 }
 
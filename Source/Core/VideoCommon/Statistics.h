@@ -4,6 +4,9 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+
+#include "Common/CommonTypes.h"
 
 struct Statistics
 {
@@ -15,9 +18,21 @@ struct Statistics
   int num_textures_created;
   int num_textures_uploaded;
   int num_textures_alive;
+  int num_texture_pool_hits;
+  int num_textures_evicted;
+  size_t bytes_textures_resident;
 
   int num_vertex_loaders;
 
+  // Shader compiler state, only updated while the statistics are shown.
+  int num_shader_compiles_queued;
+  int num_shader_compiles_cancelled;
+  int num_shader_compile_deadlines_missed;
+  s64 shader_compile_latency_p50_us;
+  s64 shader_compile_latency_p99_us;
+  // Frames in which anything was drawn with ubershaders.
+  int num_ubershader_frames;
+
   std::array<float, 6> proj;
   std::array<float, 16> gproj;
   std::array<float, 16> g2proj;
@@ -35,15 +50,23 @@ struct Statistics
     int num_prims;
     int num_dl_prims;
     int num_shader_changes;
+    int num_ubershader_draws;
 
     int num_primitive_joins;
     int num_draw_calls;
+    // Draws which were merged into the previous batch because a BP/CP/XF write in between them
+    // didn't change anything, and would have split the batch otherwise.
+    int num_draws_avoided;
 
     int num_dlists_called;
+    // Display lists whose commands were replayed from the display list cache.
+    int num_dlists_replayed;
 
     int bytes_vertex_streamed;
     int bytes_index_streamed;
     int bytes_uniform_streamed;
+    // Uniform blocks which were marked dirty, but turned out to be unchanged.
+    int bytes_uniform_skipped;
 
     int num_triangles_clipped;
     int num_triangles_in;
@@ -58,8 +81,37 @@ struct Statistics
 
     int num_efb_peeks;
     int num_efb_pokes;
+    // Peeks which found their tile already being read back, see FramebufferManager::OnDraw.
+    int num_efb_peeks_prefetched;
+    // Time spent waiting for EFB readbacks to complete.
+    u64 efb_peek_stall_ns;
+
+    // Time spent in each stage of the GPU thread, only measured while the statistics are shown.
+    // Command processing includes the other stages when they run on the GPU thread, and draw
+    // submission includes texture loading. EFB copies include the clears and XFB copies done by
+    // the copy trigger.
+    u64 command_processing_ns;
+    u64 vertex_loading_ns;
+    u64 vertex_loading_stall_ns;
+    u64 texture_loading_ns;
+    u64 draw_submission_ns;
+    u64 efb_copy_ns;
   };
   ThisFrame this_frame;
+
+  struct StageTimes
+  {
+    u64 command_processing_ns;
+    u64 vertex_loading_ns;
+    u64 texture_loading_ns;
+    u64 draw_submission_ns;
+    u64 efb_copy_ns;
+  };
+  // The stage times of all frames so far, including the current one. For tools whose frames don't
+  // line up with the swaps which reset this_frame.
+  StageTimes GetTotalStageTimes() const;
+  StageTimes past_stage_times;
+
   void ResetFrame();
   void SwapDL();
   void Display() const;
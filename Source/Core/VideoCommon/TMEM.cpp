@@ -98,6 +98,7 @@ struct TextureUnitState
 static u32 CalculateUnitSize(TextureUnitState::BankConfig bank_config);
 
 static std::array<TextureUnitState, 8> s_unit;
+static u32 s_invalidation_count = 0;
 
 // On TMEM configuration changed:
 // 1. invalidate stage.
@@ -138,6 +139,7 @@ void InvalidateAll()
   {
     unit.state = TextureUnitState::State::INVALID;
   }
+  s_invalidation_count++;
 }
 
 // On invalidate cache:
@@ -277,6 +279,11 @@ bool IsValid(u32 unit)
   return s_unit[unit].state != TextureUnitState::State::INVALID;
 }
 
+u32 GetInvalidationCount()
+{
+  return s_invalidation_count;
+}
+
 void Init()
 {
   s_unit.fill({});
@@ -285,6 +292,10 @@ void Init()
 void DoState(PointerWrap& p)
 {
   p.DoArray(s_unit);
+
+  // TMEM and RAM were replaced along with the state.
+  if (p.GetMode() == PointerWrap::MODE_READ)
+    s_invalidation_count++;
 }
 
 }  // namespace TMEM
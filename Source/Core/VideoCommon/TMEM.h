@@ -20,6 +20,9 @@ void FinalizeBinds(BitSet32 used_textures);
 bool IsCached(u32 unit);
 bool IsValid(u32 unit);
 
+// Changes whenever textures have been invalidated, TMEM has been loaded, or a state was loaded.
+u32 GetInvalidationCount();
+
 void Init();
 void DoState(PointerWrap& p);
 
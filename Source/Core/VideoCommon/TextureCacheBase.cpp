@@ -88,6 +88,7 @@ TextureCacheBase::TextureCacheBase()
 
   TexDecoder_SetTexFmtOverlayOptions(backup_config.texfmt_overlay,
                                      backup_config.texfmt_overlay_center);
+  TexDecoder_SetDecodeThreads(g_ActiveConfig.GetTextureDecodingThreads());
 
   HiresTexture::Init();
 
@@ -100,6 +101,9 @@ TextureCacheBase::~TextureCacheBase()
 {
   // Clear pending EFB copies first, so we don't try to flush them.
   m_pending_efb_copies.clear();
+  m_pending_efb_copy_ranges.Clear();
+
+  TexDecoder_SetDecodeThreads(0);
 
   HiresTexture::Shutdown();
   Invalidate();
@@ -129,6 +133,7 @@ void TextureCacheBase::Invalidate()
     delete tex.second;
   }
   textures_by_address.clear();
+  textures_by_range.Clear();
   textures_by_hash.clear();
 
   texture_pool.clear();
@@ -166,6 +171,8 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  TexDecoder_SetDecodeThreads(config.GetTextureDecodingThreads());
+
   SetBackupConfig(config);
 }
 
@@ -230,6 +237,91 @@ void TextureCacheBase::Cleanup(int _frameCount)
       ++iter2;
     }
   }
+
+  EnforceMemoryBudget(_frameCount);
+}
+
+void TextureCacheBase::EnforceMemoryBudget(int frame_count)
+{
+  size_t resident_bytes = 0;
+  for (const auto& it : textures_by_address)
+    resident_bytes += it.second->texture->GetConfig().GetSizeInBytes();
+  for (const auto& it : texture_pool)
+    resident_bytes += it.first.GetSizeInBytes();
+
+  const size_t budget = static_cast<size_t>(g_ActiveConfig.iTextureCacheBudget) * 1024 * 1024;
+  if (budget == 0 || resident_bytes <= budget)
+  {
+    g_stats.bytes_textures_resident = resident_bytes;
+    return;
+  }
+
+  // Least recently used first. Among textures last used in the same frame, evict the larger ones
+  // first, so that as few textures as possible have to be recreated.
+  const auto evict_before = [](int frame_a, size_t size_a, int frame_b, size_t size_b) {
+    return frame_a != frame_b ? frame_a < frame_b : size_a > size_b;
+  };
+
+  // Pooled textures aren't referenced by anything, so they go before any cache entry. Textures
+  // which are returned to the pool below still have a frameCount of FRAMECOUNT_INVALID, as
+  // Cleanup has already assigned a frame to everything that was in the pool before.
+  const auto evict_from_pool = [&] {
+    std::vector<TexPool::iterator> candidates;
+    for (auto iter = texture_pool.begin(); iter != texture_pool.end(); ++iter)
+      candidates.push_back(iter);
+    std::sort(candidates.begin(), candidates.end(), [&](const auto& a, const auto& b) {
+      return evict_before(a->second.frameCount, a->first.GetSizeInBytes(), b->second.frameCount,
+                          b->first.GetSizeInBytes());
+    });
+
+    for (const TexPool::iterator& iter : candidates)
+    {
+      if (resident_bytes <= budget)
+        break;
+
+      resident_bytes -= iter->first.GetSizeInBytes();
+      texture_pool.erase(iter);
+      INCSTAT(g_stats.num_textures_evicted);
+    }
+  };
+  evict_from_pool();
+
+  if (resident_bytes > budget)
+  {
+    // Textures used in the last frame are likely to be used again in the next one, and EFB copies
+    // can't be recreated from guest memory, so those are never evicted.
+    std::vector<TCacheEntry*> candidates;
+    for (const auto& it : textures_by_address)
+    {
+      TCacheEntry* entry = it.second;
+      if (entry->IsCopy() || entry->frameCount >= frame_count ||
+          std::find(bound_textures.begin(), bound_textures.end(), entry) != bound_textures.end())
+      {
+        continue;
+      }
+      candidates.push_back(entry);
+    }
+    std::sort(candidates.begin(), candidates.end(), [&](const auto* a, const auto* b) {
+      return evict_before(a->frameCount, a->texture->GetConfig().GetSizeInBytes(), b->frameCount,
+                          b->texture->GetConfig().GetSizeInBytes());
+    });
+
+    // Each evicted entry moves its texture into the pool, so count what would remain once those
+    // are released as well.
+    size_t entry_bytes = resident_bytes;
+    for (TCacheEntry* entry : candidates)
+    {
+      if (entry_bytes <= budget)
+        break;
+
+      entry_bytes -= entry->texture->GetConfig().GetSizeInBytes();
+      InvalidateTexture(GetTexCacheIter(entry));
+    }
+
+    evict_from_pool();
+  }
+
+  g_stats.bytes_textures_resident = resident_bytes;
 }
 
 bool TextureCacheBase::TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
@@ -322,7 +414,7 @@ TextureCacheBase::ApplyPaletteToEntry(TCacheEntry* entry, const u8* palette, TLU
     g_renderer->EndUtilityDrawing();
   }
 
-  textures_by_address.emplace(decoded_entry->addr, decoded_entry);
+  InsertTexture(decoded_entry->addr, decoded_entry);
 
   return decoded_entry;
 }
@@ -369,7 +461,7 @@ TextureCacheBase::TCacheEntry* TextureCacheBase::ReinterpretEntry(const TCacheEn
   g_renderer->EndUtilityDrawing();
   reinterpreted_entry->texture->FinishedRendering();
 
-  textures_by_address.emplace(reinterpreted_entry->addr, reinterpreted_entry);
+  InsertTexture(reinterpreted_entry->addr, reinterpreted_entry);
 
   return reinterpreted_entry;
 }
@@ -713,7 +805,7 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
 
     TCacheEntry* entry = GetEntry(id);
     if (entry)
-      textures_by_address.emplace(addr, entry);
+      InsertTexture(addr, entry);
   }
 
   // Fill in hash map.
@@ -1600,7 +1692,6 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
     }
   }
 
-  iter = textures_by_address.emplace(texture_info.GetRawAddress(), entry);
   if (textureCacheSafetyColorSampleSize == 0 ||
       std::max(texture_info.GetTextureSize(), palette_size) <=
           (u32)textureCacheSafetyColorSampleSize * 8)
@@ -1616,6 +1707,7 @@ TextureCacheBase::GetTexture(const int textureCacheSafetyColorSampleSize, Textur
   entry->is_custom_tex = hires_tex != nullptr;
   entry->memory_stride = entry->BytesPerRow();
   entry->SetNotCopy();
+  iter = InsertTexture(texture_info.GetRawAddress(), entry);
 
   std::string basename;
   if (g_ActiveConfig.bDumpTextures && !hires_tex)
@@ -1754,7 +1846,7 @@ TextureCacheBase::GetXFBTexture(u32 address, u32 width, u32 height, u32 stride,
   entry->texture->FinishedRendering();
 
   // Insert into the texture cache so we can re-use it next frame, if needed.
-  textures_by_address.emplace(entry->addr, entry);
+  InsertTexture(entry->addr, entry);
   SETSTAT(g_stats.num_textures_alive, static_cast<int>(textures_by_address.size()));
   INCSTAT(g_stats.num_textures_uploaded);
 
@@ -2208,6 +2300,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
         entry->pending_efb_copy_height = num_blocks_y;
         entry->pending_efb_copy_invalidated = false;
         m_pending_efb_copies.push_back(entry);
+        m_pending_efb_copy_ranges.Add(entry->addr, num_blocks_y * dstStride, entry);
       }
     }
   }
@@ -2312,7 +2405,7 @@ void TextureCacheBase::CopyRenderTargetToTexture(
   {
     const u64 hash = entry->CalculateHash();
     entry->SetHashes(hash, hash);
-    textures_by_address.emplace(dstAddr, entry);
+    InsertTexture(dstAddr, entry);
   }
 }
 
@@ -2324,6 +2417,35 @@ void TextureCacheBase::FlushEFBCopies()
   for (TCacheEntry* entry : m_pending_efb_copies)
     FlushEFBCopy(entry);
   m_pending_efb_copies.clear();
+  m_pending_efb_copy_ranges.Clear();
+}
+
+void TextureCacheBase::FlushEFBCopies(u32 address, u32 size)
+{
+  // Overlapping copies have to reach RAM in the order they were issued, so everything up to the
+  // last copy touching the range is written back.
+  size_t count = 0;
+  m_pending_efb_copy_ranges.ForEachOverlapping(address, size, [&](TCacheEntry* entry) {
+    const auto iter = std::find(m_pending_efb_copies.begin(), m_pending_efb_copies.end(), entry);
+    // Both containers are always updated together, so a missing entry would be a bug.
+    ASSERT_MSG(VIDEO, iter != m_pending_efb_copies.end(),
+               "Pending EFB copy at {:08x} is indexed but not queued", entry->addr);
+    if (iter == m_pending_efb_copies.end())
+      return;
+    count = std::max<size_t>(count, iter - m_pending_efb_copies.begin() + 1);
+  });
+  if (count == 0)
+    return;
+
+  const auto end = m_pending_efb_copies.begin() + count;
+  for (auto iter = m_pending_efb_copies.begin(); iter != end; ++iter)
+  {
+    TCacheEntry* entry = *iter;
+    m_pending_efb_copy_ranges.Remove(entry->addr,
+                                     entry->pending_efb_copy_height * entry->memory_stride, entry);
+    FlushEFBCopy(entry);
+  }
+  m_pending_efb_copies.erase(m_pending_efb_copies.begin(), end);
 }
 
 void TextureCacheBase::WriteEFBCopyToRAM(u8* dst_ptr, u32 width, u32 height, u32 stride,
@@ -2460,6 +2582,7 @@ TextureCacheBase::AllocateTexture(const TextureConfig& config)
   {
     auto entry = std::move(iter->second);
     texture_pool.erase(iter);
+    INCSTAT(g_stats.num_texture_pool_hits);
     return std::move(entry);
   }
 
@@ -2518,17 +2641,20 @@ TextureCacheBase::GetTexCacheIter(TextureCacheBase::TCacheEntry* entry)
   return textures_by_address.end();
 }
 
+TextureCacheBase::TexAddrCache::iterator TextureCacheBase::InsertTexture(u32 address,
+                                                                        TCacheEntry* entry)
+{
+  textures_by_range.Add(entry->addr, entry->size_in_bytes, entry);
+  return textures_by_address.emplace(address, entry);
+}
+
 std::pair<TextureCacheBase::TexAddrCache::iterator, TextureCacheBase::TexAddrCache::iterator>
 TextureCacheBase::FindOverlappingTextures(u32 addr, u32 size_in_bytes)
 {
-  // We index by the starting address only, so there is no way to query all textures
-  // which end after the given addr. But the GC textures have a limited size, so we
-  // look for all textures which have a start address bigger than addr minus the maximal
-  // texture size. But this yields false-positives which must be checked later on.
-
-  // 1024 x 1024 texel times 8 nibbles per texel
-  constexpr u32 max_texture_size = 1024 * 1024 * 4;
-  u32 lower_addr = addr > max_texture_size ? addr - max_texture_size : 0;
+  // textures_by_address is ordered by start address only, so it can't tell which of the textures
+  // below addr extend past it. textures_by_range knows where the lowest of those starts, so
+  // only textures starting between there and the end of the range have to be checked.
+  const u32 lower_addr = textures_by_range.GetLowestOverlappingAddress(addr);
   auto begin = textures_by_address.lower_bound(lower_addr);
   auto end = textures_by_address.upper_bound(addr + size_in_bytes);
 
@@ -2587,7 +2713,11 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
       ReleaseEFBCopyStagingTexture(std::move(entry->pending_efb_copy));
       auto pending_it = std::find(m_pending_efb_copies.begin(), m_pending_efb_copies.end(), entry);
       if (pending_it != m_pending_efb_copies.end())
+      {
         m_pending_efb_copies.erase(pending_it);
+        m_pending_efb_copy_ranges.Remove(
+            entry->addr, entry->pending_efb_copy_height * entry->memory_stride, entry);
+      }
     }
     else
     {
@@ -2599,6 +2729,8 @@ TextureCacheBase::InvalidateTexture(TexAddrCache::iterator iter, bool discard_pe
   texture_pool.emplace(config,
                        TexPoolEntry(std::move(entry->texture), std::move(entry->framebuffer)));
 
+  textures_by_range.Remove(entry->addr, entry->size_in_bytes, entry);
+
   // Don't delete if there's a pending EFB copy, as we need the TCacheEntry alive.
   if (!entry->pending_efb_copy)
     delete entry;
@@ -19,6 +19,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/AbstractTexture.h"
+#include "VideoCommon/AddressRangeIndex.h"
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -229,6 +230,7 @@ public:
   void ForceReload();
 
   // Removes textures which aren't used for more than TEXTURE_KILL_THRESHOLD frames,
+  // and evicts the least recently used ones beyond the configured memory budget.
   // frameCount is the current frame number.
   void Cleanup(int _frameCount);
 
@@ -251,6 +253,9 @@ public:
 
   // Flushes all pending EFB copies to emulated RAM.
   void FlushEFBCopies();
+  // Flushes the pending EFB copies overlapping the given range of emulated RAM, along with all
+  // copies issued before them. For when the GPU itself reads the range back.
+  void FlushEFBCopies(u32 address, u32 size);
 
   // Texture Serialization
   void SerializeTexture(AbstractTexture* tex, const TextureConfig& config, PointerWrap& p);
@@ -315,10 +320,15 @@ private:
   TCacheEntry* AllocateCacheEntry(const TextureConfig& config);
   std::optional<TexPoolEntry> AllocateTexture(const TextureConfig& config);
   TexPool::iterator FindMatchingTextureFromPool(const TextureConfig& config);
+  void EnforceMemoryBudget(int frame_count);
   TexAddrCache::iterator GetTexCacheIter(TCacheEntry* entry);
 
-  // Return all possible overlapping textures. As addr+size of the textures is not
-  // indexed, this may return false positives.
+  // Adds an entry to textures_by_address. Its address and size must not change until it is
+  // removed again by InvalidateTexture.
+  TexAddrCache::iterator InsertTexture(u32 address, TCacheEntry* entry);
+
+  // Return all possible overlapping textures. This is a range of textures_by_address, so it may
+  // also contain textures which don't overlap.
   std::pair<TexAddrCache::iterator, TexAddrCache::iterator>
   FindOverlappingTextures(u32 addr, u32 size_in_bytes);
 
@@ -350,6 +360,7 @@ private:
   void DoLoadState(PointerWrap& p);
 
   TexAddrCache textures_by_address;
+  AddressRangeIndex<TCacheEntry*> textures_by_range;
   TexHashCache textures_by_hash;
   TexPool texture_pool;
   u64 last_entry_id = 0;
@@ -384,6 +395,8 @@ private:
   // List of pending EFB copies. It is important that the order is preserved for these,
   // so that overlapping textures are written to guest RAM in the order they are issued.
   std::vector<TCacheEntry*> m_pending_efb_copies;
+  // The emulated RAM the pending EFB copies will be written to.
+  AddressRangeIndex<TCacheEntry*> m_pending_efb_copy_ranges;
 
   // Staging texture used for readbacks.
   // We store this in the class so that the same staging texture can be used for multiple
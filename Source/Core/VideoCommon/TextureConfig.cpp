@@ -3,6 +3,7 @@
 
 #include "VideoCommon/TextureConfig.h"
 
+#include <algorithm>
 #include <tuple>
 
 #include "VideoCommon/AbstractTexture.h"
@@ -38,3 +39,16 @@ size_t TextureConfig::GetMipStride(u32 level) const
 {
   return AbstractTexture::CalculateStrideForFormat(format, std::max(width >> level, 1u));
 }
+
+size_t TextureConfig::GetSizeInBytes() const
+{
+  // Compressed formats store one row of blocks per stride.
+  const u32 block_size = AbstractTexture::GetBlockSizeForFormat(format);
+  size_t size = 0;
+  for (u32 level = 0; level < levels; level++)
+  {
+    const u32 rows = (std::max(height >> level, 1u) + block_size - 1) / block_size;
+    size += GetMipStride(level) * rows;
+  }
+  return size * layers * samples;
+}
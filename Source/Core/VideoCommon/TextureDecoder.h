@@ -187,6 +187,15 @@ void TexDecoder_DecodeXFB(u8* dst, const u8* src, u32 width, u32 height, u32 str
 
 void TexDecoder_SetTexFmtOverlayOptions(bool enable, bool center);
 
-/* Internal method, implemented by TextureDecoder_Generic and TextureDecoder_x64. */
+// Sets the number of worker threads used to decode large textures in TexDecoder_Decode.
+// 0 decodes every texture on the calling thread.
+void TexDecoder_SetDecodeThreads(u32 num_threads);
+
+/* Internal methods, implemented by TextureDecoder_Generic and TextureDecoder_x64. */
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt);
+void _TexDecoder_DecodeRGBA8FromTmemImpl(u32* dst, const u8* src_ar, const u8* src_gb, int width,
+                                         int height);
+// Decodes one texel at a time, for the sizes the optimized decoders don't handle.
+void _TexDecoder_DecodeRGBA8FromTmemTexels(u32* dst, const u8* src_ar, const u8* src_gb,
+                                           int width, int height);
@@ -8,6 +8,7 @@
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
+#include "Common/WorkerPool.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -17,6 +18,15 @@
 static bool TexFmt_Overlay_Enable = false;
 static bool TexFmt_Overlay_Center = false;
 
+// Textures with at least this many texels are split into ranges of block rows which are decoded
+// in parallel. Below this, the cost of waking up the workers outweighs the gains.
+constexpr int PARALLEL_DECODE_MIN_TEXELS = 256 * 256;
+
+// Number of ranges each thread gets, so that uneven progress between threads evens out.
+constexpr u32 PARALLEL_DECODE_RANGES_PER_THREAD = 4;
+
+static Common::WorkerPool s_decode_pool("TextureDecoder");
+
 // TRAM
 // STATE_TO_SAVE
 alignas(16) u8 texMem[TMEM_SIZE];
@@ -373,10 +383,47 @@ static void TexDecoder_DrawOverlay(u8* dst, int width, int height, TextureFormat
   }
 }
 
+void TexDecoder_SetDecodeThreads(u32 num_threads)
+{
+  s_decode_pool.Resize(num_threads);
+}
+
+static bool TexDecoder_DecodeParallel(u8* dst, const u8* src, int width, int height,
+                                      TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  const u32 num_threads = s_decode_pool.GetNumThreads();
+  if (num_threads == 0 || width * height < PARALLEL_DECODE_MIN_TEXELS)
+    return false;
+
+  // Blocks are stored row after row, so any range of whole block rows can be decoded on its own.
+  const int block_width = TexDecoder_GetBlockWidthInTexels(texformat);
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  if (width % block_width != 0 || height % block_height != 0)
+    return false;
+
+  const u32 block_rows = static_cast<u32>(height / block_height);
+  const u32 num_ranges =
+      std::min(block_rows, (num_threads + 1) * PARALLEL_DECODE_RANGES_PER_THREAD);
+  const size_t src_block_row_size =
+      static_cast<size_t>(TexDecoder_GetTextureSizeInBytes(width, block_height, texformat));
+  const size_t dst_block_row_size = static_cast<size_t>(width) * block_height * sizeof(u32);
+
+  s_decode_pool.ParallelFor(num_ranges, [&](u32 range) {
+    const u32 first_row = block_rows * range / num_ranges;
+    const u32 end_row = block_rows * (range + 1) / num_ranges;
+    _TexDecoder_DecodeImpl(reinterpret_cast<u32*>(dst + first_row * dst_block_row_size),
+                           src + first_row * src_block_row_size, width,
+                           static_cast<int>(end_row - first_row) * block_height, texformat, tlut,
+                           tlutfmt);
+  });
+  return true;
+}
+
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt)
 {
-  _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
+  if (!TexDecoder_DecodeParallel(dst, src, width, height, texformat, tlut, tlutfmt))
+    _TexDecoder_DecodeImpl((u32*)dst, src, width, height, texformat, tlut, tlutfmt);
 
   if (TexFmt_Overlay_Enable)
     TexDecoder_DrawOverlay(dst, width, height, texformat);
@@ -740,20 +787,27 @@ void TexDecoder_DecodeTexelRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* sr
   dst[2] = val_addr_gb[1];  // B
 }
 
-void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
-                                    int height)
+void _TexDecoder_DecodeRGBA8FromTmemTexels(u32* dst, const u8* src_ar, const u8* src_gb,
+                                           int width, int height)
 {
   // TODO for someone who cares: Make this less slow!
   for (int y = 0; y < height; ++y)
   {
     for (int x = 0; x < width; ++x)
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(dst, src_ar, src_gb, x, y, width - 1);
-      dst += 4;
+      TexDecoder_DecodeTexelRGBA8FromTmem(reinterpret_cast<u8*>(dst), src_ar, src_gb, x, y,
+                                          width - 1);
+      dst++;
     }
   }
 }
 
+void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
+                                    int height)
+{
+  _TexDecoder_DecodeRGBA8FromTmemImpl(reinterpret_cast<u32*>(dst), src_ar, src_gb, width, height);
+}
+
 void TexDecoder_DecodeXFB(u8* dst, const u8* src, u32 width, u32 height, u32 stride)
 {
   const u8* src_ptr = src;
@@ -350,3 +350,9 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
   }
 }
+
+void _TexDecoder_DecodeRGBA8FromTmemImpl(u32* dst, const u8* src_ar, const u8* src_gb, int width,
+                                         int height)
+{
+  _TexDecoder_DecodeRGBA8FromTmemTexels(dst, src_ar, src_gb, width, height);
+}
@@ -1413,6 +1413,409 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
   }
 }
 
+// AVX2 implementations. The helpers below work on eight texels at a time, each held in a 32-bit
+// lane. Input values are 16-bit colors zero-extended to 32 bits.
+
+static inline u32 DecodePixel_Paletted(u16 pixel, TLUTFormat tlutfmt)
+{
+  switch (tlutfmt)
+  {
+  case TLUTFormat::IA8:
+    return DecodePixel_IA8(pixel);
+  case TLUTFormat::RGB565:
+    return DecodePixel_RGB565(Common::swap16(pixel));
+  case TLUTFormat::RGB5A3:
+    return DecodePixel_RGB5A3(Common::swap16(pixel));
+  default:
+    return 0;
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i Swap16_AVX2(__m256i val)
+{
+  const __m256i mask_xff = _mm256_set1_epi32(0xff);
+  return _mm256_or_si256(_mm256_slli_epi32(_mm256_and_si256(val, mask_xff), 8),
+                         _mm256_and_si256(_mm256_srli_epi32(val, 8), mask_xff));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodePixel_IA8_AVX2(__m256i val)
+{
+  const __m256i mask_xff = _mm256_set1_epi32(0xff);
+  const __m256i i = _mm256_and_si256(_mm256_srli_epi32(val, 8), mask_xff);
+  const __m256i a = _mm256_and_si256(val, mask_xff);
+  return _mm256_or_si256(_mm256_or_si256(i, _mm256_slli_epi32(i, 8)),
+                         _mm256_or_si256(_mm256_slli_epi32(i, 16), _mm256_slli_epi32(a, 24)));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodePixel_RGB565_AVX2(__m256i val)
+{
+  const __m256i mask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i mask_x3f = _mm256_set1_epi32(0x3f);
+
+  // Swizzle bits: 00012345 -> 12345123 and 00123456 -> 12345612
+  const __m256i r5 = _mm256_and_si256(_mm256_srli_epi32(val, 11), mask_x1f);
+  const __m256i g6 = _mm256_and_si256(_mm256_srli_epi32(val, 5), mask_x3f);
+  const __m256i b5 = _mm256_and_si256(val, mask_x1f);
+  const __m256i r = _mm256_or_si256(_mm256_slli_epi32(r5, 3), _mm256_srli_epi32(r5, 2));
+  const __m256i g = _mm256_or_si256(_mm256_slli_epi32(g6, 2), _mm256_srli_epi32(g6, 4));
+  const __m256i b = _mm256_or_si256(_mm256_slli_epi32(b5, 3), _mm256_srli_epi32(b5, 2));
+
+  return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                         _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_set1_epi32(0xFF000000)));
+}
+
+FUNCTION_TARGET_AVX2
+static inline __m256i DecodePixel_RGB5A3_AVX2(__m256i val)
+{
+  const __m256i mask_x1f = _mm256_set1_epi32(0x1f);
+  const __m256i mask_x0f = _mm256_set1_epi32(0x0f);
+  const __m256i mask_x07 = _mm256_set1_epi32(0x07);
+
+  // RGB555 with alpha = 0xFF. Swizzle bits: 00012345 -> 12345123
+  const __m256i r5 = _mm256_and_si256(_mm256_srli_epi32(val, 10), mask_x1f);
+  const __m256i g5 = _mm256_and_si256(_mm256_srli_epi32(val, 5), mask_x1f);
+  const __m256i b5 = _mm256_and_si256(val, mask_x1f);
+  const __m256i r555 = _mm256_or_si256(_mm256_slli_epi32(r5, 3), _mm256_srli_epi32(r5, 2));
+  const __m256i g555 = _mm256_or_si256(_mm256_slli_epi32(g5, 3), _mm256_srli_epi32(g5, 2));
+  const __m256i b555 = _mm256_or_si256(_mm256_slli_epi32(b5, 3), _mm256_srli_epi32(b5, 2));
+  const __m256i rgb555 =
+      _mm256_or_si256(_mm256_or_si256(r555, _mm256_slli_epi32(g555, 8)),
+                      _mm256_or_si256(_mm256_slli_epi32(b555, 16), _mm256_set1_epi32(0xFF000000)));
+
+  // RGBA4443. Swizzle bits: 00001234 -> 12341234 and 00000123 -> 12312312
+  const __m256i r4 = _mm256_and_si256(_mm256_srli_epi32(val, 8), mask_x0f);
+  const __m256i g4 = _mm256_and_si256(_mm256_srli_epi32(val, 4), mask_x0f);
+  const __m256i b4 = _mm256_and_si256(val, mask_x0f);
+  const __m256i a3 = _mm256_and_si256(_mm256_srli_epi32(val, 12), mask_x07);
+  const __m256i r4443 = _mm256_or_si256(_mm256_slli_epi32(r4, 4), r4);
+  const __m256i g4443 = _mm256_or_si256(_mm256_slli_epi32(g4, 4), g4);
+  const __m256i b4443 = _mm256_or_si256(_mm256_slli_epi32(b4, 4), b4);
+  const __m256i a4443 =
+      _mm256_or_si256(_mm256_slli_epi32(a3, 5),
+                      _mm256_or_si256(_mm256_slli_epi32(a3, 2), _mm256_srli_epi32(a3, 1)));
+  const __m256i rgba4443 =
+      _mm256_or_si256(_mm256_or_si256(r4443, _mm256_slli_epi32(g4443, 8)),
+                      _mm256_or_si256(_mm256_slli_epi32(b4443, 16), _mm256_slli_epi32(a4443, 24)));
+
+  // Bit 15 selects between the two encodings.
+  const __m256i is_rgb555 = _mm256_srai_epi32(_mm256_slli_epi32(val, 16), 31);
+  return _mm256_blendv_epi8(rgba4443, rgb555, is_rgb555);
+}
+
+// Decodes TLUT entries as they are stored in memory.
+template <TLUTFormat tlutfmt>
+FUNCTION_TARGET_AVX2 static inline __m256i DecodePixel_Paletted_AVX2(__m256i val)
+{
+  if constexpr (tlutfmt == TLUTFormat::IA8)
+    return DecodePixel_IA8_AVX2(val);
+  else if constexpr (tlutfmt == TLUTFormat::RGB565)
+    return DecodePixel_RGB565_AVX2(Swap16_AVX2(val));
+  else
+    return DecodePixel_RGB5A3_AVX2(Swap16_AVX2(val));
+}
+
+// Stores eight texels as two rows of four.
+FUNCTION_TARGET_AVX2
+static inline void StoreTwoRows_AVX2(u32* dst, int width, __m256i texels)
+{
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(texels));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + width), _mm256_extracti128_si256(texels, 1));
+}
+
+// Loads two rows of four big-endian 16-bit values.
+FUNCTION_TARGET_AVX2
+static inline __m256i LoadTwoRowsBE16_AVX2(const u8* src)
+{
+  const __m128i swap_mask = _mm_set_epi8(14, 15, 12, 13, 10, 11, 8, 9, 6, 7, 4, 5, 2, 3, 0, 1);
+  const __m128i raw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+  return _mm256_cvtepu16_epi32(_mm_shuffle_epi8(raw, swap_mask));
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C4_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decode the whole 16-entry palette up front, then look texels up with permutes.
+  alignas(32) u32 palette[16];
+  const u16* tlut16 = reinterpret_cast<const u16*>(tlut);
+  for (int i = 0; i < 16; i++)
+    palette[i] = DecodePixel_Paletted(tlut16[i], tlutfmt);
+
+  const __m256i palette_lo = _mm256_load_si256(reinterpret_cast<const __m256i*>(palette));
+  const __m256i palette_hi = _mm256_load_si256(reinterpret_cast<const __m256i*>(palette + 8));
+  const __m256i shifts = _mm256_setr_epi32(4, 0, 12, 8, 20, 16, 28, 24);
+  const __m256i mask_x0f = _mm256_set1_epi32(0x0f);
+  const __m256i seven = _mm256_set1_epi32(7);
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 8 * yStep; iy < 8; iy++, xStep++)
+      {
+        u32 row;
+        std::memcpy(&row, src + 4 * xStep, sizeof(row));
+        const __m256i index =
+            _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(row), shifts), mask_x0f);
+        const __m256i lo = _mm256_permutevar8x32_epi32(palette_lo, index);
+        const __m256i hi = _mm256_permutevar8x32_epi32(palette_hi, index);
+        const __m256i texels = _mm256_blendv_epi8(lo, hi, _mm256_cmpgt_epi32(index, seven));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Decode the whole 256-entry palette up front, then look texels up with gathers.
+  alignas(32) u32 palette[256];
+  const u16* tlut16 = reinterpret_cast<const u16*>(tlut);
+  for (int i = 0; i < 256; i++)
+    palette[i] = DecodePixel_Paletted(tlut16[i], tlutfmt);
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        const __m256i index = _mm256_cvtepu8_epi32(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + 8 * xStep)));
+        const __m256i texels =
+            _mm256_i32gather_epi32(reinterpret_cast<const int*>(palette), index, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (y + iy) * width + x), texels);
+      }
+    }
+  }
+}
+
+template <TLUTFormat tlutfmt>
+FUNCTION_TARGET_AVX2 static void
+TexDecoder_DecodeImpl_C14X2_AVX2(u32* dst, const u8* src, int width, int height, const u8* tlut,
+                                 int Wsteps4)
+{
+  // The palette is too large to decode up front, so gather the raw entries instead. Entries are
+  // gathered in aligned pairs so that no memory outside of the palette is touched.
+  const __m256i mask_x3fff = _mm256_set1_epi32(0x3fff);
+  const __m256i mask_xffff = _mm256_set1_epi32(0xffff);
+  const __m256i one = _mm256_set1_epi32(1);
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0; iy < 4; iy += 2)
+      {
+        const __m256i index =
+            _mm256_and_si256(LoadTwoRowsBE16_AVX2(src + 32 * yStep + 8 * iy), mask_x3fff);
+        const __m256i pair = _mm256_i32gather_epi32(reinterpret_cast<const int*>(tlut),
+                                                    _mm256_srli_epi32(index, 1), 4);
+        const __m256i shift = _mm256_slli_epi32(_mm256_and_si256(index, one), 4);
+        const __m256i entry = _mm256_and_si256(_mm256_srlv_epi32(pair, shift), mask_xffff);
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, width,
+                          DecodePixel_Paletted_AVX2<tlutfmt>(entry));
+      }
+    }
+  }
+}
+
+static void TexDecoder_DecodeImpl_C14X2_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  switch (tlutfmt)
+  {
+  case TLUTFormat::RGB5A3:
+    TexDecoder_DecodeImpl_C14X2_AVX2<TLUTFormat::RGB5A3>(dst, src, width, height, tlut, Wsteps4);
+    break;
+
+  case TLUTFormat::IA8:
+    TexDecoder_DecodeImpl_C14X2_AVX2<TLUTFormat::IA8>(dst, src, width, height, tlut, Wsteps4);
+    break;
+
+  case TLUTFormat::RGB565:
+    TexDecoder_DecodeImpl_C14X2_AVX2<TLUTFormat::RGB565>(dst, src, width, height, tlut, Wsteps4);
+    break;
+
+  default:
+    break;
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGB5A3_AVX2(u32* dst, const u8* src, int width, int height,
+                                              TextureFormat texformat, const u8* tlut,
+                                              TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      for (int iy = 0; iy < 4; iy += 2)
+      {
+        const __m256i val = LoadTwoRowsBE16_AVX2(src + 32 * yStep + 8 * iy);
+        StoreTwoRows_AVX2(dst + (y + iy) * width + x, width, DecodePixel_RGB5A3_AVX2(val));
+      }
+    }
+  }
+}
+
+// Decodes a 4x4 RGBA8 block from its 32 bytes of AR and 32 bytes of GB data.
+FUNCTION_TARGET_AVX2
+static inline void DecodeRGBA8Block_AVX2(u32* dst, int width, const u8* src_ar, const u8* src_gb)
+{
+  const __m256i mask0312 = _mm256_setr_epi8(2, 1, 3, 0, 6, 5, 7, 4, 10, 9, 11, 8, 14, 13, 15, 12,
+                                            2, 1, 3, 0, 6, 5, 7, 4, 10, 9, 11, 8, 14, 13, 15, 12);
+  const __m256i ar = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src_ar));
+  const __m256i gb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src_gb));
+
+  // Each 128-bit half holds two rows, so the unpacks yield rows 0 and 2, and rows 1 and 3.
+  const __m256i rows02 = _mm256_shuffle_epi8(_mm256_unpacklo_epi8(ar, gb), mask0312);
+  const __m256i rows13 = _mm256_shuffle_epi8(_mm256_unpackhi_epi8(ar, gb), mask0312);
+
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(rows02));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + width), _mm256_castsi256_si128(rows13));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * width),
+                   _mm256_extracti128_si256(rows02, 1));
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 3 * width),
+                   _mm256_extracti128_si256(rows13, 1));
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_RGBA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const u8* src2 = src + 64 * yStep;
+      DecodeRGBA8Block_AVX2(dst + y * width + x, width, src2, src2 + 32);
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeRGBA8FromTmem_AVX2(u32* dst, const u8* src_ar, const u8* src_gb,
+                                                int width, int height)
+{
+  // In TMEM, the AR and GB halves of each block are stored in separate banks.
+  for (int y = 0, block = 0; y < height; y += 4)
+  {
+    for (int x = 0; x < width; x += 4, block++)
+      DecodeRGBA8Block_AVX2(dst + y * width + x, width, src_ar + 32 * block, src_gb + 32 * block);
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_CMPR_AVX2(u32* dst, const u8* src, int width, int height,
+                                            TextureFormat texformat, const u8* tlut,
+                                            TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Each iteration decodes one 8x8 tile, made up of four DXT blocks. The top two blocks end up
+  // in the low 128-bit half of the registers below, the bottom two in the high half.
+
+  // Extracts both (byte-swapped) endpoint colors of each DXT block into their own 32-bit lane.
+  const __m256i endpoint_mask =
+      _mm256_setr_epi8(1, 0, -1, -1, 3, 2, -1, -1, 9, 8, -1, -1, 11, 10, -1, -1, 1, 0, -1, -1, 3,
+                       2, -1, -1, 9, 8, -1, -1, 11, 10, -1, -1);
+  // Weights for (RGB0 * 5 + RGB1 * 3) / 8 and (RGB0 * 3 + RGB1 * 5) / 8, with 16-bit channels.
+  const __m256i weights0 = _mm256_setr_epi16(5, 5, 5, 5, 3, 3, 3, 3, 5, 5, 5, 5, 3, 3, 3, 3);
+  const __m256i weights1 = _mm256_setr_epi16(3, 3, 3, 3, 5, 5, 5, 5, 3, 3, 3, 3, 5, 5, 5, 5);
+  // Clears the alpha of the second averaged color, which is transparent.
+  const __m256i average_mask = _mm256_setr_epi16(-1, -1, -1, -1, -1, -1, -1, 0, -1, -1, -1, -1,
+                                                 -1, -1, -1, 0);
+  const __m256i top_selectors = _mm256_setr_epi32(1, 1, 1, 1, 3, 3, 3, 3);
+  const __m256i bottom_selectors = _mm256_setr_epi32(5, 5, 5, 5, 7, 7, 7, 7);
+  const __m256i selector_shifts = _mm256_setr_epi32(6, 4, 2, 0, 6, 4, 2, 0);
+  const __m256i palette_offsets = _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4);
+  const __m256i eight = _mm256_set1_epi32(8);
+  const __m256i mask_x03 = _mm256_set1_epi32(3);
+  const __m256i zero = _mm256_setzero_si256();
+
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      const __m256i dxt =
+          _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + sizeof(DXTBlock) * 4 * yStep));
+
+      // Per 128-bit half: (color1, color2) of the left block, then of the right block.
+      const __m256i endpoints565 = _mm256_shuffle_epi8(dxt, endpoint_mask);
+      const __m256i endpoints = DecodePixel_RGB565_AVX2(endpoints565);
+
+      // if (color1 > color2), for both lanes of each block:
+      const __m256i opaque =
+          _mm256_cmpgt_epi32(_mm256_shuffle_epi32(endpoints565, _MM_SHUFFLE(2, 2, 0, 0)),
+                             _mm256_shuffle_epi32(endpoints565, _MM_SHUFFLE(3, 3, 1, 1)));
+
+      const __m256i rgb0 = _mm256_shuffle_epi32(endpoints, _MM_SHUFFLE(2, 2, 0, 0));
+      const __m256i rgb1 = _mm256_shuffle_epi32(endpoints, _MM_SHUFFLE(3, 3, 1, 1));
+      const __m256i rrggbb0_left = _mm256_unpacklo_epi8(rgb0, zero);
+      const __m256i rrggbb1_left = _mm256_unpacklo_epi8(rgb1, zero);
+      const __m256i rrggbb0_right = _mm256_unpackhi_epi8(rgb0, zero);
+      const __m256i rrggbb1_right = _mm256_unpackhi_epi8(rgb1, zero);
+
+      // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8, RGB3 = (RGB0 * 3 + RGB1 * 5) / 8
+      const __m256i blend_left = _mm256_srli_epi16(
+          _mm256_add_epi16(_mm256_mullo_epi16(rrggbb0_left, weights0),
+                           _mm256_mullo_epi16(rrggbb1_left, weights1)),
+          3);
+      const __m256i blend_right = _mm256_srli_epi16(
+          _mm256_add_epi16(_mm256_mullo_epi16(rrggbb0_right, weights0),
+                           _mm256_mullo_epi16(rrggbb1_right, weights1)),
+          3);
+
+      // RGB2 = RGB3 = avg(RGB0, RGB1), with RGB3 being fully transparent.
+      const __m256i average_left = _mm256_and_si256(
+          _mm256_srli_epi16(_mm256_add_epi16(rrggbb0_left, rrggbb1_left), 1), average_mask);
+      const __m256i average_right = _mm256_and_si256(
+          _mm256_srli_epi16(_mm256_add_epi16(rrggbb0_right, rrggbb1_right), 1), average_mask);
+
+      const __m256i rgb23 = _mm256_blendv_epi8(_mm256_packus_epi16(average_left, average_right),
+                                               _mm256_packus_epi16(blend_left, blend_right),
+                                               opaque);
+
+      // Four-color palettes for the left blocks and the right blocks, then rearranged so that
+      // the two blocks of each row of blocks share a register.
+      const __m256i palettes_left = _mm256_unpacklo_epi64(endpoints, rgb23);
+      const __m256i palettes_right = _mm256_unpackhi_epi64(endpoints, rgb23);
+      const __m256i palettes_top = _mm256_permute2x128_si256(palettes_left, palettes_right, 0x20);
+      const __m256i palettes_bottom =
+          _mm256_permute2x128_si256(palettes_left, palettes_right, 0x31);
+
+      // The 2-bit selectors of each row of a block are stored in one byte, first texel on top.
+      const __m256i lines_top = _mm256_permutevar8x32_epi32(dxt, top_selectors);
+      const __m256i lines_bottom = _mm256_permutevar8x32_epi32(dxt, bottom_selectors);
+
+      __m256i shifts = selector_shifts;
+      for (int iy = 0; iy < 4; iy++)
+      {
+        const __m256i index_top = _mm256_add_epi32(
+            _mm256_and_si256(_mm256_srlv_epi32(lines_top, shifts), mask_x03), palette_offsets);
+        const __m256i index_bottom = _mm256_add_epi32(
+            _mm256_and_si256(_mm256_srlv_epi32(lines_bottom, shifts), mask_x03), palette_offsets);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (y + iy) * width + x),
+                            _mm256_permutevar8x32_epi32(palettes_top, index_top));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + (y + iy + 4) * width + x),
+                            _mm256_permutevar8x32_epi32(palettes_bottom, index_bottom));
+
+        shifts = _mm256_add_epi32(shifts, eight);
+      }
+    }
+  }
+}
+
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt)
 {
@@ -1422,7 +1825,11 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
   switch (texformat)
   {
   case TextureFormat::C4:
-    TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C4_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C4(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::I4:
@@ -1442,7 +1849,11 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C8:
-    TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::IA4:
@@ -1459,8 +1870,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C14X2:
-    TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C14X2_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                  Wsteps8);
     break;
 
   case TextureFormat::RGB565:
@@ -1469,7 +1884,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGB5A3_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                        Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1478,7 +1896,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::RGBA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_RGBA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGBA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                         Wsteps8);
     else
@@ -1487,7 +1908,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::CMPR:
-    TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_CMPR_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                      Wsteps8);
+    else
+      TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                 Wsteps8);
     break;
 
   case TextureFormat::XFB:
@@ -1500,3 +1926,15 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
   }
 }
+
+void _TexDecoder_DecodeRGBA8FromTmemImpl(u32* dst, const u8* src_ar, const u8* src_gb, int width,
+                                         int height)
+{
+  if (cpu_info.bAVX2 && width % 4 == 0 && height % 4 == 0)
+  {
+    TexDecoder_DecodeRGBA8FromTmem_AVX2(dst, src_ar, src_gb, width, height);
+    return;
+  }
+
+  _TexDecoder_DecodeRGBA8FromTmemTexels(dst, src_ar, src_gb, width, height);
+}
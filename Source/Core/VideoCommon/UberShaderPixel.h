@@ -19,6 +19,11 @@ struct pixel_ubershader_uid_data
   u32 per_pixel_depth : 1;
   u32 uint_output : 1;
 
+  // Partially specialized variants. Zero is the generic ubershader, which handles any state.
+  u32 tev_stages_tier : 2;  // See GetMaxTevStages
+  u32 skip_fog : 1;
+  u32 skip_alpha_test : 1;
+
   u32 NumValues() const { return sizeof(pixel_ubershader_uid_data); }
 };
 #pragma pack()
@@ -27,10 +32,17 @@ using PixelShaderUid = ShaderUid<pixel_ubershader_uid_data>;
 
 PixelShaderUid GetPixelShaderUid();
 
+// Returns the number of TEV stages a variant runs at most.
+u32 GetMaxTevStages(u32 tev_stages_tier);
+
 ShaderCode GenPixelShader(APIType api_type, const ShaderHostConfig& host_config,
                           const pixel_ubershader_uid_data* uid_data);
+void GenPixelShader(ShaderCode& out, APIType api_type, const ShaderHostConfig& host_config,
+                    const pixel_ubershader_uid_data* uid_data);
 
-void EnumeratePixelShaderUids(const std::function<void(const PixelShaderUid&)>& callback);
+// Variants are only enumerated if they are enabled in the host config.
+void EnumeratePixelShaderUids(const ShaderHostConfig& host_config,
+                              const std::function<void(const PixelShaderUid&)>& callback);
 void ClearUnusedPixelShaderUidBits(APIType api_type, const ShaderHostConfig& host_config,
                                    PixelShaderUid* uid);
 }  // namespace UberShader
@@ -26,13 +26,20 @@ static void GenVertexShaderTexGens(APIType api_type, u32 num_texgen, ShaderCode&
 
 ShaderCode GenVertexShader(APIType api_type, const ShaderHostConfig& host_config,
                            const vertex_ubershader_uid_data* uid_data)
+{
+  ShaderCode out;
+  GenVertexShader(out, api_type, host_config, uid_data);
+  return out;
+}
+
+void GenVertexShader(ShaderCode& out, APIType api_type, const ShaderHostConfig& host_config,
+                     const vertex_ubershader_uid_data* uid_data)
 {
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
   const bool per_pixel_lighting = host_config.per_pixel_lighting;
   const bool vertex_rounding = host_config.vertex_rounding;
   const u32 num_texgen = uid_data->num_texgens;
-  ShaderCode out;
 
   out.Write("// Vertex UberShader\n\n");
   out.Write("{}", s_lighting_struct);
@@ -363,8 +370,6 @@ ShaderCode GenVertexShader(APIType api_type, const ShaderHostConfig& host_config
     out.Write("return o;\n");
   }
   out.Write("}}\n");
-
-  return out;
 }
 
 static void GenVertexShaderTexGens(APIType api_type, u32 num_texgen, ShaderCode& out)
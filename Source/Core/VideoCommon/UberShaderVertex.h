@@ -23,5 +23,7 @@ VertexShaderUid GetVertexShaderUid();
 
 ShaderCode GenVertexShader(APIType api_type, const ShaderHostConfig& host_config,
                            const vertex_ubershader_uid_data* uid_data);
+void GenVertexShader(ShaderCode& out, APIType api_type, const ShaderHostConfig& host_config,
+                     const vertex_ubershader_uid_data* uid_data);
 void EnumerateVertexShaderUids(const std::function<void(const VertexShaderUid&)>& callback);
 }  // namespace UberShader
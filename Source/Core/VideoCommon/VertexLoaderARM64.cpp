@@ -609,7 +609,7 @@ void VertexLoaderARM64::GenerateVertexLoader()
 
 int VertexLoaderARM64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
+  m_numLoadedVertices.fetch_add(count, std::memory_order_relaxed);
   return ((int (*)(u8 * src, u8 * dst, int count)) region)(src.GetPointer(), dst.GetPointer(),
                                                            count);
 }
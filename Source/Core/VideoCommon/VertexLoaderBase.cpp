@@ -84,7 +84,7 @@ public:
     }
 
     memcpy(dst.GetPointer(), buffer_a.data(), count_a * m_native_vtx_decl.stride);
-    m_numLoadedVertices += count;
+    m_numLoadedVertices.fetch_add(count, std::memory_order_relaxed);
     return count_a;
   }
 
@@ -131,6 +131,23 @@ static void GetComponentSizes(const TVtxDesc& vtx_desc, const VAT& vtx_attr, Fun
   }
 }
 
+bool VertexLoaderBase::ReadsVertexArrays() const
+{
+  if (IsIndexed(m_VtxDesc.low.Position) || IsIndexed(m_VtxDesc.low.Normal))
+    return true;
+  for (auto color : m_VtxDesc.low.Color)
+  {
+    if (IsIndexed(color))
+      return true;
+  }
+  for (auto texcoord : m_VtxDesc.high.TexCoord)
+  {
+    if (IsIndexed(texcoord))
+      return true;
+  }
+  return false;
+}
+
 u32 VertexLoaderBase::GetVertexSize(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
 {
   u32 size = 0;
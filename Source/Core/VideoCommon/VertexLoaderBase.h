@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -31,8 +32,29 @@ public:
     hash = CalculateHash();
   }
 
+  // Restores a UID from the raw register values returned by GetData().
+  explicit VertexLoaderUID(const std::array<u32, 5>& data) : vid(data), hash(CalculateHash()) {}
+
   bool operator==(const VertexLoaderUID& rh) const { return vid == rh.vid; }
   size_t GetHash() const { return hash; }
+  const std::array<u32, 5>& GetData() const { return vid; }
+
+  TVtxDesc GetVtxDesc() const
+  {
+    TVtxDesc vtx_desc;
+    vtx_desc.low.Hex = vid[0];
+    vtx_desc.high.Hex = vid[1];
+    return vtx_desc;
+  }
+
+  VAT GetVAT() const
+  {
+    VAT vat;
+    vat.g0.Hex = vid[2];
+    vat.g1.Hex = vid[3];
+    vat.g2.Hex = vid[4];
+    return vat;
+  }
 
 private:
   size_t CalculateHash() const
@@ -68,6 +90,9 @@ public:
   virtual ~VertexLoaderBase() {}
   virtual int RunVertices(DataReader src, DataReader dst, int count) = 0;
 
+  // Whether any attribute is indexed, and so read from the vertex arrays in RAM.
+  bool ReadsVertexArrays() const;
+
   // per loader public state
   PortableVertexDeclaration m_native_vtx_decl{};
   const u32 m_vertex_size;  // number of bytes of a raw GC vertex
@@ -75,7 +100,9 @@ public:
 
   // used by VertexLoaderManager
   NativeVertexFormat* m_native_vertex_format = nullptr;
-  int m_numLoadedVertices = 0;
+  // Written by whichever thread converts the vertices, and read by the statistics overlay.
+  std::atomic<u64> m_numLoadedVertices{0};
+  std::atomic<u64> m_load_time_ns{0};  // only measured while the statistics overlay is shown
 
 protected:
   VertexLoaderBase(const TVtxDesc& vtx_desc, const VAT& vtx_attr)
@@ -4,23 +4,36 @@
 #include "VideoCommon/VertexLoaderManager.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
+#include "Common/Event.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
 #include "Common/Logging/Log.h"
+#include "Common/WorkQueueThread.h"
 
+#include "Core/ConfigManager.h"
 #include "Core/HW/Memmap.h"
+#include "Core/System.h"
 
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/Fifo.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/RenderBase.h"
@@ -28,6 +41,7 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexManagerBase.h"
 #include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/VideoConfig.h"
 
 namespace VertexLoaderManager
 {
@@ -44,7 +58,46 @@ u32 g_current_components;
 typedef std::unordered_map<VertexLoaderUID, std::unique_ptr<VertexLoaderBase>> VertexLoaderMap;
 static std::mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
-// TODO - change into array of pointers. Keep a map of all seen so far.
+
+// UIDs of every loader created so far, so that they can be compiled ahead of time next session.
+static File::IOFile s_loader_uid_cache_file;
+constexpr u32 LOADER_UID_CACHE_MAGIC = 0x44495556;  // VUID
+constexpr u32 LOADER_UID_CACHE_VERSION = 1;
+using SerializedVertexLoaderUID = std::array<u32, 5>;
+
+// Small direct-mapped caches of recently used loaders per VAT, in front of s_vertex_loader_map.
+// Games rewrite the vertex descriptor and VAT all the time, but usually only cycle through a
+// handful of formats, so most refreshes can be resolved without taking s_vertex_loader_map_lock.
+// Each cache is only accessed by its own thread, and loaders are never destroyed before Clear().
+struct LoaderCacheEntry
+{
+  VertexLoaderUID uid;
+  VertexLoaderBase* loader = nullptr;
+};
+constexpr size_t LOADER_CACHE_SIZE = 4;
+using LoaderCache = std::array<std::array<LoaderCacheEntry, LOADER_CACHE_SIZE>, CP_NUM_VAT_REG>;
+static LoaderCache s_main_loader_cache;
+static LoaderCache s_preprocess_loader_cache;
+
+// In dual core mode, vertices can be converted on a worker thread. The GPU thread still reserves
+// the output space, generates the indices and moves on to the next command, so only the
+// conversion itself is deferred. Only vertices which are entirely in the FIFO are deferred, as
+// those in display lists and vertex arrays may be changed in RAM. Anything which reads the
+// converted vertices, or overwrites the FIFO, has to call WaitForVertexLoading() first.
+struct VertexLoadingJob
+{
+  VertexLoaderBase* loader;
+  DataReader src;
+  DataReader dst;
+  int count;
+  bool measure_time;
+};
+static Common::WorkQueueThread<VertexLoadingJob> s_vertex_loading_thread;
+static bool s_vertex_loading_thread_running = false;
+static u32 s_vertex_loading_jobs_queued = 0;  // GPU thread only
+static std::atomic<u32> s_vertex_loading_jobs_done{0};
+static std::atomic<u64> s_vertex_loading_time_ns{0};
+static Common::Event s_vertex_loading_done_event;
 
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
@@ -62,16 +115,140 @@ void Init()
     map_entry = nullptr;
   for (auto& map_entry : g_preprocess_vertex_loaders)
     map_entry = nullptr;
+  s_main_loader_cache = {};
+  s_preprocess_loader_cache = {};
   SETSTAT(g_stats.num_vertex_loaders, 0);
 }
 
 void Clear()
 {
+  StopVertexLoadingThread();
+
   std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  s_loader_uid_cache_file.Close();
+  s_main_loader_cache = {};
+  s_preprocess_loader_cache = {};
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
 
+static VertexLoaderBase* CreateLoader(const VertexLoaderUID& uid)
+{
+  std::unique_ptr<VertexLoaderBase>& loader = s_vertex_loader_map[uid];
+  loader = VertexLoaderBase::CreateVertexLoader(uid.GetVtxDesc(), uid.GetVAT());
+  INCSTAT(g_stats.num_vertex_loaders);
+
+  if (s_loader_uid_cache_file.IsOpen())
+  {
+    const SerializedVertexLoaderUID& data = uid.GetData();
+    s_loader_uid_cache_file.WriteBytes(data.data(), sizeof(data));
+    s_loader_uid_cache_file.Flush();
+  }
+
+  return loader.get();
+}
+
+void LoadLoaderUIDCache()
+{
+  if (!g_ActiveConfig.bShaderCache)
+    return;
+
+  constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
+  const std::string filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".vluidcache";
+
+  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  std::vector<VertexLoaderUID> uids;
+  if (s_loader_uid_cache_file.Open(filename, "rb+"))
+  {
+    u32 existing_magic;
+    u32 existing_version;
+    bool uid_file_valid = false;
+    if (s_loader_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
+        s_loader_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
+        existing_magic == LOADER_UID_CACHE_MAGIC && existing_version == LOADER_UID_CACHE_VERSION)
+    {
+      // A size mismatch means the file was only partially written, so don't trust any of it.
+      const u64 file_size = s_loader_uid_cache_file.GetSize();
+      const size_t uid_count =
+          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedVertexLoaderUID);
+      const size_t expected_size =
+          uid_count * sizeof(SerializedVertexLoaderUID) + CACHE_HEADER_SIZE;
+      uid_file_valid = file_size == expected_size;
+      for (size_t i = 0; uid_file_valid && i < uid_count; i++)
+      {
+        SerializedVertexLoaderUID data;
+        uid_file_valid = s_loader_uid_cache_file.ReadBytes(data.data(), sizeof(data));
+        uids.emplace_back(data);
+      }
+
+      // We open the file for reading and writing, so we must seek to the end before writing.
+      if (uid_file_valid)
+        uid_file_valid = s_loader_uid_cache_file.Seek(expected_size, SEEK_SET);
+    }
+
+    if (!uid_file_valid)
+    {
+      uids.clear();
+      s_loader_uid_cache_file.Close();
+    }
+  }
+
+  if (!s_loader_uid_cache_file.IsOpen())
+  {
+    if (!s_loader_uid_cache_file.Open(filename, "wb"))
+      return;
+
+    s_loader_uid_cache_file.WriteBytes(&LOADER_UID_CACHE_MAGIC, sizeof(LOADER_UID_CACHE_MAGIC));
+    s_loader_uid_cache_file.WriteBytes(&LOADER_UID_CACHE_VERSION,
+                                       sizeof(LOADER_UID_CACHE_VERSION));
+    for (const auto& it : s_vertex_loader_map)
+    {
+      const SerializedVertexLoaderUID& data = it.first.GetData();
+      s_loader_uid_cache_file.WriteBytes(data.data(), sizeof(data));
+    }
+  }
+
+  // Compile the loaders now, rather than on their first draw. Their native vertex formats are
+  // still created lazily, as that has to happen on the GPU thread.
+  for (const VertexLoaderUID& uid : uids)
+  {
+    if (s_vertex_loader_map.find(uid) != s_vertex_loader_map.end())
+      continue;
+
+    std::unique_ptr<VertexLoaderBase>& loader = s_vertex_loader_map[uid];
+    loader = VertexLoaderBase::CreateVertexLoader(uid.GetVtxDesc(), uid.GetVAT());
+    INCSTAT(g_stats.num_vertex_loaders);
+  }
+
+  INFO_LOG_FMT(VIDEO, "Compiled {} vertex loaders from {}", uids.size(), filename);
+}
+
+std::vector<LoaderStatistics> GetLoaderStatistics()
+{
+  std::vector<LoaderStatistics> statistics;
+  {
+    std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+    statistics.reserve(s_vertex_loader_map.size());
+    for (const auto& [uid, loader] : s_vertex_loader_map)
+    {
+      const SerializedVertexLoaderUID& data = uid.GetData();
+      statistics.push_back({fmt::format("{:08x}{:08x}:{:08x}{:08x}{:08x}", data[1], data[0],
+                                        data[2], data[3], data[4]),
+                            loader->m_vertex_size,
+                            loader->m_numLoadedVertices.load(std::memory_order_relaxed),
+                            loader->m_load_time_ns.load(std::memory_order_relaxed)});
+    }
+  }
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const LoaderStatistics& a, const LoaderStatistics& b) {
+              return std::tie(a.load_time_ns, a.num_vertices) >
+                     std::tie(b.load_time_ns, b.num_vertices);
+            });
+  return statistics;
+}
+
 void UpdateVertexArrayPointers()
 {
   // Anything to update?
@@ -109,16 +286,6 @@ void UpdateVertexArrayPointers()
   g_bases_dirty = false;
 }
 
-namespace
-{
-struct entry
-{
-  std::string text;
-  u64 num_verts;
-  bool operator<(const entry& other) const { return num_verts > other.num_verts; }
-};
-}  // namespace
-
 void MarkAllDirty()
 {
   g_main_vat_dirty = BitSet8::AllTrue(8);
@@ -195,11 +362,73 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl)
   return GetOrCreateMatchingFormat(new_decl);
 }
 
+static void RunVertexLoadingJob(VertexLoadingJob job)
+{
+  if (job.measure_time)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    job.loader->RunVertices(job.src, job.dst, job.count);
+    const u64 time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            std::chrono::steady_clock::now() - start)
+                            .count();
+    job.loader->m_load_time_ns.fetch_add(time_ns, std::memory_order_relaxed);
+    s_vertex_loading_time_ns.fetch_add(time_ns, std::memory_order_relaxed);
+  }
+  else
+  {
+    job.loader->RunVertices(job.src, job.dst, job.count);
+  }
+
+  s_vertex_loading_jobs_done.fetch_add(1, std::memory_order_release);
+  s_vertex_loading_done_event.Set();
+}
+
+static bool UseVertexLoadingThread()
+{
+  // With a deterministic GPU thread, the FIFO data may be reused once a command is decoded.
+  return g_ActiveConfig.bPipelinedVertexLoading &&
+         Core::System::GetInstance().IsDualCoreMode() && !Fifo::UseDeterministicGPUThread();
+}
+
+void WaitForVertexLoading()
+{
+  if (s_vertex_loading_jobs_done.load(std::memory_order_acquire) != s_vertex_loading_jobs_queued)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    while (s_vertex_loading_jobs_done.load(std::memory_order_acquire) !=
+           s_vertex_loading_jobs_queued)
+    {
+      s_vertex_loading_done_event.Wait();
+    }
+    ADDSTAT(g_stats.this_frame.vertex_loading_stall_ns,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+  }
+
+  if (s_vertex_loading_time_ns.load(std::memory_order_relaxed) != 0)
+  {
+    ADDSTAT(g_stats.this_frame.vertex_loading_ns,
+            s_vertex_loading_time_ns.exchange(0, std::memory_order_relaxed));
+  }
+}
+
+void StopVertexLoadingThread()
+{
+  if (!s_vertex_loading_thread_running)
+    return;
+
+  WaitForVertexLoading();
+  s_vertex_loading_thread.Cancel();
+  s_vertex_loading_thread_running = false;
+}
+
 static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = false)
 {
   CPState* state = preprocess ? &g_preprocess_cp_state : &g_main_cp_state;
   BitSet8& attr_dirty = preprocess ? g_preprocess_vat_dirty : g_main_vat_dirty;
-  auto& vertex_loaders = preprocess ? g_main_vertex_loaders : g_preprocess_vertex_loaders;
+  auto& vertex_loaders = preprocess ? g_preprocess_vertex_loaders : g_main_vertex_loaders;
+  auto& loader_cache = preprocess ? s_preprocess_loader_cache : s_main_loader_cache;
   g_current_vat = vtx_attr_group;
 
   VertexLoaderBase* loader;
@@ -210,20 +439,22 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
     bool check_for_native_format = !preprocess;
 
     VertexLoaderUID uid(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
-    std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
-    VertexLoaderMap::iterator iter = s_vertex_loader_map.find(uid);
-    if (iter != s_vertex_loader_map.end())
+    LoaderCacheEntry& cache_entry = loader_cache[vtx_attr_group][uid.GetHash() % LOADER_CACHE_SIZE];
+    if (cache_entry.loader && cache_entry.uid == uid)
     {
-      loader = iter->second.get();
-      check_for_native_format &= !loader->m_native_vertex_format;
+      loader = cache_entry.loader;
     }
     else
     {
-      s_vertex_loader_map[uid] =
-          VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
-      loader = s_vertex_loader_map[uid].get();
-      INCSTAT(g_stats.num_vertex_loaders);
+      std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+      VertexLoaderMap::iterator iter = s_vertex_loader_map.find(uid);
+      if (iter != s_vertex_loader_map.end())
+        loader = iter->second.get();
+      else
+        loader = CreateLoader(uid);
+      cache_entry = {uid, loader};
     }
+    check_for_native_format &= !loader->m_native_vertex_format;
     if (check_for_native_format)
     {
       // search for a cached native vertex format
@@ -249,7 +480,7 @@ static VertexLoaderBase* RefreshLoader(int vtx_attr_group, bool preprocess = fal
 }
 
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src,
-                bool is_preprocess)
+                bool is_preprocess, bool in_display_list)
 {
   if (!count)
     return 0;
@@ -282,7 +513,43 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
   DataReader dst = g_vertex_manager->PrepareForAdditionalData(
       primitive, count, loader->m_native_vtx_decl.stride, cullall);
 
-  count = loader->RunVertices(src, dst, count);
+  // The CPU may change display lists and vertex arrays in RAM as soon as the GPU thread has moved
+  // past them, while the FIFO only gets overwritten once the worker is done with it.
+  if (!in_display_list && !loader->ReadsVertexArrays() && UseVertexLoadingThread())
+  {
+    if (!s_vertex_loading_thread_running)
+    {
+      s_vertex_loading_thread.Reset(RunVertexLoadingJob);
+      s_vertex_loading_thread_running = true;
+    }
+
+    // Without a position index, no vertex is skipped, so the indices only depend on the count
+    // and can be generated right away. The source stays valid until the FIFO is compacted, which
+    // waits for the worker.
+    s_vertex_loading_jobs_queued++;
+    s_vertex_loading_thread.EmplaceItem(
+        VertexLoadingJob{loader, src, dst, count, g_ActiveConfig.bOverlayStats});
+  }
+  else
+  {
+    // Keep the output in order with the vertices still queued on the worker.
+    WaitForVertexLoading();
+
+    if (g_ActiveConfig.bOverlayStats)
+    {
+      const auto start = std::chrono::steady_clock::now();
+      count = loader->RunVertices(src, dst, count);
+      const u64 time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+      loader->m_load_time_ns.fetch_add(time_ns, std::memory_order_relaxed);
+      ADDSTAT(g_stats.this_frame.vertex_loading_ns, time_ns);
+    }
+    else
+    {
+      count = loader->RunVertices(src, dst, count);
+    }
+  }
 
   g_vertex_manager->AddIndices(primitive, count);
   g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
@@ -7,6 +7,7 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
@@ -29,8 +30,26 @@ using NativeVertexFormatMap =
 void Init();
 void Clear();
 
+// Compiles the loaders used in previous sessions of the current game, and records any new ones.
+void LoadLoaderUIDCache();
+
+struct LoaderStatistics
+{
+  std::string name;
+  u32 vertex_size;
+  u64 num_vertices;
+  u64 load_time_ns;
+};
+
+// Returns the statistics of all loaders, most expensive first.
+std::vector<LoaderStatistics> GetLoaderStatistics();
+
 void MarkAllDirty();
 
+// Waits until all vertices queued for conversion on the vertex loading thread are written.
+void WaitForVertexLoading();
+void StopVertexLoadingThread();
+
 // Creates or obtains a pointer to a VertexFormat representing decl.
 // If this results in a VertexFormat being created, if the game later uses a matching vertex
 // declaration, the one that was previously created will be used.
@@ -41,9 +60,11 @@ NativeVertexFormat* GetOrCreateMatchingFormat(const PortableVertexDeclaration& d
 // offsets set to the unused attributes.
 NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 
-// Returns -1 if buf_size is insufficient, else the amount of bytes consumed
+// Returns -1 if buf_size is insufficient, else the amount of bytes consumed. Vertices from a
+// display list or indexed vertex arrays are read straight from guest RAM rather than from the
+// FIFO, so they are never left to the vertex loading thread.
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, DataReader src,
-                bool is_preprocess);
+                bool is_preprocess, bool in_display_list);
 
 NativeVertexFormat* GetCurrentVertexFormat();
 
@@ -6,6 +6,7 @@
 #include <array>
 #include <cstring>
 #include <string>
+#include <vector>
 
 #include "Common/BitSet.h"
 #include "Common/CPUDetect.h"
@@ -42,10 +43,74 @@ static OpArg MPIC(const void* ptr)
   return MDisp(base_reg, PtrOffset(ptr, memory_base_ptr));
 }
 
+alignas(16) static const __m128i shuffle_lut[5][3] = {
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
+     _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
+     _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
+    {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
+     _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
+     _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
+};
+alignas(16) static const __m128 scale_factors[32] = {
+    _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
+    _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
+    _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
+    _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
+    _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
+    _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
+    _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
+    _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
+    _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
+    _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
+    _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
+};
+
+// The same constants repeated in both 128-bit lanes, for converting two vertices at once.
+struct alignas(32) LaneConstant
+{
+  u8 bytes[32];
+};
+
+template <typename T>
+static LaneConstant RepeatInLanes(const T& value)
+{
+  static_assert(sizeof(T) == 16);
+  LaneConstant constant;
+  std::memcpy(constant.bytes, &value, sizeof(value));
+  std::memcpy(constant.bytes + sizeof(value), &value, sizeof(value));
+  return constant;
+}
+
+static const auto shuffle_lut_256 = [] {
+  std::array<std::array<LaneConstant, 3>, 5> lut;
+  for (size_t i = 0; i < lut.size(); i++)
+  {
+    for (size_t j = 0; j < lut[i].size(); j++)
+      lut[i][j] = RepeatInLanes(shuffle_lut[i][j]);
+  }
+  return lut;
+}();
+
+static const auto scale_factors_256 = [] {
+  std::array<LaneConstant, 32> factors;
+  for (size_t i = 0; i < factors.size(); i++)
+    factors[i] = RepeatInLanes(scale_factors[i]);
+  return factors;
+}();
+
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
-  AllocCodeSpace(4096);
+  AllocCodeSpace(8192);
   ClearCodeSpace();
   GenerateVertexLoader();
   WriteProtect();
@@ -68,9 +133,7 @@ OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attrib
       CMP(bits, R(scratch1), Imm8(-1));
       m_skip_vertex = J_CC(CC_E, true);
     }
-    IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[array]));
-    MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[array]));
-    return MRegSum(scratch1, scratch2);
+    return GetArrayAddr(array);
   }
   else
   {
@@ -78,41 +141,28 @@ OpArg VertexLoaderX64::GetVertexAddr(CPArray array, VertexComponentFormat attrib
   }
 }
 
+OpArg VertexLoaderX64::GetArrayAddr(CPArray array)
+{
+  IMUL(32, scratch1, MPIC(&g_main_cp_state.array_strides[array]));
+  MOV(64, R(scratch2), MPIC(&VertexLoaderManager::cached_arraybases[array]));
+  return MRegSum(scratch1, scratch2);
+}
+
+OpArg VertexLoaderX64::GetPairVertexAddr(CPArray array, VertexComponentFormat attribute,
+                                         u32 src_ofs, int vertex)
+{
+  OpArg data = MDisp(src_reg, src_ofs + vertex * m_vertex_size);
+  if (!IsIndexed(attribute))
+    return data;
+
+  LoadAndSwap(attribute == VertexComponentFormat::Index8 ? 8 : 16, scratch1, data);
+  return GetArrayAddr(array);
+}
+
 int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                                 int count_in, int count_out, bool dequantize, u8 scaling_exponent,
                                 AttributeFormat* native_format)
 {
-  static const __m128i shuffle_lut[5][3] = {
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
-       _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
-       _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
-      {_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
-       _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
-       _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
-  };
-  static const __m128 scale_factors[32] = {
-      _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
-      _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
-      _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
-      _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
-      _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
-      _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
-      _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
-      _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
-      _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
-      _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
-      _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
-  };
-
   X64Reg coords = XMM0;
 
   int elem_size = GetElementSize(format);
@@ -265,7 +315,7 @@ int VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute, Com
   return load_bytes;
 }
 
-void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, ColorFormat format)
+int VertexLoaderX64::ReadColor(OpArg data, ColorFormat format, const OpArg& dest)
 {
   int load_bytes = 0;
   switch (format)
@@ -276,7 +326,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     MOV(32, R(scratch1), data);
     if (format != ColorFormat::RGBA8888)
       OR(32, R(scratch1), Imm32(0xFF000000));
-    MOV(32, MDisp(dst_reg, m_dst_ofs), R(scratch1));
+    MOV(32, dest, R(scratch1));
     load_bytes = format == ColorFormat::RGB888 ? 3 : 4;
     break;
 
@@ -316,7 +366,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
       OR(32, R(scratch1), R(scratch2));
     }
     OR(32, R(scratch1), Imm32(0x000000FF));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, dest, scratch1);
     load_bytes = 2;
     break;
 
@@ -344,7 +394,7 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     MOV(32, R(scratch2), R(scratch1));
     SHL(32, R(scratch1), Imm8(4));
     OR(32, R(scratch1), R(scratch2));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, dest, scratch1);
     load_bytes = 2;
     break;
 
@@ -376,12 +426,11 @@ void VertexLoaderX64::ReadColor(OpArg data, VertexComponentFormat attribute, Col
     SHR(32, R(scratch1), Imm8(6));
     AND(32, R(scratch1), Imm32(0x03030303));
     OR(32, R(scratch1), R(scratch2));
-    SwapAndStore(32, MDisp(dst_reg, m_dst_ofs), scratch1);
+    SwapAndStore(32, dest, scratch1);
     load_bytes = 3;
     break;
   }
-  if (attribute == VertexComponentFormat::Direct)
-    m_src_ofs += load_bytes;
+  return load_bytes;
 }
 
 void VertexLoaderX64::GenerateVertexLoader()
@@ -404,6 +453,11 @@ void VertexLoaderX64::GenerateVertexLoader()
 
   // TODO: load constants into registers outside the main loop
 
+  const bool load_pairs = CanLoadVertexPairs();
+  FixupBranch to_pair_loop;
+  if (load_pairs)
+    to_pair_loop = J(true);
+
   const u8* loop_start = GetCodePtr();
 
   if (m_VtxDesc.low.PosMatIdx)
@@ -463,7 +517,10 @@ void VertexLoaderX64::GenerateVertexLoader()
     if (m_VtxDesc.low.Color[i] != VertexComponentFormat::NotPresent)
     {
       data = GetVertexAddr(CPArray::Color0 + i, m_VtxDesc.low.Color[i]);
-      ReadColor(data, m_VtxDesc.low.Color[i], m_VtxAttr.GetColorFormat(i));
+      const int load_bytes =
+          ReadColor(data, m_VtxAttr.GetColorFormat(i), MDisp(dst_reg, m_dst_ofs));
+      if (m_VtxDesc.low.Color[i] == VertexComponentFormat::Direct)
+        m_src_ofs += load_bytes;
       m_native_vtx_decl.colors[i].components = 4;
       m_native_vtx_decl.colors[i].enable = true;
       m_native_vtx_decl.colors[i].offset = m_dst_ofs;
@@ -515,7 +572,11 @@ void VertexLoaderX64::GenerateVertexLoader()
   ADD(64, R(src_reg), Imm32(m_src_ofs));
 
   SUB(32, R(count_reg), Imm8(1));
-  J_CC(CC_NZ, loop_start);
+  FixupBranch next_pair;
+  if (load_pairs)
+    next_pair = J_CC(CC_NZ, true);
+  else
+    J_CC(CC_NZ, loop_start);
 
   // Get the original count.
   POP(32, R(ABI_RETURN));
@@ -538,11 +599,230 @@ void VertexLoaderX64::GenerateVertexLoader()
 
   ASSERT(m_vertex_size == m_src_ofs);
   m_native_vtx_decl.stride = m_dst_ofs;
+
+  // The pair loop needs the final layout, so it's generated last.
+  if (load_pairs)
+  {
+    SetJumpTarget(to_pair_loop);
+    SetJumpTarget(next_pair);
+    GenerateVertexPairLoader(loop_start);
+  }
+}
+
+bool VertexLoaderX64::CanLoadVertexPairs() const
+{
+  // Direct normals with NormalIndex3 set are laid out differently from the indexed ones, leave
+  // that odd case to the single vertex loop.
+  return cpu_info.bAVX2 && !(m_VtxDesc.low.Normal == VertexComponentFormat::Direct &&
+                             m_VtxAttr.g0.NormalIndex3);
+}
+
+void VertexLoaderX64::ReadVertexPair(CPArray array, VertexComponentFormat attribute, u32 src_ofs,
+                                     u32 data_ofs, ComponentFormat format, int count_in,
+                                     int count_out, bool dequantize, u8 scaling_exponent,
+                                     u32 dst_ofs)
+{
+  const int load_bytes = GetElementSize(format) * count_in;
+  for (int vertex = 0; vertex < 2; vertex++)
+  {
+    OpArg data = GetPairVertexAddr(array, attribute, src_ofs, vertex);
+    data.AddMemOffset(data_ofs);
+
+    const X64Reg coords = vertex ? XMM1 : XMM0;
+    if (load_bytes > 8)
+      VMOVDQU(coords, data);
+    else if (load_bytes > 4)
+      VMOVQ_xmm(coords, data);
+    else
+      VMOVD_xmm(coords, data);
+  }
+
+  // Both vertices are converted at once, one per 128-bit lane.
+  VINSERTI128(YMM0, YMM0, R(XMM1), 1);
+  VPSHUFB_ymm(YMM0, YMM0, MPIC(&shuffle_lut_256[u32(format)][count_in - 1]));
+  if (format == ComponentFormat::Byte)
+    VPSRAD_ymm(YMM0, YMM0, 24);
+  if (format == ComponentFormat::Short)
+    VPSRAD_ymm(YMM0, YMM0, 16);
+  if (format != ComponentFormat::Float)
+  {
+    VCVTDQ2PS_ymm(YMM0, R(YMM0));
+    if (dequantize && scaling_exponent)
+      VMULPS_ymm(YMM0, YMM0, MPIC(&scale_factors_256[scaling_exponent]));
+  }
+  VEXTRACTI128(R(XMM1), YMM0, 1);
+
+  const u32 stride = static_cast<u32>(m_native_vtx_decl.stride);
+  for (int vertex = 0; vertex < 2; vertex++)
+  {
+    const X64Reg coords = vertex ? XMM1 : XMM0;
+    const OpArg dest = MDisp(dst_reg, dst_ofs + vertex * stride);
+    switch (count_out)
+    {
+    case 1:
+      VMOVSS(dest, coords);
+      break;
+    case 2:
+      VMOVLPS(dest, coords);
+      break;
+    case 3:
+      // A 16 byte store would overwrite the start of the second vertex, which is already done.
+      if (vertex == 0 && dst_ofs + 4 * sizeof(float) > stride)
+      {
+        VMOVLPS(dest, coords);
+        VMOVHLPS(XMM2, XMM2, coords);
+        VMOVSS(MDisp(dst_reg, dst_ofs + 2 * sizeof(float)), XMM2);
+      }
+      else
+      {
+        VMOVUPS(dest, coords);
+      }
+      break;
+    }
+  }
+}
+
+void VertexLoaderX64::GenerateVertexPairLoader(const u8* single_vertex_loop)
+{
+  const u32 stride = static_cast<u32>(m_native_vtx_decl.stride);
+  const u8* pair_loop = GetCodePtr();
+
+  // The pair loop leaves the upper halves of the YMM registers dirty, so everything in it is VEX
+  // encoded, and they are only cleared once on the way out. It always ends in the single vertex
+  // loop, which uses SSE.
+  std::vector<FixupBranch> exits;
+
+  // zfreeze needs the last three vertices, which are left to the single vertex loop, as are
+  // vertices skipped because of their position index.
+  CMP(32, R(count_reg), Imm8(5));
+  exits.push_back(J_CC(CC_B, true));
+
+  u32 src_ofs = m_VtxDesc.low.PosMatIdx ? 1 : 0;
+  std::array<u32, 8> texmatidx_ofs;
+  for (size_t i = 0; i < m_VtxDesc.low.TexMatIdx.Size(); i++)
+  {
+    if (m_VtxDesc.low.TexMatIdx[i])
+      texmatidx_ofs[i] = src_ofs++;
+  }
+
+  if (IsIndexed(m_VtxDesc.low.Position))
+  {
+    const int bits = m_VtxDesc.low.Position == VertexComponentFormat::Index8 ? 8 : 16;
+    for (int vertex = 0; vertex < 2; vertex++)
+    {
+      CMP(bits, MDisp(src_reg, src_ofs + vertex * m_vertex_size),
+          bits == 8 ? Imm8(0xFF) : Imm16(0xFFFF));
+      exits.push_back(J_CC(CC_E, true));
+    }
+  }
+
+  if (m_VtxDesc.low.PosMatIdx)
+  {
+    for (int vertex = 0; vertex < 2; vertex++)
+    {
+      MOVZX(32, 8, scratch1, MDisp(src_reg, vertex * m_vertex_size));
+      AND(32, R(scratch1), Imm8(0x3F));
+      MOV(32, MDisp(dst_reg, m_native_vtx_decl.posmtx.offset + vertex * stride), R(scratch1));
+    }
+  }
+
+  // Returns the number of bytes the attribute takes up in the vertex itself.
+  const auto attribute_size = [](VertexComponentFormat attribute, int direct_size) {
+    if (IsIndexed(attribute))
+      return attribute == VertexComponentFormat::Index8 ? 1 : 2;
+    return direct_size;
+  };
+
+  const VertexComponentFormat position = m_VtxDesc.low.Position;
+  const ComponentFormat pos_format = m_VtxAttr.g0.PosFormat;
+  const int pos_elements = m_VtxAttr.g0.PosElements == CoordComponentCount::XY ? 2 : 3;
+  ReadVertexPair(CPArray::Position, position, src_ofs, 0, pos_format, pos_elements, pos_elements,
+                 m_VtxAttr.g0.ByteDequant, m_VtxAttr.g0.PosFrac,
+                 m_native_vtx_decl.position.offset);
+  src_ofs += attribute_size(position, GetElementSize(pos_format) * pos_elements);
+
+  const VertexComponentFormat normal = m_VtxDesc.low.Normal;
+  if (normal != VertexComponentFormat::NotPresent)
+  {
+    static const u8 map[8] = {7, 6, 15, 14};
+    const ComponentFormat format = m_VtxAttr.g0.NormalFormat;
+    const u8 scaling_exponent = map[u32(format)];
+    const int limit = m_VtxAttr.g0.NormalElements == NormalComponentCount::NBT ? 3 : 1;
+    const int elem_size = GetElementSize(format);
+    const bool index3 = IsIndexed(normal) && m_VtxAttr.g0.NormalIndex3;
+
+    for (int i = 0; i < limit; i++)
+    {
+      // With a single index, all three normals are next to each other in the array.
+      const u32 data_ofs = IsIndexed(normal) ? i * elem_size * 3 : 0;
+      ReadVertexPair(CPArray::Normal, normal, src_ofs, data_ofs, format, 3, 3, true,
+                     scaling_exponent, m_native_vtx_decl.normals[i].offset);
+      if (!IsIndexed(normal) || index3)
+        src_ofs += attribute_size(normal, elem_size * 3);
+    }
+    if (IsIndexed(normal) && !index3)
+      src_ofs += attribute_size(normal, 0);
+  }
+
+  for (u8 i = 0; i < m_VtxDesc.low.Color.Size(); i++)
+  {
+    const VertexComponentFormat color = m_VtxDesc.low.Color[i];
+    if (color == VertexComponentFormat::NotPresent)
+      continue;
+
+    int load_bytes = 0;
+    for (int vertex = 0; vertex < 2; vertex++)
+    {
+      const OpArg data = GetPairVertexAddr(CPArray::Color0 + i, color, src_ofs, vertex);
+      load_bytes = ReadColor(data, m_VtxAttr.GetColorFormat(i),
+                             MDisp(dst_reg, m_native_vtx_decl.colors[i].offset + vertex * stride));
+    }
+    src_ofs += attribute_size(color, load_bytes);
+  }
+
+  for (u8 i = 0; i < m_VtxDesc.high.TexCoord.Size(); i++)
+  {
+    const VertexComponentFormat texcoord = m_VtxDesc.high.TexCoord[i];
+    const u32 dst_ofs = m_native_vtx_decl.texcoords[i].offset;
+    if (texcoord != VertexComponentFormat::NotPresent)
+    {
+      const ComponentFormat format = m_VtxAttr.GetTexFormat(i);
+      const int elements = m_VtxAttr.GetTexElements(i) == TexComponentCount::ST ? 2 : 1;
+      ReadVertexPair(CPArray::TexCoord0 + i, texcoord, src_ofs, 0, format, elements,
+                     m_VtxDesc.low.TexMatIdx[i] ? 2 : elements, m_VtxAttr.g0.ByteDequant,
+                     m_VtxAttr.GetTexFrac(i), dst_ofs);
+      src_ofs += attribute_size(texcoord, GetElementSize(format) * elements);
+    }
+    if (m_VtxDesc.low.TexMatIdx[i])
+    {
+      for (int vertex = 0; vertex < 2; vertex++)
+      {
+        const u32 vertex_dst_ofs = dst_ofs + vertex * stride;
+        MOVZX(64, 8, scratch1, MDisp(src_reg, texmatidx_ofs[i] + vertex * m_vertex_size));
+        if (texcoord == VertexComponentFormat::NotPresent)
+          MOV(64, MDisp(dst_reg, vertex_dst_ofs), Imm32(0));
+        VCVTSI2SS(XMM0, XMM0, R(scratch1));
+        VMOVSS(MDisp(dst_reg, vertex_dst_ofs + 2 * sizeof(float)), XMM0);
+      }
+    }
+  }
+
+  ASSERT(src_ofs == m_vertex_size);
+
+  ADD(64, R(dst_reg), Imm32(2 * stride));
+  ADD(64, R(src_reg), Imm32(2 * m_vertex_size));
+  SUB(32, R(count_reg), Imm8(2));
+  JMP(pair_loop, true);
+
+  for (FixupBranch& exit : exits)
+    SetJumpTarget(exit);
+  VZEROUPPER();
+  JMP(single_vertex_loop, true);
 }
 
 int VertexLoaderX64::RunVertices(DataReader src, DataReader dst, int count)
 {
-  m_numLoadedVertices += count;
+  m_numLoadedVertices.fetch_add(count, std::memory_order_relaxed);
   return ((int (*)(u8*, u8*, int, const void*))region)(src.GetPointer(), dst.GetPointer(), count,
                                                        memory_base_ptr);
 }
@@ -25,9 +25,20 @@ private:
   u32 m_dst_ofs = 0;
   Gen::FixupBranch m_skip_vertex;
   Gen::OpArg GetVertexAddr(CPArray array, VertexComponentFormat attribute);
+  Gen::OpArg GetArrayAddr(CPArray array);
   int ReadVertex(Gen::OpArg data, VertexComponentFormat attribute, ComponentFormat format,
                  int count_in, int count_out, bool dequantize, u8 scaling_exponent,
                  AttributeFormat* native_format);
-  void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format);
+  int ReadColor(Gen::OpArg data, ColorFormat format, const Gen::OpArg& dest);
   void GenerateVertexLoader();
+
+  // With AVX2, runs of vertices are loaded two at a time, with the 128-bit lanes holding the
+  // same attribute of either vertex. This uses the layout of the single vertex loader.
+  bool CanLoadVertexPairs() const;
+  Gen::OpArg GetPairVertexAddr(CPArray array, VertexComponentFormat attribute, u32 src_ofs,
+                               int vertex);
+  void ReadVertexPair(CPArray array, VertexComponentFormat attribute, u32 src_ofs, u32 data_ofs,
+                      ComponentFormat format, int count_in, int count_out, bool dequantize,
+                      u8 scaling_exponent, u32 dst_ofs);
+  void GenerateVertexPairLoader(const u8* single_vertex_loop);
 };
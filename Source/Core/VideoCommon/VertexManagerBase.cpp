@@ -4,7 +4,9 @@
 #include "VideoCommon/VertexManagerBase.h"
 
 #include <array>
+#include <chrono>
 #include <cmath>
+#include <cstring>
 #include <memory>
 
 #include "Common/BitSet.h"
@@ -101,7 +103,10 @@ VertexManagerBase::~VertexManagerBase() = default;
 
 bool VertexManagerBase::Initialize()
 {
-  m_index_generator.Init();
+  m_index_generator.Init(g_Config.backend_info.bSupportsPrimitiveRestart);
+
+  // Nothing has been uploaded to this backend's buffers yet.
+  InvalidateConstants();
   return true;
 }
 
@@ -180,6 +185,12 @@ DataReader VertexManagerBase::PrepareForAdditionalData(OpcodeDecoder::Primitive
     m_is_flushed = false;
   }
 
+  if (m_redundant_flush_skipped)
+  {
+    INCSTAT(g_stats.this_frame.num_draws_avoided);
+    m_redundant_flush_skipped = false;
+  }
+
   return DataReader(m_cur_buffer_pointer, m_end_buffer_pointer);
 }
 
@@ -284,13 +295,49 @@ void VertexManagerBase::UploadUniforms()
 {
 }
 
+// Copies of the uniform blocks as they were last uploaded. Only valid while the backend still
+// has those uploads bound, i.e. until the constants are invalidated.
+static PixelShaderConstants s_uploaded_pixel_constants;
+static VertexShaderConstants s_uploaded_vertex_constants;
+static GeometryShaderConstants s_uploaded_geometry_constants;
+static bool s_uploaded_constants_valid = false;
+
 void VertexManagerBase::InvalidateConstants()
 {
+  s_uploaded_constants_valid = false;
   VertexShaderManager::dirty = true;
   GeometryShaderManager::dirty = true;
   PixelShaderManager::dirty = true;
 }
 
+void VertexManagerBase::SkipUnchangedConstants()
+{
+  // The managers mark their constants dirty whenever a register they depend on is written, which
+  // often leaves them as they were. Uploading those again would only bind an identical copy.
+  const auto skip_if_unchanged = [](const auto& constants, auto* uploaded, bool* dirty) {
+    if (!*dirty)
+      return;
+
+    if (s_uploaded_constants_valid && std::memcmp(&constants, uploaded, sizeof(constants)) == 0)
+    {
+      *dirty = false;
+      ADDSTAT(g_stats.this_frame.bytes_uniform_skipped, sizeof(constants));
+      return;
+    }
+
+    std::memcpy(uploaded, &constants, sizeof(constants));
+  };
+
+  // After invalidation every block is dirty, so all of the copies are refreshed here.
+  skip_if_unchanged(PixelShaderManager::constants, &s_uploaded_pixel_constants,
+                    &PixelShaderManager::dirty);
+  skip_if_unchanged(VertexShaderManager::constants, &s_uploaded_vertex_constants,
+                    &VertexShaderManager::dirty);
+  skip_if_unchanged(GeometryShaderManager::constants, &s_uploaded_geometry_constants,
+                    &GeometryShaderManager::dirty);
+  s_uploaded_constants_valid = true;
+}
+
 void VertexManagerBase::UploadUtilityUniforms(const void* uniforms, u32 uniforms_size)
 {
 }
@@ -349,18 +396,33 @@ void VertexManagerBase::LoadTextures()
       if (bpmem.tevind[i].IsActive() && bpmem.tevind[i].bt < bpmem.genMode.numindstages)
         usedtextures[bpmem.tevindref.getTexMap(bpmem.tevind[i].bt)] = true;
 
+  const bool measure_time = g_ActiveConfig.bOverlayStats;
+  const auto start = measure_time ? std::chrono::steady_clock::now() :
+                                    std::chrono::steady_clock::time_point();
+
   for (unsigned int i : usedtextures)
     g_texture_cache->Load(i);
 
   g_texture_cache->BindTextures(usedtextures);
+
+  if (measure_time)
+  {
+    ADDSTAT(g_stats.this_frame.texture_loading_ns,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+  }
 }
 
 void VertexManagerBase::Flush()
 {
+  VertexLoaderManager::WaitForVertexLoading();
+
   if (m_is_flushed)
     return;
 
   m_is_flushed = true;
+  m_redundant_flush_skipped = false;
 
   if (xfmem.numTexGen.numTexGens != bpmem.genMode.numtexgens ||
       xfmem.numChan.numColorChans != bpmem.genMode.numcolchans)
@@ -388,6 +450,10 @@ void VertexManagerBase::Flush()
     return;
   }
 
+  const bool measure_time = g_ActiveConfig.bOverlayStats;
+  const auto start = measure_time ? std::chrono::steady_clock::now() :
+                                    std::chrono::steady_clock::time_point();
+
 #if defined(_DEBUG) || defined(DEBUGFAST)
   PRIM_LOG("frame{}:\n texgen={}, numchan={}, dualtex={}, ztex={}, cole={}, alpe={}, ze={}",
            g_ActiveConfig.iSaveTargetId, xfmem.numTexGen.numTexGens, xfmem.numChan.numColorChans,
@@ -484,6 +550,7 @@ void VertexManagerBase::Flush()
     // Now we can upload uniforms, as nothing else will override them.
     GeometryShaderManager::SetConstants();
     PixelShaderManager::SetConstants();
+    SkipUnchangedConstants();
     UploadUniforms();
 
     // Update the pipeline, or compile one if needed.
@@ -497,6 +564,8 @@ void VertexManagerBase::Flush()
 
       DrawCurrentBatch(base_index, num_indices, base_vertex);
       INCSTAT(g_stats.this_frame.num_draw_calls);
+      if (m_current_pipeline_is_uber)
+        INCSTAT(g_stats.this_frame.num_ubershader_draws);
 
       if (PerfQueryBase::ShouldEmulate())
         g_perf_query->DisableQuery(bpmem.zcontrol.early_ztest ? PQG_ZCOMP_ZCOMPLOC : PQG_ZCOMP);
@@ -505,6 +574,7 @@ void VertexManagerBase::Flush()
 
       // The EFB cache is now potentially stale.
       g_framebuffer_manager->FlagPeekCacheAsOutOfDate();
+      g_framebuffer_manager->OnDraw(m_draw_counter);
     }
   }
 
@@ -514,10 +584,21 @@ void VertexManagerBase::Flush()
                   "xf.numtexgens ({}) does not match bp.numtexgens ({}). Error in command stream.",
                   xfmem.numTexGen.numTexGens, bpmem.genMode.numtexgens.Value());
   }
+
+  if (measure_time)
+  {
+    ADDSTAT(g_stats.this_frame.draw_submission_ns,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start)
+                .count());
+  }
 }
 
 void VertexManagerBase::DoState(PointerWrap& p)
 {
+  // The worker may still be writing vertices into the buffers which are flushed below.
+  VertexLoaderManager::WaitForVertexLoading();
+
   if (p.GetMode() == PointerWrap::MODE_READ)
   {
     // Flush old vertex data before loading state.
@@ -679,6 +760,7 @@ void VertexManagerBase::UpdatePipelineObject()
     return;
 
   m_current_pipeline_object = nullptr;
+  m_current_pipeline_is_uber = false;
   m_pipeline_config_changed = false;
 
   switch (g_ActiveConfig.iShaderCompilationMode)
@@ -695,6 +777,7 @@ void VertexManagerBase::UpdatePipelineObject()
     // Exclusive ubershader mode, always use ubershaders.
     m_current_pipeline_object =
         g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+    m_current_pipeline_is_uber = true;
   }
   break;
 
@@ -715,6 +798,7 @@ void VertexManagerBase::UpdatePipelineObject()
       // Specialized shaders not ready, use the ubershaders.
       m_current_pipeline_object =
           g_shader_cache->GetUberPipelineForUid(m_current_uber_pipeline_config);
+      m_current_pipeline_is_uber = true;
     }
     else
     {
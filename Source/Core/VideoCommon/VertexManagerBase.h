@@ -105,6 +105,14 @@ public:
 
   void Flush();
 
+  // Called instead of Flush() by register writes which turned out not to change any state, so
+  // that draws merged into the current batch because of them can be counted.
+  void SkipRedundantFlush()
+  {
+    if (!m_is_flushed)
+      m_redundant_flush_skipped = true;
+  }
+
   void DoState(PointerWrap& p);
 
   FlushStatistics ResetFlushAspectRatioCount();
@@ -116,6 +124,7 @@ public:
   void InvalidatePipelineObject()
   {
     m_current_pipeline_object = nullptr;
+    m_current_pipeline_is_uber = false;
     m_pipeline_config_changed = true;
   }
 
@@ -142,6 +151,9 @@ public:
   // CPU access tracking - call after a draw call is made.
   void OnDraw();
 
+  // Number of draws so far in the current frame.
+  u32 GetDrawCounter() const { return m_draw_counter; }
+
   // Call after CPU access is requested.
   void OnCPUEFBAccess();
 
@@ -165,6 +177,9 @@ protected:
   // Uploads uniform buffers for GX draws.
   virtual void UploadUniforms();
 
+  // Clears the dirty flag of uniform blocks which are identical to what was last uploaded.
+  static void SkipUnchangedConstants();
+
   // Issues the draw call for the current batch in the backend.
   virtual void DrawCurrentBatch(u32 base_index, u32 num_indices, u32 base_vertex);
 
@@ -187,6 +202,7 @@ protected:
   VideoCommon::GXPipelineUid m_current_pipeline_config;
   VideoCommon::GXUberPipelineUid m_current_uber_pipeline_config;
   const AbstractPipeline* m_current_pipeline_object = nullptr;
+  bool m_current_pipeline_is_uber = false;
   PrimitiveType m_current_primitive_type = PrimitiveType::Points;
   bool m_pipeline_config_changed = true;
   bool m_rasterization_state_changed = true;
@@ -204,6 +220,7 @@ private:
   void UpdatePipelineObject();
 
   bool m_is_flushed = true;
+  bool m_redundant_flush_skipped = false;
   FlushStatistics m_flush_statistics = {};
 
   // CPU access tracking
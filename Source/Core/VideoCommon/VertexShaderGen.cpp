@@ -77,7 +77,14 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
                                     const vertex_shader_uid_data* uid_data)
 {
   ShaderCode out;
+  GenerateVertexShaderCode(out, api_type, host_config, uid_data);
+  return out;
+}
 
+void GenerateVertexShaderCode(ShaderCode& out, APIType api_type,
+                              const ShaderHostConfig& host_config,
+                              const vertex_shader_uid_data* uid_data)
+{
   const bool per_pixel_lighting = g_ActiveConfig.bEnablePixelLighting;
   const bool msaa = host_config.msaa;
   const bool ssaa = host_config.ssaa;
@@ -598,6 +605,4 @@ ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& ho
     out.Write("return o;\n");
   }
   out.Write("}}\n");
-
-  return out;
 }
@@ -72,3 +72,6 @@ using VertexShaderUid = ShaderUid<vertex_shader_uid_data>;
 VertexShaderUid GetVertexShaderUid();
 ShaderCode GenerateVertexShaderCode(APIType api_type, const ShaderHostConfig& host_config,
                                     const vertex_shader_uid_data* uid_data);
+void GenerateVertexShaderCode(ShaderCode& out, APIType api_type,
+                              const ShaderHostConfig& host_config,
+                              const vertex_shader_uid_data* uid_data);
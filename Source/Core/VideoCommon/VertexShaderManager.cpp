@@ -598,6 +598,10 @@ void VertexShaderManager::SetTexMatrixChangedA(u32 Value)
     bTexMatricesChanged[0] = true;
     g_main_cp_state.matrix_index_a.Hex = Value;
   }
+  else
+  {
+    g_vertex_manager->SkipRedundantFlush();
+  }
 }
 
 void VertexShaderManager::SetTexMatrixChangedB(u32 Value)
@@ -608,6 +612,10 @@ void VertexShaderManager::SetTexMatrixChangedB(u32 Value)
     bTexMatricesChanged[1] = true;
     g_main_cp_state.matrix_index_b.Hex = Value;
   }
+  else
+  {
+    g_vertex_manager->SkipRedundantFlush();
+  }
 }
 
 void VertexShaderManager::SetViewportChanged()
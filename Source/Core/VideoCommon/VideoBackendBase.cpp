@@ -327,6 +327,8 @@ void VideoBackendBase::InitializeShared()
 
   g_Config.VerifyValidity();
   UpdateActiveConfig();
+
+  VertexLoaderManager::LoadLoaderUIDCache();
 }
 
 void VideoBackendBase::ShutdownShared()
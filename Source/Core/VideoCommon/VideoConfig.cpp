@@ -56,6 +56,7 @@ void VideoConfig::Refresh()
   suggested_aspect_mode = Config::Get(Config::GFX_SUGGESTED_ASPECT_RATIO);
   bCrop = Config::Get(Config::GFX_CROP);
   iSafeTextureCache_ColorSamples = Config::Get(Config::GFX_SAFE_TEXTURE_CACHE_COLOR_SAMPLES);
+  iTextureCacheBudget = Config::Get(Config::GFX_TEXTURE_CACHE_BUDGET);
   bShowFPS = Config::Get(Config::GFX_SHOW_FPS);
   bShowNetPlayPing = Config::Get(Config::GFX_SHOW_NETPLAY_PING);
   bShowNetPlayMessages = Config::Get(Config::GFX_SHOW_NETPLAY_MESSAGES);
@@ -94,8 +95,11 @@ void VideoConfig::Refresh()
   bShaderCache = Config::Get(Config::GFX_SHADER_CACHE);
   bWaitForShadersBeforeStarting = Config::Get(Config::GFX_WAIT_FOR_SHADERS_BEFORE_STARTING);
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
+  bUberShaderVariants = Config::Get(Config::GFX_UBERSHADER_VARIANTS);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iTextureDecodingThreads = Config::Get(Config::GFX_TEXTURE_DECODING_THREADS);
+  bPipelinedVertexLoading = Config::Get(Config::GFX_PIPELINED_VERTEX_LOADING);
 
   bZComploc = Config::Get(Config::GFX_SW_ZCOMPLOC);
   bZFreeze = Config::Get(Config::GFX_SW_ZFREEZE);
@@ -104,6 +108,7 @@ void VideoConfig::Refresh()
   bDumpTevTextureFetches = Config::Get(Config::GFX_SW_DUMP_TEV_TEX_FETCHES);
   drawStart = Config::Get(Config::GFX_SW_DRAW_START);
   drawEnd = Config::Get(Config::GFX_SW_DRAW_END);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
 
   bForceFiltering = Config::Get(Config::GFX_ENHANCE_FORCE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -136,6 +141,7 @@ void VideoConfig::Refresh()
   bEFBEmulateFormatChanges = Config::Get(Config::GFX_HACK_EFB_EMULATE_FORMAT_CHANGES);
   bVertexRounding = Config::Get(Config::GFX_HACK_VERTEX_ROUDING);
   iEFBAccessTileSize = Config::Get(Config::GFX_HACK_EFB_ACCESS_TILE_SIZE);
+  bEFBAccessPrefetch = Config::Get(Config::GFX_HACK_EFB_ACCESS_PREFETCH);
   iMissingColorValue = Config::Get(Config::GFX_HACK_MISSING_COLOR_VALUE);
   bFastTextureSampling = Config::Get(Config::GFX_HACK_FAST_TEXTURE_SAMPLING);
 
@@ -178,6 +184,20 @@ static u32 GetNumAutoShaderCompilerThreads()
   return static_cast<u32>(std::min(std::max(cpu_info.num_cores - 3, 1), 4));
 }
 
+static u32 GetNumAutoTextureDecodingThreads()
+{
+  // Automatic number. We use clamp(cpus - 3, 0, 3), leaving room for the CPU, GPU and
+  // shader compiler threads; the GPU thread itself takes part in decoding as well.
+  return static_cast<u32>(std::min(std::max(cpu_info.num_cores - 3, 0), 3));
+}
+
+static u32 GetNumAutoSWRasterizerThreads()
+{
+  // Automatic number. We use clamp(cpus - 2, 0, 7), leaving room for the CPU and GPU threads;
+  // the GPU thread itself takes part in rasterizing as well.
+  return static_cast<u32>(std::min(std::max(cpu_info.num_cores - 2, 0), 7));
+}
+
 static u32 GetNumAutoShaderPreCompilerThreads()
 {
   // Automatic number. We use clamp(cpus - 2, 1, infty) here.
@@ -213,3 +233,19 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
   else
     return 1;
 }
+
+u32 VideoConfig::GetTextureDecodingThreads() const
+{
+  if (iTextureDecodingThreads >= 0)
+    return static_cast<u32>(iTextureDecodingThreads);
+  else
+    return GetNumAutoTextureDecodingThreads();
+}
+
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads >= 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+  else
+    return GetNumAutoSWRasterizerThreads();
+}
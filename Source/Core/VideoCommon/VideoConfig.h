@@ -126,12 +126,15 @@ struct VideoConfig final
   bool bSkipPresentingDuplicateXFBs = false;
   bool bCopyEFBScaled = false;
   int iSafeTextureCache_ColorSamples = 0;
+  int iTextureCacheBudget = 0;  // in MiB, 0 means unlimited
   float fAspectRatioHackW = 1;  // Initial value needed for the first frame
   float fAspectRatioHackH = 1;
   bool bEnablePixelLighting = false;
   bool bFastDepthCalc = false;
   bool bVertexRounding = false;
   int iEFBAccessTileSize = 0;
+  // Reads back the EFB tiles which the CPU peeked in the last frame ahead of time.
+  bool bEFBAccessPrefetch = false;
   int iLog = 0;           // CONF_ bits
   int iSaveTargetId = 0;  // TODO: Should be dropped
   u32 iMissingColorValue = 0;
@@ -158,6 +161,11 @@ struct VideoConfig final
   bool bDumpTevStages = false;
   bool bDumpTevTextureFetches = false;
 
+  // Number of additional threads the software renderer rasterizes with.
+  // 0 rasterizes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 0;
+
   // Enable API validation layers, currently only supported with Vulkan.
   bool bEnableValidationLayer = false;
 
@@ -176,12 +184,25 @@ struct VideoConfig final
   bool bWaitForShadersBeforeStarting = false;
   ShaderCompilationMode iShaderCompilationMode{};
 
+  // Uses pixel ubershaders specialized for the number of TEV stages and whether fog and the alpha
+  // test are used. More of them are compiled at startup, but each one runs faster.
+  bool bUberShaderVariants = false;
+
   // Number of shader compiler threads.
   // 0 disables background compilation.
   // -1 uses an automatic number based on the CPU threads.
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of additional threads used to decode large textures.
+  // 0 decodes on the GPU thread only.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecodingThreads = 0;
+
+  // Converts vertices on a separate thread in dual core mode, so that the GPU thread can go on
+  // decoding commands and submitting draws.
+  bool bPipelinedVertexLoading = false;
+
   // Static config per API
   // TODO: Move this out of VideoConfig
   struct
@@ -260,6 +281,8 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetTextureDecodingThreads() const;
+  u32 GetSWRasterizerThreads() const;
 };
 
 extern VideoConfig g_Config;
@@ -29,6 +29,15 @@ static void XFRegWritten(u32 address, u32 value)
 {
   if (address >= XFMEM_REGISTERS_START && address < XFMEM_REGISTERS_END)
   {
+    // Rewriting a register with its current value changes nothing. The matrix indices are the
+    // exception, as CP has its own copy of them which can differ from the XF one.
+    if (((u32*)&xfmem)[address] == value && address != XFMEM_SETMATRIXINDA &&
+        address != XFMEM_SETMATRIXINDB)
+    {
+      g_vertex_manager->SkipRedundantFlush();
+      return;
+    }
+
     switch (address)
     {
     case XFMEM_ERROR:
@@ -222,12 +231,23 @@ void LoadXFReg(u16 base_address, u8 transfer_size, const u8* data)
       base_address = XFMEM_REGISTERS_START;
     }
 
-    XFMemWritten(xf_mem_transfer_size, xf_mem_base);
-    for (u32 i = 0; i < xf_mem_transfer_size; i++)
+    // Games often reload the same matrices and lights between draws.
+    u32* const xf_mem = (u32*)&xfmem + xf_mem_base;
+    bool changed = false;
+    for (u32 i = 0; i < xf_mem_transfer_size && !changed; i++)
+      changed = xf_mem[i] != Common::swap32(data + i * 4);
+
+    if (changed)
     {
-      ((u32*)&xfmem)[xf_mem_base + i] = Common::swap32(data);
-      data += 4;
+      XFMemWritten(xf_mem_transfer_size, xf_mem_base);
+      for (u32 i = 0; i < xf_mem_transfer_size; i++)
+        xf_mem[i] = Common::swap32(data + i * 4);
     }
+    else
+    {
+      g_vertex_manager->SkipRedundantFlush();
+    }
+    data += xf_mem_transfer_size * 4;
   }
 
   // write to XF regs
@@ -276,6 +296,10 @@ void LoadIndexedXF(CPArray array, u32 index, u16 address, u8 size)
     for (u32 i = 0; i < size; ++i)
       currData[i] = Common::swap32(newData[i]);
   }
+  else
+  {
+    g_vertex_manager->SkipRedundantFlush();
+  }
 }
 
 void PreprocessIndexedXF(CPArray array, u32 index, u16 address, u8 size)
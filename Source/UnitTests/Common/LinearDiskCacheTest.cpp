@@ -0,0 +1,196 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+using Cache = LinearDiskCache<u32, u8>;
+using Entry = std::pair<u32, std::vector<u8>>;
+
+class CollectingReader : public LinearDiskCacheReader<u32, u8>
+{
+public:
+  void Read(const u32& key, const u8* value, u32 value_size) override
+  {
+    m_entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+  }
+
+  std::vector<Entry> m_entries;
+};
+
+std::vector<u8> MakeValue(u32 key, u32 size)
+{
+  std::vector<u8> value(size);
+  for (u32 i = 0; i < size; i++)
+    value[i] = static_cast<u8>(key * 7 + i);
+  return value;
+}
+}  // namespace
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  LinearDiskCacheTest()
+      : m_parent_directory(File::CreateTempDir()), m_file_path(m_parent_directory + "/cache.bin")
+  {
+  }
+
+  ~LinearDiskCacheTest() override
+  {
+    if (!m_parent_directory.empty())
+      File::DeleteDirRecursively(m_parent_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_parent_directory.empty())
+      FAIL();
+  }
+
+  void Append(const std::vector<Entry>& entries)
+  {
+    Cache cache;
+    CollectingReader reader;
+    cache.OpenAndRead(m_file_path, reader);
+    for (const auto& [key, value] : entries)
+      cache.Append(key, value.data(), static_cast<u32>(value.size()));
+    cache.Close();
+  }
+
+  std::vector<Entry> Read()
+  {
+    Cache cache;
+    CollectingReader reader;
+    EXPECT_EQ(reader.m_entries.size(), 0u);
+    const u32 num_read = cache.OpenAndRead(m_file_path, reader);
+    EXPECT_EQ(num_read, reader.m_entries.size());
+    return reader.m_entries;
+  }
+
+  const std::string m_parent_directory;
+  const std::string m_file_path;
+};
+
+TEST_F(LinearDiskCacheTest, ReadsAppendedEntries)
+{
+  const std::vector<Entry> entries = {{3, MakeValue(3, 10)}, {1, {}}, {2, MakeValue(2, 300)}};
+  Append(entries);
+
+  // Appended entries come in the order they were appended in.
+  EXPECT_EQ(entries, Read());
+}
+
+TEST_F(LinearDiskCacheTest, CompactionSortsAndDropsDuplicates)
+{
+  Append({{3, MakeValue(3, 10)}, {1, MakeValue(1, 5)}, {2, MakeValue(2, 300)}});
+  Append({{1, MakeValue(100, 7)}});
+
+  // The first read still sees every entry, and compacts the file.
+  EXPECT_EQ(4u, Read().size());
+
+  const std::vector<Entry> compacted = {
+      {1, MakeValue(100, 7)}, {2, MakeValue(2, 300)}, {3, MakeValue(3, 10)}};
+  EXPECT_EQ(compacted, Read());
+}
+
+TEST_F(LinearDiskCacheTest, AppendsAfterCompaction)
+{
+  Append({{2, MakeValue(2, 20)}, {1, MakeValue(1, 10)}});
+  Read();
+  Append({{0, MakeValue(0, 30)}});
+
+  const std::vector<Entry> expected = {
+      {1, MakeValue(1, 10)}, {2, MakeValue(2, 20)}, {0, MakeValue(0, 30)}};
+  EXPECT_EQ(expected, Read());
+}
+
+TEST_F(LinearDiskCacheTest, OfflineCompaction)
+{
+  Append({{2, MakeValue(2, 20)}, {1, MakeValue(1, 10)}, {2, MakeValue(3, 5)}});
+  EXPECT_EQ(2u, Cache::Compact(m_file_path).value_or(0));
+
+  const std::vector<Entry> expected = {{1, MakeValue(1, 10)}, {2, MakeValue(3, 5)}};
+  EXPECT_EQ(expected, Read());
+}
+
+TEST_F(LinearDiskCacheTest, OverwritesIncompleteEntry)
+{
+  Append({{1, MakeValue(1, 10)}, {2, MakeValue(2, 20)}});
+  {
+    // As if Dolphin crashed while writing the second entry.
+    File::IOFile file(m_file_path, "r+b");
+    ASSERT_TRUE(file.Resize(file.GetSize() - 5));
+  }
+
+  Append({{3, MakeValue(3, 30)}});
+  const std::vector<Entry> expected = {{1, MakeValue(1, 10)}, {3, MakeValue(3, 30)}};
+  EXPECT_EQ(expected, Read());
+}
+
+TEST_F(LinearDiskCacheTest, RecreatesInvalidFile)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_file_path, "not a cache"));
+  EXPECT_TRUE(Read().empty());
+
+  Append({{1, MakeValue(1, 10)}});
+  EXPECT_EQ(1u, Read().size());
+}
+
+// Shader caches of large games hold 100k entries.
+class LinearDiskCacheSpeedTest : public LinearDiskCacheTest
+{
+protected:
+  static constexpr u32 NUM_ENTRIES = 100000;
+  static constexpr u32 VALUE_SIZE = 512;
+
+  void SetUp() override
+  {
+    LinearDiskCacheTest::SetUp();
+
+    Cache cache;
+    CollectingReader reader;
+    cache.OpenAndRead(m_file_path, reader);
+    const std::vector<u8> value(VALUE_SIZE, 0xCD);
+    for (u32 i = 0; i < NUM_ENTRIES; i++)
+      cache.Append(i * 2654435761u, value.data(), VALUE_SIZE);
+    cache.Close();
+  }
+
+  void ReadAll()
+  {
+    class CountingReader : public LinearDiskCacheReader<u32, u8>
+    {
+    public:
+      void Read(const u32& key, const u8* value, u32 value_size) override { bytes += value_size; }
+      u64 bytes = 0;
+    };
+
+    Cache cache;
+    CountingReader reader;
+    EXPECT_EQ(NUM_ENTRIES, cache.OpenAndRead(m_file_path, reader));
+    EXPECT_EQ(u64(NUM_ENTRIES) * VALUE_SIZE, reader.bytes);
+  }
+};
+
+TEST_F(LinearDiskCacheSpeedTest, FirstRead)
+{
+  // Reads the entries one after another, then compacts the file.
+  ReadAll();
+}
+
+TEST_F(LinearDiskCacheSpeedTest, CompactedRead)
+{
+  ASSERT_EQ(NUM_ENTRIES, Cache::Compact(m_file_path).value_or(0));
+  for (int i = 0; i < 10; i++)
+    ReadAll();
+}
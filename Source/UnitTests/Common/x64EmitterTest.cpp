@@ -1200,6 +1200,57 @@ AVX_RRMI_TEST(VSHUFPD, "dqword")
 AVX_RRMI_TEST(VBLENDPS, "dqword")
 AVX_RRMI_TEST(VBLENDPD, "dqword")
 
+TEST_F(x64EmitterTest, VZEROUPPER)
+{
+  emitter->VZEROUPPER();
+  ExpectDisassembly("vzeroupper");
+}
+
+TEST_F(x64EmitterTest, AVX2_256)
+{
+  emitter->VINSERTI128(YMM1, YMM2, R(XMM3), 1);
+  emitter->VINSERTI128(YMM9, YMM10, MatR(R12), 0);
+  emitter->VEXTRACTI128(R(XMM3), YMM12, 1);
+  emitter->VEXTRACTI128(MatR(R12), YMM1, 1);
+  emitter->VPSHUFB_ymm(YMM0, YMM1, MatR(R12));
+  emitter->VPSRAD_ymm(YMM8, YMM1, 24);
+  emitter->VPSRLD_ymm(YMM0, YMM9, 16);
+  emitter->VCVTDQ2PS_ymm(YMM3, R(YMM11));
+  emitter->VMULPS_ymm(YMM3, YMM4, MatR(R12));
+
+  // Bochs shows the 128-bit operands of vinserti128/vextracti128 as full YMM registers.
+  ExpectDisassembly("vinserti128 ymm1, ymm2, ymm3, 0x01 "
+                    "vinserti128 ymm9, ymm10, qqword ptr ds:[r12], 0x00 "
+                    "vextracti128 ymm3, ymm12, 0x01 "
+                    "vextracti128 qqword ptr ds:[r12], ymm1, 0x01 "
+                    "vpshufb ymm0, ymm1, qqword ptr ds:[r12] "
+                    "vpsrad ymm8, ymm1, 0x18 "
+                    "vpsrld ymm0, ymm9, 0x10 "
+                    "vcvtdq2ps ymm3, ymm11 "
+                    "vmulps ymm3, ymm4, qqword ptr ds:[r12]");
+}
+
+TEST_F(x64EmitterTest, VEX_MOV)
+{
+  emitter->VMOVD_xmm(XMM1, MatR(R12));
+  emitter->VMOVQ_xmm(XMM9, MatR(RAX));
+  emitter->VMOVDQU(XMM2, MatR(R12));
+  emitter->VMOVSS(MatR(R12), XMM10);
+  emitter->VMOVLPS(MatR(RAX), XMM3);
+  emitter->VMOVUPS(MatR(R12), XMM4);
+  emitter->VMOVHLPS(XMM2, XMM2, XMM11);
+  emitter->VCVTSI2SS(XMM0, XMM0, R(RCX));
+
+  ExpectDisassembly("vmovd xmm1, dword ptr ds:[r12] "
+                    "vmovq xmm9, qword ptr ds:[rax] "
+                    "vmovdqu xmm2, dqword ptr ds:[r12] "
+                    "vmovss dword ptr ds:[r12], xmm10 "
+                    "vmovlps qword ptr ds:[rax], xmm3 "
+                    "vmovups dqword ptr ds:[r12], xmm4 "
+                    "vmovhlps xmm2, xmm2, xmm11 "
+                    "vcvtsi2ss xmm0, xmm0, ecx");
+}
+
 // for VEX instructions that take the form op reg, reg, r/m, reg OR reg, reg, reg, r/m
 #define VEX_RRMR_RRRM_TEST(Name, sizename)                                                         \
   TEST_F(x64EmitterTest, Name)                                                                     \
@@ -0,0 +1,140 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+
+namespace
+{
+constexpr u32 NUM_FRAMES = 10;
+
+FifoFrameInfo MakeFrame(u32 frame_num)
+{
+  FifoFrameInfo frame;
+  frame.fifoStart = 0x00100000;
+  frame.fifoEnd = 0x00140000 + frame_num;
+
+  frame.fifoData.resize(1000 + frame_num * 37);
+  for (size_t i = 0; i < frame.fifoData.size(); i++)
+    frame.fifoData[i] = static_cast<u8>(i * 7 + frame_num);
+
+  // Leave some frames without memory updates.
+  for (u32 i = 0; i < frame_num % 3; i++)
+  {
+    MemoryUpdate update;
+    update.fifoPosition = i * 100;
+    update.address = 0x80000000 + frame_num * 0x1000 + i * 0x100;
+    update.data.assign(64 + i, static_cast<u8>(frame_num + i));
+    update.type = MemoryUpdate::TEXTURE_MAP;
+    frame.memoryUpdates.push_back(std::move(update));
+  }
+
+  return frame;
+}
+
+void ExpectSameFrame(const FifoFrameInfo& frame, const FifoFrameInfo& expected)
+{
+  EXPECT_EQ(frame.fifoStart, expected.fifoStart);
+  EXPECT_EQ(frame.fifoEnd, expected.fifoEnd);
+  EXPECT_EQ(frame.fifoData, expected.fifoData);
+  ASSERT_EQ(frame.memoryUpdates.size(), expected.memoryUpdates.size());
+  for (size_t i = 0; i < frame.memoryUpdates.size(); i++)
+  {
+    EXPECT_EQ(frame.memoryUpdates[i].fifoPosition, expected.memoryUpdates[i].fifoPosition);
+    EXPECT_EQ(frame.memoryUpdates[i].address, expected.memoryUpdates[i].address);
+    EXPECT_EQ(frame.memoryUpdates[i].data, expected.memoryUpdates[i].data);
+    EXPECT_EQ(frame.memoryUpdates[i].type, expected.memoryUpdates[i].type);
+  }
+}
+
+void ExpectSameFile(FifoDataFile& file)
+{
+  ASSERT_EQ(file.GetFrameCount(), NUM_FRAMES);
+  EXPECT_EQ(file.GetBPMem()[0x52], 0x4000u);
+
+  // In order, which is served by the read-ahead, and then backwards, which isn't.
+  for (u32 i = 0; i < NUM_FRAMES; i++)
+    ExpectSameFrame(*file.GetFrame(i), MakeFrame(i));
+  for (u32 i = NUM_FRAMES; i-- > 0;)
+    ExpectSameFrame(*file.GetFrame(i), MakeFrame(i));
+}
+}  // namespace
+
+class FifoDataFileTest : public testing::Test
+{
+protected:
+  FifoDataFileTest() : m_temp_dir{File::CreateTempDir()} {}
+  ~FifoDataFileTest() override
+  {
+    if (!m_temp_dir.empty())
+      File::DeleteDirRecursively(m_temp_dir);
+  }
+
+  void SetUp() override
+  {
+    ASSERT_FALSE(m_temp_dir.empty());
+
+    m_file.GetBPMem()[0x52] = 0x4000;
+    for (u32 i = 0; i < NUM_FRAMES; i++)
+      m_file.AddFrame(MakeFrame(i));
+  }
+
+  std::string GetPath(const std::string& name) const { return m_temp_dir + "/" + name; }
+
+  FifoDataFile m_file;
+
+private:
+  std::string m_temp_dir;
+};
+
+TEST_F(FifoDataFileTest, Uncompressed)
+{
+  ASSERT_TRUE(m_file.Save(GetPath("uncompressed.dff")));
+
+  const std::unique_ptr<FifoDataFile> file =
+      FifoDataFile::Load(GetPath("uncompressed.dff"), false);
+  ASSERT_TRUE(file);
+  EXPECT_FALSE(file->IsCompressed());
+  ExpectSameFile(*file);
+}
+
+TEST_F(FifoDataFileTest, Compressed)
+{
+  ASSERT_TRUE(m_file.SaveCompressed(GetPath("compressed.dff"), 5));
+
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(GetPath("compressed.dff"), false);
+  ASSERT_TRUE(file);
+  EXPECT_TRUE(file->IsCompressed());
+  ExpectSameFile(*file);
+}
+
+TEST_F(FifoDataFileTest, ConvertBetweenFormats)
+{
+  ASSERT_TRUE(m_file.Save(GetPath("uncompressed.dff")));
+
+  {
+    const std::unique_ptr<FifoDataFile> file =
+        FifoDataFile::Load(GetPath("uncompressed.dff"), false);
+    ASSERT_TRUE(file);
+    ASSERT_TRUE(file->SaveCompressed(GetPath("compressed.dff"), 1));
+  }
+
+  {
+    const std::unique_ptr<FifoDataFile> file =
+        FifoDataFile::Load(GetPath("compressed.dff"), false);
+    ASSERT_TRUE(file);
+    ASSERT_TRUE(file->Save(GetPath("converted.dff")));
+  }
+
+  const std::unique_ptr<FifoDataFile> file = FifoDataFile::Load(GetPath("converted.dff"), false);
+  ASSERT_TRUE(file);
+  EXPECT_FALSE(file->IsCompressed());
+  ExpectSameFile(*file);
+}
@@ -0,0 +1,193 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/Rasterizer.h"
+#include "VideoBackends/Software/SWBoundingBox.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
+#include "VideoCommon/VideoCommon.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+struct DrawResult
+{
+  std::vector<u32> colors;
+  std::vector<u32> depths;
+  std::array<u32, PQ_NUM_MEMBERS> perf_values{};
+  std::array<u16, 4> bbox{};
+};
+
+class SWRasterizerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+    bpmem.genMode.numcolchans = 1;
+    bpmem.scissorBR.x = EFB_WIDTH - 1;
+    bpmem.scissorBR.y = EFB_HEIGHT - 1;
+
+    // Output the rasterized color, blended on top of the EFB with depth testing.
+    bpmem.tevksel[0].swap1 = 0;
+    bpmem.tevksel[0].swap2 = 1;
+    bpmem.tevksel[1].swap1 = 2;
+    bpmem.tevksel[1].swap2 = 3;
+    bpmem.combiners[0].colorC.a = TevColorArg::Zero;
+    bpmem.combiners[0].colorC.b = TevColorArg::Zero;
+    bpmem.combiners[0].colorC.c = TevColorArg::Zero;
+    bpmem.combiners[0].colorC.d = TevColorArg::RasColor;
+    bpmem.combiners[0].alphaC.a = TevAlphaArg::Zero;
+    bpmem.combiners[0].alphaC.b = TevAlphaArg::Zero;
+    bpmem.combiners[0].alphaC.c = TevAlphaArg::Zero;
+    bpmem.combiners[0].alphaC.d = TevAlphaArg::RasAlpha;
+    bpmem.alpha_test.comp0 = CompareMode::Always;
+    bpmem.alpha_test.comp1 = CompareMode::Always;
+    bpmem.zmode.testenable = true;
+    bpmem.zmode.func = CompareMode::LEqual;
+    bpmem.zmode.updateenable = true;
+    bpmem.blendmode.blendenable = true;
+    bpmem.blendmode.colorupdate = true;
+    bpmem.blendmode.alphaupdate = true;
+    bpmem.blendmode.srcfactor = SrcBlendFactor::SrcAlpha;
+    bpmem.blendmode.dstfactor = DstBlendFactor::InvSrcAlpha;
+
+    g_ActiveConfig.bZComploc = true;
+    g_ActiveConfig.bZFreeze = true;
+    g_ActiveConfig.iSWRasterizerThreads = 0;
+    Rasterizer::Init();
+  }
+
+  void TearDown() override
+  {
+    Rasterizer::Shutdown();
+    g_ActiveConfig = VideoConfig();
+  }
+
+  // Draws overlapping, partially transparent triangles of all sizes, some of them off-screen.
+  static std::vector<OutputVertexData> GenerateTriangles(u32 count)
+  {
+    std::vector<OutputVertexData> vertices(count * 3);
+    u32 state = 1;
+    const auto random = [&state](u32 range) {
+      state = state * 1103515245 + 12345;
+      return (state >> 8) % range;
+    };
+    for (OutputVertexData& vertex : vertices)
+    {
+      vertex.screenPosition.x = static_cast<float>(random(EFB_WIDTH + 128)) - 64.0f + 0.3f;
+      vertex.screenPosition.y = static_cast<float>(random(EFB_HEIGHT + 128)) - 64.0f + 0.7f;
+      vertex.screenPosition.z = static_cast<float>(random(0x1000000));
+      vertex.projectedPosition.w = 1.0f + static_cast<float>(random(100)) / 10.0f;
+      for (u8& component : vertex.color[0])
+        component = static_cast<u8>(random(256));
+    }
+    return vertices;
+  }
+
+  static DrawResult Draw(const std::vector<OutputVertexData>& vertices, int num_threads)
+  {
+    g_ActiveConfig.iSWRasterizerThreads = num_threads;
+
+    u8 clear_color[4] = {0x10, 0x20, 0x30, 0x40};
+    for (u16 y = 0; y < EFB_HEIGHT; y++)
+    {
+      for (u16 x = 0; x < EFB_WIDTH; x++)
+      {
+        EfbInterface::SetColor(x, y, clear_color);
+        EfbInterface::SetDepth(x, y, 0xffffff);
+      }
+    }
+    EfbInterface::ResetPerfQuery();
+    BBoxManager::SetCoordinate(BBoxManager::Coordinate::Left, EFB_WIDTH);
+    BBoxManager::SetCoordinate(BBoxManager::Coordinate::Right, 0);
+    BBoxManager::SetCoordinate(BBoxManager::Coordinate::Top, EFB_HEIGHT);
+    BBoxManager::SetCoordinate(BBoxManager::Coordinate::Bottom, 0);
+
+    for (size_t i = 0; i < vertices.size(); i += 3)
+      Rasterizer::DrawTriangleFrontFace(&vertices[i], &vertices[i + 1], &vertices[i + 2]);
+    Rasterizer::Flush();
+
+    DrawResult result;
+    for (u16 y = 0; y < EFB_HEIGHT; y++)
+    {
+      for (u16 x = 0; x < EFB_WIDTH; x++)
+      {
+        result.colors.push_back(EfbInterface::GetColor(x, y));
+        result.depths.push_back(EfbInterface::GetDepth(x, y));
+      }
+    }
+    for (u32 i = 0; i < PQ_NUM_MEMBERS; i++)
+      result.perf_values[i] = EfbInterface::GetPerfQueryResult(static_cast<PerfQueryType>(i));
+    for (u32 i = 0; i < 4; i++)
+      result.bbox[i] = BBoxManager::GetCoordinate(static_cast<BBoxManager::Coordinate>(i));
+    return result;
+  }
+};
+}  // namespace
+
+TEST_F(SWRasterizerTest, ParallelDrawingIsBitExact)
+{
+  const std::vector<OutputVertexData> vertices = GenerateTriangles(500);
+  const DrawResult expected = Draw(vertices, 0);
+
+  // Make sure the test actually draws something.
+  ASSERT_NE(expected.perf_values[PQ_BLEND_INPUT], 0u);
+
+  for (int num_threads : {1, 3, 7})
+  {
+    const DrawResult result = Draw(vertices, num_threads);
+    EXPECT_EQ(expected.colors, result.colors) << num_threads << " threads";
+    EXPECT_EQ(expected.depths, result.depths) << num_threads << " threads";
+    EXPECT_EQ(expected.perf_values, result.perf_values) << num_threads << " threads";
+    EXPECT_EQ(expected.bbox, result.bbox) << num_threads << " threads";
+  }
+}
+
+TEST_F(SWRasterizerTest, EarlyDepthTestIsBitExact)
+{
+  bpmem.zcontrol.early_ztest = true;
+
+  const std::vector<OutputVertexData> vertices = GenerateTriangles(500);
+  const DrawResult expected = Draw(vertices, 0);
+  const DrawResult result = Draw(vertices, 3);
+  EXPECT_EQ(expected.colors, result.colors);
+  EXPECT_EQ(expected.depths, result.depths);
+  EXPECT_EQ(expected.perf_values, result.perf_values);
+  EXPECT_EQ(expected.bbox, result.bbox);
+}
+
+TEST_F(SWRasterizerTest, PartialPixelWritesAreBitExact)
+{
+  // Pixels are 3 bytes wide, so these formats keep part of a pixel while writing the rest of it,
+  // right next to pixels of other tiles.
+  for (PixelFormat format : {PixelFormat::RGBA6_Z24, PixelFormat::RGB8_Z24})
+  {
+    bpmem.zcontrol.pixel_format = format;
+    for (bool alpha_update : {false, true})
+    {
+      bpmem.blendmode.alphaupdate = alpha_update;
+      bpmem.blendmode.colorupdate = !alpha_update;
+
+      const std::vector<OutputVertexData> vertices = GenerateTriangles(300);
+      const DrawResult expected = Draw(vertices, 0);
+      for (int num_threads : {2, 7})
+      {
+        const DrawResult result = Draw(vertices, num_threads);
+        EXPECT_EQ(expected.colors, result.colors)
+            << static_cast<int>(format) << " " << alpha_update << " " << num_threads;
+        EXPECT_EQ(expected.depths, result.depths)
+            << static_cast<int>(format) << " " << alpha_update << " " << num_threads;
+      }
+    }
+  }
+}
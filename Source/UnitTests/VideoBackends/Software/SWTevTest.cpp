@@ -0,0 +1,319 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/EfbInterface.h"
+#include "VideoBackends/Software/Tev.h"
+#include "VideoBackends/Software/TextureSampler.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/TextureDecoder.h"
+#include "VideoCommon/VideoConfig.h"
+
+namespace
+{
+// Blocks are drawn into this corner of the EFB, so that they often overlap.
+constexpr int AREA_SIZE = 32;
+constexpr int TEXTURE_SIZE = 32;
+constexpr u32 ODD_TMEM_LINE = 0x4000;
+
+class Random
+{
+public:
+  explicit Random(u32 seed) : m_state(seed) {}
+
+  u32 operator()(u32 range)
+  {
+    m_state = m_state * 1103515245 + 12345;
+    return (m_state >> 8) % range;
+  }
+
+  s32 operator()(s32 min, s32 max) { return min + static_cast<s32>((*this)(max - min + 1)); }
+
+private:
+  u32 m_state;
+};
+
+struct PixelInputs
+{
+  s32 z;
+  u8 color[2][4];
+  s32 uv[8][2];
+};
+
+struct BlockInputs
+{
+  s32 x;
+  s32 y;
+  u32 mask;
+  std::array<PixelInputs, 4> pixels;
+  s32 indirect_lod[4];
+  bool indirect_linear[4];
+  s32 texture_lod[16];
+  bool texture_linear[16];
+};
+
+struct DrawResult
+{
+  std::vector<u32> colors;
+  std::vector<u32> depths;
+  Tev::Counters counters;
+};
+
+class SWTevTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    Random random(7);
+    for (u8& byte : texMem)
+      byte = static_cast<u8>(random(256));
+
+    g_ActiveConfig.bZComploc = true;
+  }
+
+  void TearDown() override
+  {
+    TextureSampler::Shutdown();
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+    g_ActiveConfig = VideoConfig();
+  }
+
+  // Sets up a random but valid TEV configuration, with indirect stages and textures.
+  void SetRandomState(Random& random)
+  {
+    std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+
+    bpmem.genMode.numtevstages = random(16);
+    bpmem.genMode.numtexgens = random(9);
+    bpmem.genMode.numindstages = random(5);
+    bpmem.zcontrol.pixel_format = random(2) ? PixelFormat::RGBA6_Z24 : PixelFormat::RGB8_Z24;
+    bpmem.zcontrol.early_ztest = random(2) != 0;
+    bpmem.zmode.hex = random(0x20);
+    bpmem.blendmode.hex = random(0x10000);
+    bpmem.alpha_test.hex = random(0x1000000);
+    bpmem.ztex1.bias = random(0x1000000);
+    bpmem.ztex2.type = static_cast<ZTexFormat>(random(3));
+    bpmem.ztex2.op = static_cast<ZTexOp>(random(3));
+    bpmem.tevindref.hex = random(0x1000000);
+
+    for (TEXSCALE& texscale : bpmem.texscale)
+      texscale.hex = random(0x1000000);
+
+    for (IND_MTX& indmtx : bpmem.indmtx)
+    {
+      indmtx.col0.hex = random(0x1000000);
+      indmtx.col1.hex = random(0x1000000);
+      indmtx.col2.hex = random(0x1000000);
+    }
+
+    constexpr std::array<RasColorChan, 5> color_chans = {
+        RasColorChan::Color0, RasColorChan::Color1, RasColorChan::AlphaBump,
+        RasColorChan::NormalizedAlphaBump, RasColorChan::Zero};
+    for (TwoTevStageOrders& order : bpmem.tevorders)
+    {
+      order.hex = random(0x1000000);
+      order.colorchan0 = color_chans[random(5)];
+      order.colorchan1 = color_chans[random(5)];
+    }
+
+    // The alpha konst selections 12 to 15 are not valid.
+    const auto random_ka = [&random] {
+      const u32 ka = random(28);
+      return static_cast<KonstSel>(ka < 12 ? ka : ka + 4);
+    };
+    for (TevKSel& ksel : bpmem.tevksel)
+    {
+      ksel.hex = random(0x1000000);
+      ksel.kasel0 = random_ka();
+      ksel.kasel1 = random_ka();
+    }
+
+    for (u32 i = 0; i < 16; i++)
+    {
+      bpmem.combiners[i].colorC.hex = random(0x1000000);
+      bpmem.combiners[i].alphaC.hex = random(0x1000000);
+
+      TevStageIndirect& indirect = bpmem.tevind[i];
+      indirect.hex = random(0x200000);
+      indirect.sw = static_cast<IndTexWrap>(random(7));
+      indirect.tw = static_cast<IndTexWrap>(random(7));
+      if (indirect.matrix_index == IndMtxIndex::Off)
+        indirect.matrix_id = IndMtxId::Indirect;
+      else
+        indirect.matrix_id = static_cast<IndMtxId>(random(3));
+    }
+
+    constexpr std::array<TextureFormat, 5> formats = {TextureFormat::I8, TextureFormat::IA8,
+                                                      TextureFormat::RGB565, TextureFormat::RGB5A3,
+                                                      TextureFormat::RGBA8};
+    for (u32 i = 0; i < 8; i++)
+    {
+      TexUnit& unit = const_cast<TexUnit&>(bpmem.tex.GetUnit(i));
+      unit.texMode0.wrap_s = static_cast<WrapMode>(random(3));
+      unit.texMode0.wrap_t = static_cast<WrapMode>(random(3));
+      unit.texImage0.width = TEXTURE_SIZE - 1;
+      unit.texImage0.height = TEXTURE_SIZE - 1;
+      unit.texImage0.format = formats[random(5)];
+      unit.texImage1.cache_manually_managed = true;
+      unit.texImage1.tmem_even = 0;
+      unit.texImage2.tmem_odd = ODD_TMEM_LINE;
+    }
+    TextureSampler::BeginBatch();
+
+    for (auto& color : PixelShaderManager::constants.colors)
+    {
+      for (int& comp : color)
+        comp = random(-1024, 1023);
+    }
+    for (auto& color : m_konst_colors)
+    {
+      for (s16& comp : color)
+        comp = static_cast<s16>(random(-1024, 1023));
+    }
+  }
+
+  static std::vector<BlockInputs> GenerateBlocks(Random& random, u32 count)
+  {
+    std::vector<BlockInputs> blocks(count);
+    for (BlockInputs& block : blocks)
+    {
+      block.x = random(AREA_SIZE / 2) * 2;
+      block.y = random(AREA_SIZE / 2) * 2;
+      block.mask = random(15) + 1;
+      for (PixelInputs& pixel : block.pixels)
+      {
+        pixel.z = random(0x1000000);
+        for (auto& color : pixel.color)
+        {
+          for (u8& comp : color)
+            comp = static_cast<u8>(random(256));
+        }
+        for (auto& uv : pixel.uv)
+        {
+          for (s32& coord : uv)
+            coord = random(-(4 * TEXTURE_SIZE << 7), 4 * TEXTURE_SIZE << 7);
+        }
+      }
+      for (u32 i = 0; i < 4; i++)
+      {
+        block.indirect_lod[i] = random(-64, 64);
+        block.indirect_linear[i] = random(2) != 0;
+      }
+      for (u32 i = 0; i < 16; i++)
+      {
+        block.texture_lod[i] = random(-64, 64);
+        block.texture_linear[i] = random(2) != 0;
+      }
+    }
+    return blocks;
+  }
+
+  // Draws the blocks pixel by pixel with Tev::Draw(), or with Tev::DrawQuad().
+  DrawResult Draw(const std::vector<BlockInputs>& blocks, bool quads)
+  {
+    Random random(3);
+    for (u16 y = 0; y < AREA_SIZE; y++)
+    {
+      for (u16 x = 0; x < AREA_SIZE; x++)
+      {
+        u8 color[4];
+        for (u8& comp : color)
+          comp = static_cast<u8>(random(256));
+        EfbInterface::SetColor(x, y, color);
+        EfbInterface::SetDepth(x, y, random(0x1000000));
+      }
+    }
+
+    // Value-initialized like the rasterizer's, since stale state is carried between pixels.
+    auto tev = std::make_unique<Tev>();
+    tev->Init();
+    for (int reg = 0; reg < 4; reg++)
+    {
+      for (int comp = 0; comp < 4; comp++)
+        tev->SetRegColor(reg, comp, m_konst_colors[reg][comp]);
+    }
+
+    for (const BlockInputs& block : blocks)
+    {
+      for (u32 i = 0; i < 4; i++)
+      {
+        if (!(block.mask & (1 << i)))
+          continue;
+
+        const PixelInputs& pixel = block.pixels[i];
+        tev->Position[0] = block.x + (i & 1);
+        tev->Position[1] = block.y + (i >> 1);
+        tev->Position[2] = pixel.z;
+        std::memcpy(tev->Color, pixel.color, sizeof(pixel.color));
+        for (u32 j = 0; j < 8; j++)
+        {
+          tev->Uv[j].s = pixel.uv[j][0];
+          tev->Uv[j].t = pixel.uv[j][1];
+        }
+        std::copy(std::begin(block.indirect_lod), std::end(block.indirect_lod),
+                  tev->IndirectLod);
+        std::copy(std::begin(block.indirect_linear), std::end(block.indirect_linear),
+                  tev->IndirectLinear);
+        std::copy(std::begin(block.texture_lod), std::end(block.texture_lod), tev->TextureLod);
+        std::copy(std::begin(block.texture_linear), std::end(block.texture_linear),
+                  tev->TextureLinear);
+
+        if (quads)
+          tev->AddQuadPixel();
+        else
+          tev->Draw();
+      }
+
+      if (quads)
+        tev->DrawQuad();
+    }
+
+    DrawResult result;
+    for (u16 y = 0; y < AREA_SIZE; y++)
+    {
+      for (u16 x = 0; x < AREA_SIZE; x++)
+      {
+        result.colors.push_back(EfbInterface::GetColor(x, y));
+        result.depths.push_back(EfbInterface::GetDepth(x, y));
+      }
+    }
+    result.counters = tev->counters;
+    return result;
+  }
+
+  std::array<std::array<s16, 4>, 4> m_konst_colors{};
+};
+}  // namespace
+
+TEST_F(SWTevTest, QuadsAreBitExact)
+{
+  Random random(1);
+  for (int i = 0; i < 300; i++)
+  {
+    SetRandomState(random);
+    const std::vector<BlockInputs> blocks = GenerateBlocks(random, 40);
+
+    const DrawResult expected = Draw(blocks, false);
+    const DrawResult result = Draw(blocks, true);
+    ASSERT_EQ(expected.colors, result.colors) << "state " << i;
+    ASSERT_EQ(expected.depths, result.depths) << "state " << i;
+
+    const Tev::Counters& a = expected.counters;
+    const Tev::Counters& b = result.counters;
+    EXPECT_EQ(a.tev_pixels_in, b.tev_pixels_in) << "state " << i;
+    EXPECT_EQ(a.tev_pixels_out, b.tev_pixels_out) << "state " << i;
+    EXPECT_EQ(a.perf_pixels, b.perf_pixels) << "state " << i;
+    EXPECT_EQ(a.bbox_left, b.bbox_left) << "state " << i;
+    EXPECT_EQ(a.bbox_right, b.bbox_right) << "state " << i;
+    EXPECT_EQ(a.bbox_top, b.bbox_top) << "state " << i;
+    EXPECT_EQ(a.bbox_bottom, b.bbox_bottom) << "state " << i;
+  }
+}
@@ -0,0 +1,171 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TextureSampler.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TMEM.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr int WIDTH = 37;
+constexpr int HEIGHT = 21;
+
+// Texture data at the start of TMEM, the second half of RGBA8 textures and the TLUT after it.
+constexpr u32 ODD_TMEM_LINE = 0x4000;
+constexpr u32 TLUT_TMEM_OFFSET = 0x400;
+
+void FillTmem(u32 seed)
+{
+  u32 state = seed;
+  for (u8& byte : texMem)
+  {
+    state = state * 1103515245 + 12345;
+    byte = static_cast<u8>(state >> 16);
+  }
+}
+
+TexUnit& GetTexUnit()
+{
+  return const_cast<TexUnit&>(bpmem.tex.GetUnit(0));
+}
+
+void SetTexture(TextureFormat format)
+{
+  std::memset(static_cast<void*>(&bpmem), 0, sizeof(bpmem));
+  TexUnit& unit = GetTexUnit();
+  unit.texMode0.wrap_s = WrapMode::Clamp;
+  unit.texMode0.wrap_t = WrapMode::Clamp;
+  unit.texImage0.width = WIDTH - 1;
+  unit.texImage0.height = HEIGHT - 1;
+  unit.texImage0.format = format;
+  unit.texImage1.cache_manually_managed = true;
+  unit.texImage1.tmem_even = 0;
+  unit.texImage2.tmem_odd = ODD_TMEM_LINE;
+  unit.texTlut.tmem_offset = TLUT_TMEM_OFFSET >> 9;
+  unit.texTlut.tlut_format = TLUTFormat::RGB5A3;
+}
+
+std::array<u8, 4> DecodeTexel(int s, int t)
+{
+  const TexUnit& unit = GetTexUnit();
+  std::array<u8, 4> texel;
+  if (unit.texImage0.format == TextureFormat::RGBA8)
+  {
+    TexDecoder_DecodeTexelRGBA8FromTmem(texel.data(), texMem,
+                                        &texMem[ODD_TMEM_LINE * TMEM_LINE_SIZE], s, t, WIDTH - 1);
+  }
+  else
+  {
+    TexDecoder_DecodeTexel(texel.data(), texMem, s, t, WIDTH - 1, unit.texImage0.format,
+                           &texMem[TLUT_TMEM_OFFSET], TLUTFormat::RGB5A3);
+  }
+  return texel;
+}
+
+std::array<u8, 4> SampleNearest(int s, int t)
+{
+  std::array<u8, 4> sample;
+  TextureSampler::SampleMip(s << 7, t << 7, 0, false, 0, sample.data());
+  return sample;
+}
+
+class SWTextureSamplerTest : public ::testing::TestWithParam<TextureFormat>
+{
+protected:
+  void SetUp() override
+  {
+    FillTmem(1);
+    SetTexture(GetParam());
+    TextureSampler::BeginBatch();
+  }
+
+  void TearDown() override { TextureSampler::Shutdown(); }
+};
+}  // namespace
+
+TEST_P(SWTextureSamplerTest, NearestMatchesTexelDecoder)
+{
+  for (int t = 0; t < HEIGHT; t++)
+  {
+    for (int s = 0; s < WIDTH; s++)
+      EXPECT_EQ(DecodeTexel(s, t), SampleNearest(s, t)) << fmt::format("texel {}, {}", s, t);
+  }
+}
+
+TEST_P(SWTextureSamplerTest, LinearMatchesTexelDecoder)
+{
+  for (int t = -64; t < HEIGHT * 128; t += 37)
+  {
+    for (int s = -64; s < WIDTH * 128; s += 29)
+    {
+      // Same as TextureSampler, with the wrap modes of SetTexture().
+      const int s0 = (s - 64) >> 7;
+      const int t0 = (t - 64) >> 7;
+      const int fract_s = (s - 64) & 0x7f;
+      const int fract_t = (t - 64) & 0x7f;
+      const int s_coords[] = {std::clamp(s0, 0, WIDTH - 1), std::clamp(s0 + 1, 0, WIDTH - 1)};
+      const int t_coords[] = {std::clamp(t0, 0, HEIGHT - 1), std::clamp(t0 + 1, 0, HEIGHT - 1)};
+      const u32 weights_s[] = {static_cast<u32>(128 - fract_s), static_cast<u32>(fract_s)};
+      const u32 weights_t[] = {static_cast<u32>(128 - fract_t), static_cast<u32>(fract_t)};
+
+      std::array<u32, 4> sum{};
+      for (int i = 0; i < 4; i++)
+      {
+        const std::array<u8, 4> texel = DecodeTexel(s_coords[i & 1], t_coords[i >> 1]);
+        for (int c = 0; c < 4; c++)
+          sum[c] += texel[c] * weights_s[i & 1] * weights_t[i >> 1];
+      }
+      std::array<u8, 4> expected;
+      for (int c = 0; c < 4; c++)
+        expected[c] = static_cast<u8>(sum[c] >> 14);
+
+      std::array<u8, 4> sample;
+      TextureSampler::SampleMip(s, t, 0, true, 0, sample.data());
+      EXPECT_EQ(expected, sample) << fmt::format("coordinates {}, {}", s, t);
+    }
+  }
+}
+
+TEST_P(SWTextureSamplerTest, LoadedTmemIsDecodedAgain)
+{
+  SampleNearest(0, 0);
+
+  // Like a TMEM preload.
+  FillTmem(2);
+  TMEM::InvalidateAll();
+  TextureSampler::BeginBatch();
+  for (int t = 0; t < HEIGHT; t++)
+  {
+    for (int s = 0; s < WIDTH; s++)
+      EXPECT_EQ(DecodeTexel(s, t), SampleNearest(s, t)) << fmt::format("texel {}, {}", s, t);
+  }
+}
+
+TEST_P(SWTextureSamplerTest, TmemIsOnlyCheckedAfterInvalidation)
+{
+  const std::array<u8, 4> expected = SampleNearest(0, 0);
+
+  FillTmem(2);
+  TextureSampler::BeginBatch();
+  EXPECT_EQ(expected, SampleNearest(0, 0));
+
+  TextureSampler::Invalidate();
+  TextureSampler::BeginBatch();
+  EXPECT_EQ(DecodeTexel(0, 0), SampleNearest(0, 0));
+}
+
+INSTANTIATE_TEST_CASE_P(AllFormats, SWTextureSamplerTest,
+                        ::testing::Values(TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4,
+                                          TextureFormat::IA8, TextureFormat::RGB565,
+                                          TextureFormat::RGB5A3, TextureFormat::RGBA8,
+                                          TextureFormat::C4, TextureFormat::C8,
+                                          TextureFormat::C14X2, TextureFormat::CMPR));
@@ -0,0 +1,152 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/Clipper.h"
+#include "VideoBackends/Software/NativeVertexFormat.h"
+#include "VideoBackends/Software/TransformUnit.h"
+#include "VideoCommon/XFMemory.h"
+
+namespace
+{
+// Not a multiple of four, so that the scalar remainder is covered too.
+constexpr u32 NUM_VERTICES = 1023;
+
+class Random
+{
+public:
+  explicit Random(u32 seed) : m_state(seed) {}
+
+  u32 Next()
+  {
+    m_state = m_state * 1103515245 + 12345;
+    return m_state >> 8;
+  }
+
+  float NextFloat(float range)
+  {
+    return (static_cast<float>(Next() & 0xffff) / 0x8000 - 1.0f) * range;
+  }
+
+private:
+  u32 m_state;
+};
+
+void SetUpXFMemory(Random& random, ProjectionType projection_type)
+{
+  std::memset(static_cast<void*>(&xfmem), 0, sizeof(xfmem));
+  for (float& element : xfmem.posMatrices)
+    element = random.NextFloat(4.0f);
+  for (float& element : xfmem.normalMatrices)
+    element = random.NextFloat(2.0f);
+  for (float& element : xfmem.projection.rawProjection)
+    element = random.NextFloat(3.0f);
+  xfmem.projection.type = projection_type;
+}
+
+std::vector<InputVertexData> MakeVertices(Random& random, bool shared_matrix)
+{
+  std::vector<InputVertexData> vertices(NUM_VERTICES);
+  for (u32 i = 0; i < NUM_VERTICES; i++)
+  {
+    InputVertexData& vertex = vertices[i];
+    vertex.posMtx = shared_matrix ? 9 : static_cast<u8>(random.Next() % 21 * 3);
+    vertex.position = Vec3(random.NextFloat(100.0f), random.NextFloat(100.0f),
+                           random.NextFloat(100.0f));
+    for (Vec3& normal : vertex.normal)
+      normal = Vec3(random.NextFloat(1.0f), random.NextFloat(1.0f), random.NextFloat(1.0f));
+  }
+
+  // Values that tend to take different paths through floating point hardware.
+  vertices[0].position = Vec3(0.0f, -0.0f, 0.0f);
+  vertices[1].normal[0] = Vec3(0.0f, 0.0f, 0.0f);
+  vertices[2].position = Vec3(std::numeric_limits<float>::infinity(), 1.0f, -1.0f);
+  vertices[3].position = Vec3(1.0f, std::numeric_limits<float>::quiet_NaN(), 1.0f);
+  vertices[4].position = Vec3(std::numeric_limits<float>::denorm_min(), 1e30f, -1e-30f);
+  return vertices;
+}
+
+void ExpectSameBits(const void* a, const void* b, size_t size, u32 vertex, const char* what)
+{
+  EXPECT_EQ(std::memcmp(a, b, size), 0) << what << " of vertex " << vertex << " differs";
+}
+
+void CheckBatchedTransform(ProjectionType projection_type, bool shared_matrix, bool nbt)
+{
+  Random random(1234);
+  SetUpXFMemory(random, projection_type);
+  const std::vector<InputVertexData> input = MakeVertices(random, shared_matrix);
+
+  std::vector<OutputVertexData> scalar(NUM_VERTICES);
+  for (u32 i = 0; i < NUM_VERTICES; i++)
+  {
+    TransformUnit::TransformPosition(&input[i], &scalar[i]);
+    TransformUnit::TransformNormal(&input[i], nbt, &scalar[i]);
+    scalar[i].clipMask = Clipper::CalcClipMask(&scalar[i]);
+  }
+
+  std::vector<OutputVertexData> batched(NUM_VERTICES);
+  TransformUnit::TransformPositions(input.data(), batched.data(), NUM_VERTICES);
+  TransformUnit::TransformNormals(input.data(), nbt, batched.data(), NUM_VERTICES);
+  Clipper::CalcClipMasks(batched.data(), NUM_VERTICES);
+
+  for (u32 i = 0; i < NUM_VERTICES; i++)
+  {
+    ExpectSameBits(&batched[i].mvPosition, &scalar[i].mvPosition, sizeof(Vec3), i, "mvPosition");
+    ExpectSameBits(&batched[i].projectedPosition, &scalar[i].projectedPosition, sizeof(Vec4), i,
+                   "projectedPosition");
+    ExpectSameBits(batched[i].normal.data(), scalar[i].normal.data(), sizeof(scalar[i].normal), i,
+                   "normal");
+    EXPECT_EQ(batched[i].clipMask, scalar[i].clipMask) << "clip mask of vertex " << i;
+  }
+}
+}  // namespace
+
+TEST(SWTransform, PerspectiveMatchesScalar)
+{
+  CheckBatchedTransform(ProjectionType::Perspective, false, false);
+}
+
+TEST(SWTransform, OrthographicMatchesScalar)
+{
+  CheckBatchedTransform(ProjectionType::Orthographic, false, false);
+}
+
+TEST(SWTransform, SharedMatrixMatchesScalar)
+{
+  CheckBatchedTransform(ProjectionType::Perspective, true, false);
+}
+
+TEST(SWTransform, BinormalsMatchScalar)
+{
+  CheckBatchedTransform(ProjectionType::Perspective, false, true);
+}
+
+TEST(SWTransform, ClipMasksCoverAllPlanes)
+{
+  std::vector<OutputVertexData> vertices(8);
+  vertices[0].projectedPosition = {0.0f, 0.0f, -0.5f, 1.0f};
+  vertices[1].projectedPosition = {2.0f, 0.0f, -0.5f, 1.0f};
+  vertices[2].projectedPosition = {-2.0f, 0.0f, -0.5f, 1.0f};
+  vertices[3].projectedPosition = {0.0f, 2.0f, -0.5f, 1.0f};
+  vertices[4].projectedPosition = {0.0f, -2.0f, -0.5f, 1.0f};
+  vertices[5].projectedPosition = {0.0f, 0.0f, 0.5f, 1.0f};
+  vertices[6].projectedPosition = {0.0f, 0.0f, -2.0f, 1.0f};
+  vertices[7].projectedPosition = {2.0f, 2.0f, 0.5f, 1.0f};
+  Clipper::CalcClipMasks(vertices.data(), static_cast<u32>(vertices.size()));
+
+  EXPECT_EQ(vertices[0].clipMask, 0x00);
+  EXPECT_EQ(vertices[1].clipMask, 0x01);
+  EXPECT_EQ(vertices[2].clipMask, 0x02);
+  EXPECT_EQ(vertices[3].clipMask, 0x04);
+  EXPECT_EQ(vertices[4].clipMask, 0x08);
+  EXPECT_EQ(vertices[5].clipMask, 0x10);
+  EXPECT_EQ(vertices[6].clipMask, 0x20);
+  EXPECT_EQ(vertices[7].clipMask, 0x15);
+}
@@ -0,0 +1,193 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/AddressRangeIndex.h"
+
+namespace
+{
+struct TestRange
+{
+  u32 address;
+  u32 size;
+  int id;
+};
+
+class RandomGenerator
+{
+public:
+  u32 Next(u32 max)
+  {
+    m_state = m_state * 1103515245 + 12345;
+    return (m_state >> 8) % max;
+  }
+
+private:
+  u32 m_state = 1;
+};
+
+std::vector<int> CollectOverlapping(const AddressRangeIndex<int>& index, u32 address, u32 size)
+{
+  std::vector<int> ids;
+  index.ForEachOverlapping(address, size, [&](int id) { ids.push_back(id); });
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+std::vector<int> CollectOverlapping(const std::vector<TestRange>& ranges, u32 address, u32 size)
+{
+  std::vector<int> ids;
+  for (const TestRange& range : ranges)
+  {
+    if (range.size != 0 && range.address < u64(address) + size &&
+        u64(range.address) + range.size > address)
+    {
+      ids.push_back(range.id);
+    }
+  }
+  std::sort(ids.begin(), ids.end());
+  return ids;
+}
+
+u32 GetLowestOverlappingAddress(const std::vector<TestRange>& ranges, u32 address)
+{
+  u32 lowest_address = address;
+  for (const TestRange& range : ranges)
+  {
+    if (range.address < lowest_address && u64(range.address) + range.size > address)
+      lowest_address = range.address;
+  }
+  return lowest_address;
+}
+}  // namespace
+
+TEST(AddressRangeIndex, Empty)
+{
+  AddressRangeIndex<int> index;
+  EXPECT_EQ(0x1000u, index.GetLowestOverlappingAddress(0x1000));
+  EXPECT_TRUE(CollectOverlapping(index, 0, 0x10000000).empty());
+}
+
+TEST(AddressRangeIndex, Boundaries)
+{
+  AddressRangeIndex<int> index;
+  index.Add(0x10000, 0x10000, 1);
+  index.Add(0x1FFFF, 2, 2);
+  index.Add(0x30000, 0, 3);
+
+  EXPECT_EQ(std::vector<int>{}, CollectOverlapping(index, 0, 0x10000));
+  EXPECT_EQ(std::vector<int>{1}, CollectOverlapping(index, 0xFFFF, 2));
+  EXPECT_EQ((std::vector<int>{1, 2}), CollectOverlapping(index, 0x1FFFF, 1));
+  EXPECT_EQ(std::vector<int>{2}, CollectOverlapping(index, 0x20000, 0x10000));
+  EXPECT_EQ(std::vector<int>{}, CollectOverlapping(index, 0x20001, 0x10000));
+
+  EXPECT_EQ(0x10000u, index.GetLowestOverlappingAddress(0x1FFFF));
+  EXPECT_EQ(0x1FFFFu, index.GetLowestOverlappingAddress(0x20000));
+  EXPECT_EQ(0x20001u, index.GetLowestOverlappingAddress(0x20001));
+
+  index.Remove(0x10000, 0x10000, 1);
+  EXPECT_EQ(std::vector<int>{2}, CollectOverlapping(index, 0, 0x100000));
+  EXPECT_EQ(0x1FFFFu, index.GetLowestOverlappingAddress(0x20000));
+}
+
+TEST(AddressRangeIndex, MatchesLinearSearch)
+{
+  AddressRangeIndex<int> index;
+  std::vector<TestRange> ranges;
+  RandomGenerator random;
+
+  for (int i = 0; i < 2000; i++)
+  {
+    if (!ranges.empty() && random.Next(3) == 0)
+    {
+      const size_t remove = random.Next(static_cast<u32>(ranges.size()));
+      index.Remove(ranges[remove].address, ranges[remove].size, ranges[remove].id);
+      ranges.erase(ranges.begin() + remove);
+    }
+    else
+    {
+      const TestRange range{random.Next(0x01800000), random.Next(0x100000), i};
+      index.Add(range.address, range.size, range.id);
+      ranges.push_back(range);
+    }
+
+    const u32 address = random.Next(0x01800000);
+    const u32 size = random.Next(0x200000);
+    ASSERT_EQ(CollectOverlapping(ranges, address, size), CollectOverlapping(index, address, size));
+    ASSERT_EQ(GetLowestOverlappingAddress(ranges, address),
+              index.GetLowestOverlappingAddress(address));
+  }
+}
+
+// Mimics the texture cache around EFB copies: a few large copies are repeatedly replaced, while
+// many small textures stay resident around them. Each copy looks up what it overlaps first.
+class AddressRangeIndexSpeedTest : public ::testing::Test
+{
+protected:
+  static constexpr u32 NUM_TEXTURES = 4000;
+  static constexpr u32 NUM_COPIES = 200000;
+  static constexpr u32 COPY_SIZE = 640 * 528 * 2;
+
+  void SetUp() override
+  {
+    for (u32 i = 0; i < NUM_TEXTURES; i++)
+      m_textures.push_back({random.Next(0x01800000), 0x20u << random.Next(12), static_cast<int>(i)});
+  }
+
+  RandomGenerator random;
+  std::vector<TestRange> m_textures;
+};
+
+TEST_F(AddressRangeIndexSpeedTest, Multimap)
+{
+  // The previous lookup: everything starting up to the largest texture size below the address.
+  constexpr u32 max_texture_size = 1024 * 1024 * 4;
+  std::multimap<u32, const TestRange*> textures;
+  for (const TestRange& texture : m_textures)
+    textures.emplace(texture.address, &texture);
+
+  u32 num_overlapping = 0;
+  for (u32 i = 0; i < NUM_COPIES; i++)
+  {
+    const u32 address = random.Next(0x01800000 - COPY_SIZE);
+    const u32 lower_address = address > max_texture_size ? address - max_texture_size : 0;
+    const auto end = textures.upper_bound(address + COPY_SIZE);
+    for (auto iter = textures.lower_bound(lower_address); iter != end; ++iter)
+    {
+      if (iter->second->address + iter->second->size > address)
+        num_overlapping++;
+    }
+  }
+  EXPECT_NE(0u, num_overlapping);
+}
+
+TEST_F(AddressRangeIndexSpeedTest, AddressRangeIndex)
+{
+  std::multimap<u32, const TestRange*> textures;
+  AddressRangeIndex<const TestRange*> index;
+  for (const TestRange& texture : m_textures)
+  {
+    textures.emplace(texture.address, &texture);
+    index.Add(texture.address, texture.size, &texture);
+  }
+
+  u32 num_overlapping = 0;
+  for (u32 i = 0; i < NUM_COPIES; i++)
+  {
+    const u32 address = random.Next(0x01800000 - COPY_SIZE);
+    const auto end = textures.upper_bound(address + COPY_SIZE);
+    for (auto iter = textures.lower_bound(index.GetLowestOverlappingAddress(address)); iter != end;
+         ++iter)
+    {
+      if (iter->second->address + iter->second->size > address)
+        num_overlapping++;
+    }
+  }
+  EXPECT_NE(0u, num_overlapping);
+}
@@ -0,0 +1,189 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/AsyncShaderCompiler.h"
+
+using VideoCommon::AsyncShaderCompiler;
+
+namespace
+{
+struct CompileLog
+{
+  std::mutex lock;
+  std::vector<int> compiled;
+  std::vector<int> retrieved;
+};
+
+class TestWorkItem final : public AsyncShaderCompiler::WorkItem
+{
+public:
+  TestWorkItem(CompileLog* log, int id, const std::atomic_bool* gate)
+      : m_log(log), m_id(id), m_gate(gate)
+  {
+  }
+
+  bool Compile() override
+  {
+    while (m_gate && !m_gate->load())
+      std::this_thread::yield();
+
+    std::lock_guard<std::mutex> guard(m_log->lock);
+    m_log->compiled.push_back(m_id);
+    return true;
+  }
+
+  void Retrieve() override { m_log->retrieved.push_back(m_id); }
+
+private:
+  CompileLog* m_log;
+  int m_id;
+  const std::atomic_bool* m_gate;
+};
+
+// Holds back the worker threads until the gate is opened, so that the order in which queued items
+// are taken is deterministic.
+class AsyncShaderCompilerTest : public testing::Test
+{
+protected:
+  void TearDown() override
+  {
+    m_gate_open.store(true);
+    m_compiler.StopWorkerThreads();
+  }
+
+  // Makes the given number of worker threads wait for the gate.
+  void BlockWorkers(u32 num_blocked_workers)
+  {
+    for (u32 i = 0; i < num_blocked_workers; i++)
+      Queue(-1, 0, AsyncShaderCompiler::NO_DEADLINE, &m_gate_open);
+    WaitForEmptyQueue();
+  }
+
+  void WaitForEmptyQueue()
+  {
+    const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (m_compiler.GetMetrics().queue_depth != 0)
+    {
+      ASSERT_LT(std::chrono::steady_clock::now(), timeout);
+      std::this_thread::yield();
+    }
+  }
+
+  void OpenGate()
+  {
+    m_gate_open.store(true);
+    m_compiler.WaitUntilCompletion();
+    m_compiler.RetrieveWorkItems();
+  }
+
+  AsyncShaderCompiler::WorkItem* Queue(int id, u32 priority, u64 deadline,
+                                       const std::atomic_bool* gate = nullptr)
+  {
+    auto item = AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&m_log, id, gate);
+    AsyncShaderCompiler::WorkItem* const raw_item = item.get();
+    m_compiler.QueueWorkItem(std::move(item), priority, deadline);
+    return raw_item;
+  }
+
+  AsyncShaderCompiler m_compiler;
+  std::atomic_bool m_gate_open{false};
+  CompileLog m_log;
+};
+}  // namespace
+
+TEST_F(AsyncShaderCompilerTest, CompilesSynchronouslyWithoutWorkerThreads)
+{
+  Queue(1, 0, AsyncShaderCompiler::NO_DEADLINE);
+  EXPECT_EQ(std::vector<int>{1}, m_log.compiled);
+
+  m_compiler.RetrieveWorkItems();
+  EXPECT_EQ(std::vector<int>{1}, m_log.retrieved);
+}
+
+TEST_F(AsyncShaderCompilerTest, OrdersByDeadlineThenPriority)
+{
+  ASSERT_TRUE(m_compiler.StartWorkerThreads(1));
+  BlockWorkers(1);
+  Queue(1, 300, AsyncShaderCompiler::NO_DEADLINE);
+  Queue(2, 100, AsyncShaderCompiler::NO_DEADLINE);
+  Queue(3, 200, 5);
+  Queue(4, 100, 6);
+  Queue(5, 100, 5);
+  OpenGate();
+
+  const std::vector<int> expected = {-1, 5, 3, 4, 2, 1};
+  EXPECT_EQ(expected, m_log.compiled);
+  EXPECT_EQ(expected.size(), m_log.retrieved.size());
+}
+
+TEST_F(AsyncShaderCompilerTest, WorkersStealQueuedItems)
+{
+  constexpr u32 NUM_WORKERS = 4;
+  ASSERT_TRUE(m_compiler.StartWorkerThreads(NUM_WORKERS));
+  BlockWorkers(NUM_WORKERS - 1);
+
+  // The items are spread over every worker's queue, but only one worker is free to take them.
+  for (int i = 0; i < 20; i++)
+    Queue(i, 0, AsyncShaderCompiler::NO_DEADLINE);
+  WaitForEmptyQueue();
+
+  OpenGate();
+  EXPECT_EQ(20u + NUM_WORKERS - 1, m_log.compiled.size());
+  EXPECT_EQ(20u + NUM_WORKERS - 1, m_log.retrieved.size());
+}
+
+TEST_F(AsyncShaderCompilerTest, SkipsCancelledItems)
+{
+  ASSERT_TRUE(m_compiler.StartWorkerThreads(1));
+  BlockWorkers(1);
+  Queue(1, 0, AsyncShaderCompiler::NO_DEADLINE)->Cancel();
+  Queue(2, 0, AsyncShaderCompiler::NO_DEADLINE);
+  OpenGate();
+
+  // Cancelled items are retrieved without being compiled.
+  EXPECT_EQ((std::vector<int>{-1, 2}), m_log.compiled);
+  EXPECT_EQ((std::vector<int>{-1, 1, 2}), m_log.retrieved);
+
+  const AsyncShaderCompiler::Metrics metrics = m_compiler.GetMetrics();
+  EXPECT_EQ(2u, metrics.num_compiled);
+  EXPECT_EQ(1u, metrics.num_cancelled);
+}
+
+TEST_F(AsyncShaderCompilerTest, CountsMissedDeadlines)
+{
+  ASSERT_TRUE(m_compiler.StartWorkerThreads(1));
+  BlockWorkers(1);
+  Queue(1, 0, m_compiler.GetCurrentFrame());
+  Queue(2, 0, m_compiler.GetCurrentFrame() + 1);
+  m_compiler.AdvanceFrame();
+  m_compiler.AdvanceFrame();
+  OpenGate();
+
+  const AsyncShaderCompiler::Metrics metrics = m_compiler.GetMetrics();
+  EXPECT_EQ(2u, metrics.num_deadlines_missed);
+  EXPECT_EQ(3u, metrics.num_compiled);
+  EXPECT_LE(metrics.latency_p50, metrics.latency_p99);
+}
+
+TEST_F(AsyncShaderCompilerTest, KeepsPendingWorkWhenResizing)
+{
+  ASSERT_TRUE(m_compiler.StartWorkerThreads(1));
+  BlockWorkers(1);
+  for (int i = 0; i < 10; i++)
+    Queue(i, 0, AsyncShaderCompiler::NO_DEADLINE);
+
+  m_gate_open.store(true);
+  ASSERT_TRUE(m_compiler.ResizeWorkerThreads(3));
+  m_compiler.WaitUntilCompletion();
+  m_compiler.RetrieveWorkItems();
+  EXPECT_EQ(11u, m_log.retrieved.size());
+}
@@ -0,0 +1,211 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DisplayListCache.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+namespace
+{
+// Logs every call with its arguments, pointers as offsets into the display list.
+class LoggingCallback final : public OpcodeDecoder::Callback
+{
+public:
+  LoggingCallback(const u8* start, CPState& cp_state) : m_start(start), m_cp_state(cp_state) {}
+
+  void OnXF(u16 address, u8 count, const u8* data) override
+  {
+    Log(fmt::format("XF {:x} {} {}", address, count, data - m_start));
+  }
+  void OnCP(u8 command, u32 value) override { Log(fmt::format("CP {:x} {:x}", command, value)); }
+  void OnBP(u8 command, u32 value) override { Log(fmt::format("BP {:x} {:x}", command, value)); }
+  void OnIndexedLoad(CPArray array, u32 index, u16 address, u8 size) override
+  {
+    Log(fmt::format("IndexedLoad {} {} {:x} {}", static_cast<u8>(array), index, address, size));
+  }
+  void OnPrimitiveCommand(OpcodeDecoder::Primitive primitive, u8 vat, u32 vertex_size,
+                          u16 num_vertices, const u8* vertex_data) override
+  {
+    Log(fmt::format("Primitive {} {} {} {} {}", primitive, vat, vertex_size, num_vertices,
+                    vertex_data - m_start));
+  }
+  void OnDisplayList(u32 address, u32 size) override
+  {
+    Log(fmt::format("DisplayList {:x} {}", address, size));
+  }
+  void OnNop(u32 count) override { Log(fmt::format("Nop {}", count)); }
+  void OnUnknown(u8 opcode, const u8* data) override
+  {
+    Log(fmt::format("Unknown {:x} {}", opcode, data - m_start));
+  }
+  void OnCommand(const u8* data, u32 size) override
+  {
+    Log(fmt::format("Command {} {}", data - m_start, size));
+  }
+  CPState& GetCPState() override { return m_cp_state; }
+
+  std::vector<std::string> m_log;
+
+private:
+  void Log(std::string entry) { m_log.push_back(std::move(entry)); }
+
+  const u8* m_start;
+  CPState& m_cp_state;
+};
+
+std::vector<u8> MakeDisplayList(std::initializer_list<std::initializer_list<u8>> commands)
+{
+  std::vector<u8> data;
+  for (const auto& command : commands)
+    data.insert(data.end(), command);
+  return data;
+}
+
+class DisplayListCacheTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    m_data = MakeDisplayList({
+        {0x00, 0x00},                                            // NOPs
+        {0x61, 0x28, 0x12, 0x34, 0x56},                          // BP
+        {0x08, 0x30, 0x01, 0x02, 0x03, 0x04},                    // CP
+        {0x10, 0x00, 0x01, 0x10, 0x20, 1, 2, 3, 4, 5, 6, 7, 8},  // XF, 2 values
+        {0x20, 0x00, 0x05, 0xB0, 0x00},                          // Indexed load
+        {0x80, 0x00, 0x04, 1, 2, 3, 4, 5, 6, 7, 8},              // Quads, 4 vertices of 2 bytes
+        {0x00},                                                  // NOP
+    });
+
+    m_cp_state.vtx_desc.low.Position = VertexComponentFormat::Direct;
+    m_cp_state.vtx_attr[0].g0.PosElements = CoordComponentCount::XY;
+    m_cp_state.vtx_attr[0].g0.PosFormat = ComponentFormat::UByte;
+  }
+
+  std::vector<std::string> RunDirectly()
+  {
+    LoggingCallback callback(m_data.data(), m_cp_state);
+    OpcodeDecoder::Run(m_data.data(), static_cast<u32>(m_data.size()), callback);
+    return callback.m_log;
+  }
+
+  std::vector<std::string> RunCached(bool expect_replayed, u32 address = 0x80001000)
+  {
+    LoggingCallback callback(m_data.data(), m_cp_state);
+    EXPECT_EQ(expect_replayed,
+              m_cache.Run(address, m_data.data(), static_cast<u32>(m_data.size()), callback));
+    return callback.m_log;
+  }
+
+  std::vector<u8> m_data;
+  CPState m_cp_state;
+  OpcodeDecoder::DisplayListCache m_cache;
+};
+}  // namespace
+
+TEST_F(DisplayListCacheTest, ReplaysSameCalls)
+{
+  const std::vector<std::string> expected = RunDirectly();
+  ASSERT_EQ(14u, expected.size());
+
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(true));
+  EXPECT_EQ(expected, RunCached(true));
+}
+
+TEST_F(DisplayListCacheTest, DecodesChangedContentsAgain)
+{
+  RunCached(false);
+  m_data[4] = 0x78;
+  const std::vector<std::string> expected = RunDirectly();
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(true));
+}
+
+TEST_F(DisplayListCacheTest, ReplaysChangedXFAndVertexData)
+{
+  RunCached(false);
+  m_data[20] = 0x42;
+  m_data[36] = 0x43;
+  EXPECT_EQ(RunDirectly(), RunCached(true));
+}
+
+TEST_F(DisplayListCacheTest, DecodesChangedPrimitiveAgain)
+{
+  RunCached(false);
+
+  // Lines instead of quads, with the same vertices.
+  m_data[31] = 0xA8;
+  const std::vector<std::string> expected = RunDirectly();
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(true));
+}
+
+TEST_F(DisplayListCacheTest, DecodesChangedVertexFormatAgain)
+{
+  RunCached(false);
+
+  // The quads now take up the rest of the display list, so that the last NOP is gone.
+  m_cp_state.vtx_attr[0].g0.PosFormat = ComponentFormat::UShort;
+  m_data.insert(m_data.end() - 1, 7, 0);
+  const std::vector<std::string> expected = RunDirectly();
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(true));
+
+  // The old format works again, it's just decoded once more.
+  m_cp_state.vtx_attr[0].g0.PosFormat = ComponentFormat::UByte;
+  EXPECT_EQ(RunDirectly(), RunCached(false));
+}
+
+TEST_F(DisplayListCacheTest, DoesNotReplayNestedDisplayLists)
+{
+  m_data.insert(m_data.end(), {0x40, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x20});
+  const std::vector<std::string> expected = RunDirectly();
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(false));
+}
+
+TEST_F(DisplayListCacheTest, StopsAtTruncatedCommand)
+{
+  // A primitive which doesn't fit, as happens when a game passes the wrong size.
+  m_data.resize(m_data.size() - 4);
+  const std::vector<std::string> expected = RunDirectly();
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(true));
+}
+
+TEST_F(DisplayListCacheTest, DecodesChangedTruncatedCommandAgain)
+{
+  m_data.resize(m_data.size() - 4);
+  RunCached(false);
+
+  // The primitive becomes NOPs, which fit.
+  std::fill(m_data.begin() + 31, m_data.end(), 0);
+  const std::vector<std::string> expected = RunDirectly();
+  EXPECT_EQ(expected, RunCached(false));
+  EXPECT_EQ(expected, RunCached(true));
+}
+
+TEST_F(DisplayListCacheTest, KeepsRecentlyCalledDisplayLists)
+{
+  RunCached(false);
+  for (u32 i = 1; i <= 2 * OpcodeDecoder::DisplayListCache::MAX_ENTRIES; i++)
+  {
+    RunCached(false, 0x80100000 + i * 0x100);
+    if (i % 1000 == 0)
+      RunCached(true);
+  }
+  RunCached(true);
+
+  // The display lists which weren't called again are gone.
+  RunCached(false, 0x80100100);
+}
@@ -0,0 +1,169 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/EFBPeekPredictor.h"
+
+namespace
+{
+constexpr u32 NUM_TILES = 16;
+
+struct Peek
+{
+  u32 draw_counter;
+  u32 tile_index;
+  bool depth;
+};
+
+// Stands in for the EFB caches of FramebufferManager: every draw invalidates all cached tiles,
+// and a peek reads its tile back if it isn't cached.
+class FakeEFBCache
+{
+public:
+  FakeEFBCache() { m_predictor.Reset(NUM_TILES); }
+
+  // Runs a frame with the given number of draws, and the peeks after them.
+  void RunFrame(u32 num_draws, const std::vector<Peek>& peeks)
+  {
+    misses = 0;
+    hits = 0;
+    prefetches.clear();
+
+    auto peek = peeks.begin();
+    for (u32 draw_counter = 0; draw_counter < num_draws; draw_counter++)
+    {
+      Draw(draw_counter);
+      for (; peek != peeks.end() && peek->draw_counter == draw_counter; ++peek)
+        PeekTile(draw_counter, peek->tile_index, peek->depth);
+    }
+
+    m_predictor.OnEndFrame();
+  }
+
+  void Draw(u32 draw_counter)
+  {
+    for (auto& valid : m_valid)
+      valid.fill(false);
+
+    m_predictor.OnDraw(draw_counter, [&](bool depth, u32 tile_index) {
+      if (m_valid[depth][tile_index])
+        return false;
+
+      m_valid[depth][tile_index] = true;
+      prefetches.push_back({draw_counter, tile_index, depth});
+      return true;
+    });
+  }
+
+  void PeekTile(u32 draw_counter, u32 tile_index, bool depth)
+  {
+    const bool miss = !m_valid[depth][tile_index];
+    if (miss)
+    {
+      m_valid[depth][tile_index] = true;
+      misses++;
+    }
+
+    if (m_predictor.OnPeek(depth, tile_index, draw_counter, miss))
+      hits++;
+  }
+
+  void Invalidate(u32 tile_index, bool depth) { m_valid[depth][tile_index] = false; }
+
+  u32 misses = 0;
+  u32 hits = 0;
+  std::vector<Peek> prefetches;
+
+private:
+  EFBPeekPredictor m_predictor;
+  std::array<std::array<bool, NUM_TILES>, 2> m_valid{};
+};
+
+// Several peeks of several tiles, in color and depth, after two of the five draws of a frame.
+const std::vector<Peek> s_peeks = {
+    {1, 3, false}, {1, 3, false}, {1, 7, false}, {1, 3, true}, {1, 7, false},
+    {3, 7, false}, {3, 12, true}, {3, 12, true}, {3, 7, false},
+};
+}  // namespace
+
+TEST(EFBPeekPredictor, PrefetchesEveryTileInEveryFrame)
+{
+  FakeEFBCache cache;
+
+  cache.RunFrame(5, s_peeks);
+  EXPECT_EQ(cache.misses, 5u);
+  EXPECT_EQ(cache.hits, 0u);
+  EXPECT_TRUE(cache.prefetches.empty());
+
+  // Every tile has to be predicted again from the hits of the frame before.
+  for (int frame = 1; frame < 5; frame++)
+  {
+    cache.RunFrame(5, s_peeks);
+    EXPECT_EQ(cache.misses, 0u) << "frame " << frame;
+    EXPECT_EQ(cache.hits, s_peeks.size()) << "frame " << frame;
+    ASSERT_EQ(cache.prefetches.size(), 5u) << "frame " << frame;
+    EXPECT_EQ(cache.prefetches[0].draw_counter, 1u);
+    EXPECT_EQ(cache.prefetches[4].draw_counter, 3u);
+  }
+}
+
+TEST(EFBPeekPredictor, ForgetsTilesWhichAreNoLongerPeeked)
+{
+  FakeEFBCache cache;
+
+  cache.RunFrame(5, s_peeks);
+  cache.RunFrame(5, {{3, 12, true}});
+  EXPECT_EQ(cache.hits, 1u);
+  EXPECT_EQ(cache.prefetches.size(), 5u);
+
+  cache.RunFrame(5, {{3, 12, true}});
+  EXPECT_EQ(cache.hits, 1u);
+  ASSERT_EQ(cache.prefetches.size(), 1u);
+  EXPECT_EQ(cache.prefetches[0].tile_index, 12u);
+  EXPECT_TRUE(cache.prefetches[0].depth);
+}
+
+TEST(EFBPeekPredictor, InvalidatedTilesAreMisses)
+{
+  FakeEFBCache cache;
+
+  cache.RunFrame(5, s_peeks);
+
+  cache.misses = 0;
+  cache.hits = 0;
+  cache.Draw(0);
+  cache.Draw(1);
+  cache.Invalidate(7, false);
+  cache.PeekTile(1, 3, false);
+  cache.PeekTile(1, 7, false);
+  cache.PeekTile(1, 7, false);
+  EXPECT_EQ(cache.misses, 1u);
+  EXPECT_EQ(cache.hits, 1u);
+
+  // The prefetch after the next draw is hit again.
+  cache.Draw(2);
+  cache.Draw(3);
+  cache.PeekTile(3, 7, false);
+  EXPECT_EQ(cache.hits, 2u);
+}
+
+TEST(EFBPeekPredictor, ResetForgetsPeeks)
+{
+  EFBPeekPredictor predictor;
+  predictor.Reset(NUM_TILES);
+  predictor.OnPeek(false, 1, 0, true);
+  predictor.OnEndFrame();
+  EXPECT_EQ(predictor.GetPredictedPeeks().size(), 1u);
+
+  predictor.Reset(NUM_TILES);
+  EXPECT_TRUE(predictor.GetPredictedPeeks().empty());
+  predictor.OnDraw(0, [](bool, u32) {
+    ADD_FAILURE() << "Nothing should be prefetched";
+    return true;
+  });
+}
@@ -0,0 +1,209 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u16 PRIMITIVE_RESTART = UINT16_MAX;
+
+// The scalar generators, one triangle or line at a time, which the IndexGenerator has to match.
+void WriteTriangle(std::vector<u16>* out, bool pr, u32 index1, u32 index2, u32 index3)
+{
+  out->insert(out->end(), {u16(index1), u16(index2), u16(index3)});
+  if (pr)
+    out->push_back(PRIMITIVE_RESTART);
+}
+
+void ReferenceStrip(std::vector<u16>* out, bool pr, u32 num_verts, u32 index)
+{
+  if (pr)
+  {
+    for (u32 i = 0; i < num_verts; ++i)
+      out->push_back(index + i);
+    out->push_back(PRIMITIVE_RESTART);
+    return;
+  }
+
+  bool wind = false;
+  for (u32 i = 2; i < num_verts; ++i)
+  {
+    WriteTriangle(out, pr, index + i - 2, index + i - !wind, index + i - wind);
+    wind ^= true;
+  }
+}
+
+void ReferenceFan(std::vector<u16>* out, bool pr, u32 num_verts, u32 index)
+{
+  u32 i = 2;
+  if (pr)
+  {
+    for (; i + 3 <= num_verts; i += 3)
+    {
+      out->insert(out->end(), {u16(index + i - 1), u16(index + i), u16(index), u16(index + i + 1),
+                               u16(index + i + 2), PRIMITIVE_RESTART});
+    }
+    for (; i + 2 <= num_verts; i += 2)
+    {
+      out->insert(out->end(), {u16(index + i - 1), u16(index + i), u16(index), u16(index + i + 1),
+                               PRIMITIVE_RESTART});
+    }
+  }
+  for (; i < num_verts; ++i)
+    WriteTriangle(out, pr, index, index + i - 1, index + i);
+}
+
+void ReferenceQuads(std::vector<u16>* out, bool pr, u32 num_verts, u32 index)
+{
+  u32 i = 3;
+  for (; i < num_verts; i += 4)
+  {
+    if (pr)
+    {
+      out->insert(out->end(), {u16(index + i - 2), u16(index + i - 1), u16(index + i - 3),
+                               u16(index + i), PRIMITIVE_RESTART});
+    }
+    else
+    {
+      WriteTriangle(out, pr, index + i - 3, index + i - 2, index + i - 1);
+      WriteTriangle(out, pr, index + i - 3, index + i - 1, index + i);
+    }
+  }
+  if (i == num_verts)
+    WriteTriangle(out, pr, index + num_verts - 3, index + num_verts - 2, index + num_verts - 1);
+}
+
+void ReferenceLineStrip(std::vector<u16>* out, u32 num_verts, u32 index)
+{
+  for (u32 i = 1; i < num_verts; ++i)
+    out->insert(out->end(), {u16(index + i - 1), u16(index + i)});
+}
+
+void GenerateReference(std::vector<u16>* out, Primitive primitive, bool pr, u32 num_verts,
+                       u32 index)
+{
+  switch (primitive)
+  {
+  case Primitive::GX_DRAW_QUADS:
+    ReferenceQuads(out, pr, num_verts, index);
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_STRIP:
+    ReferenceStrip(out, pr, num_verts, index);
+    break;
+  case Primitive::GX_DRAW_TRIANGLE_FAN:
+    ReferenceFan(out, pr, num_verts, index);
+    break;
+  case Primitive::GX_DRAW_LINE_STRIP:
+    ReferenceLineStrip(out, num_verts, index);
+    break;
+  default:
+    break;
+  }
+}
+
+// Enough for any of the primitives below at their largest size.
+constexpr size_t BUFFER_SIZE = 0x20000;
+constexpr u16 CANARY = 0xCDCD;
+
+class IndexGeneratorTest : public ::testing::TestWithParam<std::tuple<Primitive, bool>>
+{
+protected:
+  void SetUp() override
+  {
+    std::tie(m_primitive, m_primitive_restart) = GetParam();
+    m_generator.Init(m_primitive_restart);
+    m_buffer.assign(BUFFER_SIZE, CANARY);
+    m_generator.Start(m_buffer.data());
+  }
+
+  Primitive m_primitive{};
+  bool m_primitive_restart = false;
+  IndexGenerator m_generator;
+  std::vector<u16> m_buffer;
+};
+}  // namespace
+
+INSTANTIATE_TEST_CASE_P(
+    AllGenerators, IndexGeneratorTest,
+    ::testing::Combine(::testing::Values(Primitive::GX_DRAW_QUADS,
+                                         Primitive::GX_DRAW_TRIANGLE_STRIP,
+                                         Primitive::GX_DRAW_TRIANGLE_FAN,
+                                         Primitive::GX_DRAW_LINE_STRIP),
+                       ::testing::Bool()));
+
+TEST_P(IndexGeneratorTest, MatchesScalarGenerator)
+{
+  // Every size around the vectorized loops' iteration counts, drawn back to back so that the
+  // base index differs between draws.
+  std::vector<u16> expected;
+  for (u32 num_verts = 0; num_verts < 100; num_verts++)
+  {
+    GenerateReference(&expected, m_primitive, m_primitive_restart, num_verts,
+                      m_generator.GetNumVerts());
+    m_generator.AddIndices(m_primitive, num_verts);
+
+    ASSERT_EQ(expected.size(), m_generator.GetIndexLen()) << "vertices: " << num_verts;
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), m_buffer.begin()))
+        << "vertices: " << num_verts;
+    ASSERT_EQ(CANARY, m_buffer[expected.size()]) << "vertices: " << num_verts;
+  }
+}
+
+TEST_P(IndexGeneratorTest, MatchesScalarGeneratorAtEndOfIndexRange)
+{
+  // Push the base index close to the last usable one, as a long draw at the end of a batch would.
+  constexpr u32 num_points = 64000;
+  constexpr u32 num_verts = 999;
+  m_generator.AddIndices(Primitive::GX_DRAW_POINTS, num_points);
+
+  std::vector<u16> expected;
+  GenerateReference(&expected, m_primitive, m_primitive_restart, num_verts, num_points);
+  m_generator.AddIndices(m_primitive, num_verts);
+
+  ASSERT_EQ(num_points + expected.size(), m_generator.GetIndexLen());
+  EXPECT_TRUE(std::equal(expected.begin(), expected.end(), m_buffer.begin() + num_points));
+  EXPECT_EQ(CANARY, m_buffer[num_points + expected.size()]);
+}
+
+class IndexGeneratorSpeedTest : public IndexGeneratorTest
+{
+};
+INSTANTIATE_TEST_CASE_P(
+    AllGenerators, IndexGeneratorSpeedTest,
+    ::testing::Combine(::testing::Values(Primitive::GX_DRAW_QUADS,
+                                         Primitive::GX_DRAW_TRIANGLE_STRIP,
+                                         Primitive::GX_DRAW_TRIANGLE_FAN,
+                                         Primitive::GX_DRAW_LINE_STRIP),
+                       ::testing::Bool()));
+
+TEST_P(IndexGeneratorSpeedTest, SmallPrimitives)
+{
+  // Individual quads and short strips, as most games draw them.
+  const u32 num_verts = m_primitive == Primitive::GX_DRAW_QUADS ? 4 : 6;
+  for (int i = 0; i < 2000; i++)
+  {
+    m_generator.Start(m_buffer.data());
+    while (m_generator.GetRemainingIndices() > 1000 && m_generator.GetIndexLen() < 60000)
+      m_generator.AddIndices(m_primitive, num_verts);
+  }
+}
+
+TEST_P(IndexGeneratorSpeedTest, LargePrimitives)
+{
+  for (int i = 0; i < 2000; i++)
+  {
+    m_generator.Start(m_buffer.data());
+    while (m_generator.GetRemainingIndices() > 1000 && m_generator.GetIndexLen() < 60000)
+      m_generator.AddIndices(m_primitive, 256);
+  }
+}
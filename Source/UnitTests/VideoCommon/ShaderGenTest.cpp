@@ -0,0 +1,276 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PixelShaderGen.h"
+#include "VideoCommon/ShaderGenCommon.h"
+#include "VideoCommon/UberShaderPixel.h"
+#include "VideoCommon/VideoCommon.h"
+
+#if defined(_MSC_VER)
+#include <crtdbg.h>
+#endif
+
+namespace
+{
+std::atomic<u64> s_num_allocations{0};
+#if !defined(_MSC_VER)
+std::atomic_bool s_count_allocations{false};
+#endif
+}  // namespace
+
+// The Visual Studio build links all tests into one binary, where replacing operator new would
+// affect every other test. Elsewhere, each test file is its own binary.
+#if !defined(_MSC_VER)
+void* operator new(std::size_t size)
+{
+  if (s_count_allocations.load(std::memory_order_relaxed))
+    s_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  void* const ptr = std::malloc(size ? size : 1);
+  if (!ptr)
+    std::abort();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+#endif
+
+namespace
+{
+#if defined(_MSC_VER) && defined(_DEBUG)
+int CountAllocation(int alloc_type, void*, size_t, int, long, const unsigned char*, int)
+{
+  if (alloc_type == _HOOK_ALLOC || alloc_type == _HOOK_REALLOC)
+    s_num_allocations.fetch_add(1, std::memory_order_relaxed);
+  return TRUE;
+}
+#endif
+
+// Counts the heap allocations made while it exists. With MSVC, that uses the allocation hook of
+// the debug CRT, so release builds can't count them.
+class ScopedAllocationCounter
+{
+public:
+  ScopedAllocationCounter()
+  {
+    s_num_allocations.store(0, std::memory_order_relaxed);
+#if defined(_MSC_VER) && defined(_DEBUG)
+    m_previous_hook = _CrtSetAllocHook(CountAllocation);
+#elif !defined(_MSC_VER)
+    s_count_allocations.store(true, std::memory_order_relaxed);
+#endif
+  }
+
+  ~ScopedAllocationCounter()
+  {
+#if defined(_MSC_VER) && defined(_DEBUG)
+    _CrtSetAllocHook(m_previous_hook);
+#elif !defined(_MSC_VER)
+    s_count_allocations.store(false, std::memory_order_relaxed);
+#endif
+  }
+
+  ScopedAllocationCounter(const ScopedAllocationCounter&) = delete;
+  ScopedAllocationCounter& operator=(const ScopedAllocationCounter&) = delete;
+
+  static constexpr bool IsSupported()
+  {
+#if defined(_MSC_VER) && !defined(_DEBUG)
+    return false;
+#else
+    return true;
+#endif
+  }
+
+  u64 GetCount() const { return s_num_allocations.load(std::memory_order_relaxed); }
+
+private:
+#if defined(_MSC_VER) && defined(_DEBUG)
+  _CRT_ALLOC_HOOK m_previous_hook = nullptr;
+#endif
+};
+}  // namespace
+
+namespace
+{
+class RandomGenerator
+{
+public:
+  u32 Next(u32 max)
+  {
+    m_state = m_state * 1103515245 + 12345;
+    return (m_state >> 8) % max;
+  }
+
+private:
+  u32 m_state = 1;
+};
+
+// Builds pixel shader UIDs with every TEV stage count and random stage configurations.
+std::vector<PixelShaderUid> GeneratePixelShaderUids(u32 count)
+{
+  RandomGenerator random;
+  std::vector<PixelShaderUid> uids(count);
+  for (u32 i = 0; i < count; i++)
+  {
+    pixel_shader_uid_data* const uid_data = uids[i].GetUidData();
+    uid_data->genMode_numtevstages = i % 16;
+    uid_data->genMode_numtexgens = 1 + random.Next(8);
+    uid_data->genMode_numindstages = random.Next(5);
+    uid_data->per_pixel_depth = random.Next(2);
+    uid_data->dither = random.Next(2);
+    uid_data->fog_fsel = static_cast<FogType>(random.Next(8));
+    uid_data->Pretest = static_cast<AlphaTestResult>(random.Next(3));
+    uid_data->alpha_test_comp0 = static_cast<CompareMode>(random.Next(8));
+    uid_data->alpha_test_comp1 = static_cast<CompareMode>(random.Next(8));
+    uid_data->texMtxInfo_n_projection = random.Next(256);
+    uid_data->nIndirectStagesUsed = random.Next(16);
+    for (u32 n = 0; n <= uid_data->genMode_numtevstages; n++)
+    {
+      auto& stage = uid_data->stagehash[n];
+      stage.cc = random.Next(1 << 24);
+      stage.ac = random.Next(1 << 24) & 0xFFFFF0;
+      stage.tevorders_enable = random.Next(2);
+      stage.tevorders_texmap = random.Next(8);
+      stage.tevorders_texcoord = random.Next(uid_data->genMode_numtexgens);
+      if (random.Next(2))
+      {
+        TevStageIndirect tevind{};
+        tevind.bt = random.Next(4);
+        tevind.fmt = static_cast<IndTexFormat>(random.Next(4));
+        tevind.bias = static_cast<IndTexBias>(random.Next(8));
+        tevind.bs = static_cast<IndTexBumpAlpha>(random.Next(4));
+        tevind.matrix_index = static_cast<IndMtxIndex>(random.Next(4));
+        if (tevind.matrix_index != IndMtxIndex::Off)
+          tevind.matrix_id = static_cast<IndMtxId>(random.Next(3));
+        tevind.sw = static_cast<IndTexWrap>(random.Next(7));
+        tevind.tw = static_cast<IndTexWrap>(random.Next(7));
+        tevind.fb_addprev = random.Next(2);
+        stage.tevind = tevind.hex;
+      }
+      stage.tevksel_kc = static_cast<KonstSel>(random.Next(32));
+      stage.tevksel_ka = static_cast<KonstSel>(random.Next(32));
+    }
+  }
+  return uids;
+}
+}  // namespace
+
+TEST(ShaderGen, PixelShaderGenerationDoesNotAllocate)
+{
+  const std::vector<PixelShaderUid> uids = GeneratePixelShaderUids(64);
+  ShaderHostConfig host_config = {};
+  host_config.backend_bitfield = true;
+
+  for (const APIType api_type : {APIType::OpenGL, APIType::Vulkan, APIType::D3D})
+  {
+    // Once the buffer has grown to fit the largest shader, it's reused as is.
+    ShaderCode code;
+    for (const PixelShaderUid& uid : uids)
+    {
+      code.Clear();
+      GeneratePixelShaderCode(code, api_type, host_config, uid.GetUidData());
+    }
+
+    const char* const buffer = code.GetBuffer().data();
+    const size_t capacity = code.GetBuffer().capacity();
+    u64 num_allocations = 0;
+    {
+      ScopedAllocationCounter counter;
+      for (const PixelShaderUid& uid : uids)
+      {
+        code.Clear();
+        GeneratePixelShaderCode(code, api_type, host_config, uid.GetUidData());
+      }
+      num_allocations = counter.GetCount();
+    }
+
+    EXPECT_EQ(buffer, code.GetBuffer().data()) << "API type " << static_cast<int>(api_type);
+    EXPECT_EQ(capacity, code.GetBuffer().capacity()) << "API type " << static_cast<int>(api_type);
+    if (ScopedAllocationCounter::IsSupported())
+    {
+      EXPECT_EQ(0u, num_allocations) << "API type " << static_cast<int>(api_type);
+    }
+  }
+}
+
+TEST(ShaderGen, ReusedBufferMatchesFreshBuffer)
+{
+  const std::vector<PixelShaderUid> uids = GeneratePixelShaderUids(16);
+  const ShaderHostConfig host_config = {};
+
+  ShaderCode reused;
+  for (const PixelShaderUid& uid : uids)
+  {
+    reused.Clear();
+    GeneratePixelShaderCode(reused, APIType::Vulkan, host_config, uid.GetUidData());
+
+    const ShaderCode fresh =
+        GeneratePixelShaderCode(APIType::Vulkan, host_config, uid.GetUidData());
+    EXPECT_EQ(fresh.GetBuffer(), reused.GetBuffer());
+  }
+}
+
+TEST(ShaderGen, UberShaderVariantsOmitUnusedFeatures)
+{
+  ShaderHostConfig host_config = {};
+  host_config.ubershader_variants = true;
+
+  UberShader::PixelShaderUid generic_uid;
+  generic_uid.GetUidData()->num_texgens = 2;
+  const ShaderCode generic =
+      UberShader::GenPixelShader(APIType::Vulkan, host_config, generic_uid.GetUidData());
+  EXPECT_NE(std::string::npos, generic.GetBuffer().find("// Fog"));
+  EXPECT_NE(std::string::npos, generic.GetBuffer().find("// Alpha Test"));
+  EXPECT_NE(std::string::npos, generic.GetBuffer().find("stage <= num_stages"));
+
+  UberShader::PixelShaderUid variant_uid = generic_uid;
+  variant_uid.GetUidData()->tev_stages_tier = 1;
+  variant_uid.GetUidData()->skip_fog = 1;
+  variant_uid.GetUidData()->skip_alpha_test = 1;
+  const ShaderCode variant =
+      UberShader::GenPixelShader(APIType::Vulkan, host_config, variant_uid.GetUidData());
+  EXPECT_EQ(std::string::npos, variant.GetBuffer().find("// Fog"));
+  EXPECT_EQ(std::string::npos, variant.GetBuffer().find("// Alpha Test"));
+  EXPECT_NE(std::string::npos,
+            variant.GetBuffer().find(fmt::format("stage < {}u", UberShader::GetMaxTevStages(1))));
+
+  // The constant bound is what lets D3D unroll the loop, which the generic ubershader forbids.
+  const ShaderCode generic_d3d =
+      UberShader::GenPixelShader(APIType::D3D, host_config, generic_uid.GetUidData());
+  EXPECT_NE(std::string::npos, generic_d3d.GetBuffer().find("[loop]\n  for(uint stage"));
+  const ShaderCode variant_d3d =
+      UberShader::GenPixelShader(APIType::D3D, host_config, variant_uid.GetUidData());
+  EXPECT_NE(std::string::npos, variant_d3d.GetBuffer().find("[unroll]\n  for(uint stage"));
+  EXPECT_EQ(std::string::npos, variant_d3d.GetBuffer().find("[loop]\n  for(uint stage"));
+
+  // Without variants, only the generic ubershader is used.
+  host_config.ubershader_variants = false;
+  UberShader::ClearUnusedPixelShaderUidBits(APIType::Vulkan, host_config, &variant_uid);
+  EXPECT_EQ(generic_uid, variant_uid);
+
+  u32 num_uids = 0;
+  UberShader::EnumeratePixelShaderUids(host_config, [&](const auto&) { num_uids++; });
+  u32 num_uids_with_variants = 0;
+  host_config.ubershader_variants = true;
+  UberShader::EnumeratePixelShaderUids(host_config, [&](const auto&) { num_uids_with_variants++; });
+  EXPECT_EQ(num_uids * 16, num_uids_with_variants);
+}
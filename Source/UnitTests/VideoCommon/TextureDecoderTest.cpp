@@ -0,0 +1,173 @@
+// Copyright 2022 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>  // NOLINT
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr TextureFormat ALL_FORMATS[] = {
+    TextureFormat::I4,     TextureFormat::I8,    TextureFormat::IA4, TextureFormat::IA8,
+    TextureFormat::RGB565, TextureFormat::RGB5A3, TextureFormat::RGBA8, TextureFormat::C4,
+    TextureFormat::C8,     TextureFormat::C14X2, TextureFormat::CMPR,
+};
+
+// Large enough for every C14X2 index.
+constexpr size_t TLUT_SIZE = 0x4000 * sizeof(u16);
+
+std::vector<u8> GenerateData(size_t size, u32 seed)
+{
+  std::vector<u8> data(size);
+  u32 state = seed;
+  for (u8& byte : data)
+  {
+    state = state * 1103515245 + 12345;
+    byte = static_cast<u8>(state >> 16);
+  }
+  return data;
+}
+
+int AlignUp(int value, int alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+class TextureDecoderTest : public ::testing::TestWithParam<std::tuple<TextureFormat, int, int>>
+{
+protected:
+  void SetUp() override
+  {
+    std::tie(m_format, m_width, m_height) = GetParam();
+    m_width = AlignUp(m_width, TexDecoder_GetBlockWidthInTexels(m_format));
+    m_height = AlignUp(m_height, TexDecoder_GetBlockHeightInTexels(m_format));
+    m_src = GenerateData(TexDecoder_GetTextureSizeInBytes(m_width, m_height, m_format), 1);
+    m_tlut = GenerateData(TLUT_SIZE, 2);
+  }
+
+  void TearDown() override
+  {
+    TexDecoder_SetDecodeThreads(0);
+    cpu_info = CPUInfo();
+  }
+
+  std::vector<u8> Decode(u32 num_threads, TLUTFormat tlut_format = TLUTFormat::RGB5A3)
+  {
+    TexDecoder_SetDecodeThreads(num_threads);
+    std::vector<u8> dst(static_cast<size_t>(m_width) * m_height * sizeof(u32));
+    TexDecoder_Decode(dst.data(), m_src.data(), m_width, m_height, m_format, m_tlut.data(),
+                      tlut_format);
+    return dst;
+  }
+
+  // Decodes the texture one texel at a time, which doesn't use any of the SIMD paths.
+  std::vector<u8> DecodeTexels(TLUTFormat tlut_format)
+  {
+    std::vector<u8> dst(static_cast<size_t>(m_width) * m_height * sizeof(u32));
+    for (int y = 0; y < m_height; y++)
+    {
+      for (int x = 0; x < m_width; x++)
+      {
+        TexDecoder_DecodeTexel(&dst[(y * m_width + x) * sizeof(u32)], m_src.data(), x, y,
+                               m_width - 1, m_format, m_tlut.data(), tlut_format);
+      }
+    }
+    return dst;
+  }
+
+  TextureFormat m_format{};
+  int m_width = 0;
+  int m_height = 0;
+  std::vector<u8> m_src;
+  std::vector<u8> m_tlut;
+};
+}  // namespace
+
+INSTANTIATE_TEST_CASE_P(AllFormats, TextureDecoderTest,
+                        ::testing::Combine(::testing::ValuesIn(ALL_FORMATS),
+                                           ::testing::Values(8, 64, 640, 1024),
+                                           ::testing::Values(8, 480, 1024)));
+
+TEST_P(TextureDecoderTest, ParallelMatchesSerial)
+{
+  const std::vector<u8> serial = Decode(0);
+  for (u32 num_threads : {1, 3, 7})
+    EXPECT_EQ(serial, Decode(num_threads)) << "threads: " << num_threads;
+}
+
+TEST_P(TextureDecoderTest, MatchesTexelDecoder)
+{
+  const bool paletted = m_format == TextureFormat::C4 || m_format == TextureFormat::C8 ||
+                        m_format == TextureFormat::C14X2;
+  for (TLUTFormat tlut_format : {TLUTFormat::IA8, TLUTFormat::RGB565, TLUTFormat::RGB5A3})
+  {
+    if (!paletted && tlut_format != TLUTFormat::RGB5A3)
+      continue;
+
+    const std::vector<u8> expected = DecodeTexels(tlut_format);
+
+    // Step down through the available instruction sets.
+    cpu_info = CPUInfo();
+    EXPECT_EQ(expected, Decode(0, tlut_format)) << "AVX2: " << cpu_info.bAVX2;
+    cpu_info.bAVX2 = false;
+    EXPECT_EQ(expected, Decode(0, tlut_format)) << "SSSE3: " << cpu_info.bSSSE3;
+    cpu_info.bSSSE3 = false;
+    EXPECT_EQ(expected, Decode(0, tlut_format)) << "SSE2";
+  }
+}
+
+TEST(TextureDecoder, RGBA8FromTmemMatchesTexelDecoder)
+{
+  for (const auto& [width, height] : {std::pair(4, 4), std::pair(64, 32), std::pair(6, 10)})
+  {
+    const size_t size = static_cast<size_t>(AlignUp(width, 4)) * AlignUp(height, 4) * 2;
+    const std::vector<u8> src_ar = GenerateData(size, 3);
+    const std::vector<u8> src_gb = GenerateData(size, 4);
+
+    std::vector<u8> expected(static_cast<size_t>(width) * height * sizeof(u32));
+    for (int y = 0; y < height; y++)
+    {
+      for (int x = 0; x < width; x++)
+      {
+        TexDecoder_DecodeTexelRGBA8FromTmem(&expected[(y * width + x) * sizeof(u32)],
+                                            src_ar.data(), src_gb.data(), x, y, width - 1);
+      }
+    }
+
+    for (bool avx2 : {true, false})
+    {
+      cpu_info = CPUInfo();
+      cpu_info.bAVX2 &= avx2;
+      std::vector<u8> dst(expected.size());
+      TexDecoder_DecodeRGBA8FromTmem(dst.data(), src_ar.data(), src_gb.data(), width, height);
+      EXPECT_EQ(expected, dst) << width << "x" << height << " AVX2: " << cpu_info.bAVX2;
+    }
+  }
+  cpu_info = CPUInfo();
+}
+
+class TextureDecoderSpeedTest : public TextureDecoderTest
+{
+};
+INSTANTIATE_TEST_CASE_P(AllFormats, TextureDecoderSpeedTest,
+                        ::testing::Combine(::testing::ValuesIn(ALL_FORMATS),
+                                           ::testing::Values(256, 1024),
+                                           ::testing::Values(256, 1024)));
+
+TEST_P(TextureDecoderSpeedTest, Serial)
+{
+  for (int i = 0; i < 20; ++i)
+    Decode(0);
+}
+
+TEST_P(TextureDecoderSpeedTest, Parallel)
+{
+  for (int i = 0; i < 20; ++i)
+    Decode(3);
+}
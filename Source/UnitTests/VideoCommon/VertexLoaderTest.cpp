@@ -6,15 +6,18 @@
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 #include <gtest/gtest.h>  // NOLINT
 
 #include "Common/BitUtils.h"
+#include "Common/CPUDetect.h"
 #include "Common/Common.h"
 #include "Common/MathUtil.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoader.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
@@ -38,6 +41,23 @@ TEST(VertexLoaderUID, UniqueEnough)
   uids.insert(VertexLoaderUID(vtx_desc, vat));
 }
 
+TEST(VertexLoaderUID, SerializationRoundTrip)
+{
+  TVtxDesc vtx_desc;
+  vtx_desc.low.Hex = 0x76543210;
+  vtx_desc.high.Hex = 0xFEDCBA98;
+  VAT vat;
+  vat.g0.Hex = 0x01234567;
+  vat.g1.Hex = 0x89ABCDEF;
+  vat.g2.Hex = 0x55AA55AA;
+
+  const VertexLoaderUID uid(vtx_desc, vat);
+  const VertexLoaderUID restored(uid.GetData());
+  EXPECT_EQ(uid, restored);
+  EXPECT_EQ(uid.GetHash(), restored.GetHash());
+  EXPECT_EQ(uid, VertexLoaderUID(restored.GetVtxDesc(), restored.GetVAT()));
+}
+
 static u8 input_memory[16 * 1024 * 1024];
 static u8 output_memory[16 * 1024 * 1024];
 
@@ -366,3 +386,209 @@ TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
   for (int i = 0; i < 100; ++i)
     RunVertices(100000);
 }
+
+#ifdef _M_X86_64
+// Runs the same random vertices through the JIT and the reference loader. An odd count and a
+// few skipped vertices make sure the JIT switches between its single vertex and pair loops.
+class VertexLoaderX64Test : public VertexLoaderTest
+{
+protected:
+  static constexpr int NUM_VERTICES = 37;
+  static constexpr u32 ARRAY_STRIDE = 64;
+
+  void TearDown() override { cpu_info = CPUInfo(); }
+
+  void RandomizeInput()
+  {
+    u32 state = 1;
+    for (u8& byte : input_memory)
+    {
+      state = state * 1103515245 + 12345;
+      byte = static_cast<u8>(state >> 16);
+    }
+
+    // Arrays live in the upper half, out of reach of the vertices themselves.
+    for (int i = 0; i < NUM_VERTEX_COMPONENT_ARRAYS; i++)
+    {
+      VertexLoaderManager::cached_arraybases[static_cast<CPArray>(i)] =
+          input_memory + sizeof(input_memory) / 2;
+      g_main_cp_state.array_strides[static_cast<CPArray>(i)] = ARRAY_STRIDE;
+    }
+  }
+
+  u32 GetNumMatrixIndices() const
+  {
+    u32 num_indices = m_vtx_desc.low.PosMatIdx ? 1 : 0;
+    for (auto texmtxidx : m_vtx_desc.low.TexMatIdx)
+      num_indices += texmtxidx ? 1 : 0;
+    return num_indices;
+  }
+
+  void PrepareVertices(u32 vertex_size)
+  {
+    // The reference loader masks texture matrix indices, the JIT relies on them being valid.
+    for (int vertex = 0; vertex < NUM_VERTICES; vertex++)
+    {
+      for (u32 i = 0; i < GetNumMatrixIndices(); i++)
+        input_memory[vertex * vertex_size + i] &= 0x3F;
+    }
+  }
+
+  void SkipVertex(u32 vertex_size, int vertex)
+  {
+    if (!IsIndexed(m_vtx_desc.low.Position))
+      return;
+
+    u8* index = input_memory + vertex * vertex_size + GetNumMatrixIndices();
+    index[0] = 0xFF;
+    if (m_vtx_desc.low.Position == VertexComponentFormat::Index16)
+      index[1] = 0xFF;
+  }
+
+  int Run(VertexLoaderBase& loader, std::vector<u8>* out)
+  {
+    out->assign(NUM_VERTICES * loader.m_native_vtx_decl.stride, 0);
+    return loader.RunVertices(DataReader(input_memory, input_memory + sizeof(input_memory)),
+                              DataReader(out->data(), out->data() + out->size()), NUM_VERTICES);
+  }
+
+  void ExpectMatchesReference()
+  {
+    VertexLoader reference(m_vtx_desc, m_vtx_attr);
+    RandomizeInput();
+    PrepareVertices(reference.m_vertex_size);
+    for (int vertex : {2, 9, 10, 30})
+      SkipVertex(reference.m_vertex_size, vertex);
+
+    std::vector<u8> expected;
+    const int expected_count = Run(reference, &expected);
+
+    for (bool avx2 : {false, true})
+    {
+      cpu_info = CPUInfo();
+      cpu_info.bAVX2 &= avx2;
+      m_loader = VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+      ASSERT_EQ(reference.m_vertex_size, m_loader->m_vertex_size);
+      ASSERT_EQ(reference.m_native_vtx_decl.stride, m_loader->m_native_vtx_decl.stride);
+
+      std::vector<u8> actual;
+      EXPECT_EQ(expected_count, Run(*m_loader, &actual)) << "AVX2: " << cpu_info.bAVX2;
+
+      // Output past the last loaded vertex is scratch space.
+      const u32 stride = m_loader->m_native_vtx_decl.stride;
+      for (int i = 0; i < expected_count; i++)
+      {
+        for (u32 offset = 0; offset < stride; offset++)
+        {
+          const size_t byte = i * stride + offset;
+          ASSERT_EQ(expected[byte], actual[byte])
+              << "vertex " << i << ", offset " << offset << ", AVX2: " << cpu_info.bAVX2;
+        }
+      }
+    }
+  }
+};
+
+TEST_F(VertexLoaderX64Test, DirectMatchesReference)
+{
+  m_vtx_desc.low.PosMatIdx = 1;
+  m_vtx_desc.low.Tex1MatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.Tex0Frac = 8;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  ExpectMatchesReference();
+}
+
+TEST_F(VertexLoaderX64Test, IndexedMatchesReference)
+{
+  m_vtx_desc.low.Tex0MatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Index16;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Index8;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Index8;
+  m_vtx_desc.low.Color1 = VertexComponentFormat::Index16;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Index16;
+  m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Index8;
+
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.PosFrac = 6;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::NBT;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.NormalIndex3 = true;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGB565;
+  m_vtx_attr.g0.Color1Comp = ColorFormat::RGBA6666;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::S;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::UShort;
+  m_vtx_attr.g0.Tex0Frac = 4;
+  m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g1.Tex1CoordFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  ExpectMatchesReference();
+}
+
+TEST_F(VertexLoaderX64Test, MixedMatchesReference)
+{
+  m_vtx_desc.low.Tex2MatIdx = 1;
+  m_vtx_desc.low.Tex3MatIdx = 1;
+  m_vtx_desc.low.Position = VertexComponentFormat::Index8;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Index16;
+  m_vtx_desc.low.Color1 = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex2Coord = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex7Coord = VertexComponentFormat::Index8;
+
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XY;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::UByte;
+  m_vtx_attr.g0.PosFrac = 2;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::NBT;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.Color1Comp = ColorFormat::RGBA4444;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.Tex0Frac = 7;
+  m_vtx_attr.g1.Tex2CoordElements = TexComponentCount::S;
+  m_vtx_attr.g1.Tex2CoordFormat = ComponentFormat::Short;
+  m_vtx_attr.g2.Tex7CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g2.Tex7CoordFormat = ComponentFormat::UShort;
+  m_vtx_attr.g2.Tex7Frac = 31;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  ExpectMatchesReference();
+}
+#endif
+
+TEST_F(VertexLoaderTest, TypicalVertexSpeed)
+{
+  // Direct positions and normals with a color and a texture coordinate, as most games use.
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Normal = VertexComponentFormat::Direct;
+  m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+  m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.PosFrac = 8;
+  m_vtx_attr.g0.NormalElements = NormalComponentCount::N;
+  m_vtx_attr.g0.NormalFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+  m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+  m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.Tex0Frac = 10;
+  m_vtx_attr.g0.ByteDequant = true;
+
+  CreateAndCheckSizes(6 + 3 + 4 + 4, 12 + 12 + 4 + 8);
+  for (int i = 0; i < 1000; ++i)
+    RunVertices(100000);
+}